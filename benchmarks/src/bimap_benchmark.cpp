@@ -0,0 +1,134 @@
+#include "jg/dense_bimap.hpp"
+#include "jg/dense_hash_map.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+// The usual bidirectional map: one map per direction, each holding a copy of both values.
+class two_maps_bimap
+{
+public:
+    auto emplace(std::uint64_t id, const std::string& name) -> bool
+    {
+        if (by_id_.contains(id) || by_name_.contains(name))
+        {
+            return false;
+        }
+
+        by_id_.emplace(id, name);
+        by_name_.emplace(name, id);
+        return true;
+    }
+
+    auto find_right(const std::string& name) const -> const std::uint64_t*
+    {
+        const auto it = by_name_.find(name);
+        return it == by_name_.end() ? nullptr : &it->second;
+    }
+
+    auto find_left(std::uint64_t id) const -> const std::string*
+    {
+        const auto it = by_id_.find(id);
+        return it == by_id_.end() ? nullptr : &it->second;
+    }
+
+    auto erase_left(std::uint64_t id) -> std::size_t
+    {
+        const auto it = by_id_.find(id);
+
+        if (it == by_id_.end())
+        {
+            return 0u;
+        }
+
+        by_name_.erase(it->second);
+        by_id_.erase(it);
+        return 1u;
+    }
+
+private:
+    jg::dense_hash_map<std::uint64_t, std::string> by_id_;
+    jg::dense_hash_map<std::string, std::uint64_t> by_name_;
+};
+
+class dense_bimap
+{
+public:
+    auto emplace(std::uint64_t id, const std::string& name) -> bool
+    {
+        return map_.emplace(id, name).second;
+    }
+
+    auto find_right(const std::string& name) const -> const std::uint64_t*
+    {
+        const auto it = map_.find_right(name);
+        return it == map_.end() ? nullptr : &it->first;
+    }
+
+    auto find_left(std::uint64_t id) const -> const std::string*
+    {
+        const auto it = map_.find_left(id);
+        return it == map_.end() ? nullptr : &it->second;
+    }
+
+    auto erase_left(std::uint64_t id) -> std::size_t { return map_.erase_left(id); }
+
+private:
+    jg::dense_bimap<std::uint64_t, std::string> map_;
+};
+
+auto name_of(std::uint64_t id) -> std::string { return "user-name-" + std::to_string(id); }
+
+// Ids and names of a directory of users: every step resolves a name to its id and back, and one
+// step in four renames a user, erasing the old entry and inserting the new one.
+template <class Bimap>
+void bimap_churn(benchmark::State& state)
+{
+    const auto user_count = static_cast<std::uint64_t>(state.range(0));
+    std::mt19937_64 engine{42};
+    std::vector<std::string> names;
+
+    for (std::uint64_t id = 0; id < user_count; ++id)
+    {
+        names.push_back(name_of(id));
+    }
+
+    for (auto _ : state)
+    {
+        Bimap m;
+
+        for (std::uint64_t id = 0; id < user_count; ++id)
+        {
+            m.emplace(id, names[id]);
+        }
+
+        for (std::uint64_t step = 0; step < user_count; ++step)
+        {
+            const auto id = engine() % user_count;
+
+            if (const auto found = m.find_right(names[id]))
+            {
+                benchmark::DoNotOptimize(m.find_left(*found));
+            }
+
+            if (step % 4 == 0 && m.erase_left(id) == 1u)
+            {
+                names[id] = name_of(id + user_count * (step + 1));
+                m.emplace(id, names[id]);
+            }
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * user_count));
+}
+
+BENCHMARK_TEMPLATE(bimap_churn, two_maps_bimap)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(bimap_churn, dense_bimap)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+} // namespace
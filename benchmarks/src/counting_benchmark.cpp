@@ -0,0 +1,88 @@
+#include "jg/dense_hash_map.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+using map_type = jg::dense_hash_map<std::uint64_t, std::uint64_t>;
+
+// 95% of the events hit one of the distinct_count first keys, the others are new keys.
+auto make_events(std::uint64_t distinct_count) -> std::vector<std::uint64_t>
+{
+    std::mt19937_64 engine{42};
+    std::bernoulli_distribution is_hit(0.95);
+    std::uniform_int_distribution<std::uint64_t> hit(0, distinct_count - 1);
+    std::vector<std::uint64_t> events(1u << 20);
+    std::uint64_t next_new_key = distinct_count;
+
+    for (auto& key : events)
+    {
+        key = is_hit(engine) ? hit(engine) : next_new_key++;
+    }
+
+    return events;
+}
+
+auto make_counts(std::uint64_t distinct_count) -> map_type
+{
+    map_type m;
+
+    for (std::uint64_t i = 0; i < distinct_count; ++i)
+    {
+        m.try_emplace(i, 0u);
+    }
+
+    return m;
+}
+
+void count_subscript(benchmark::State& state)
+{
+    const auto distinct_count = static_cast<std::uint64_t>(state.range(0));
+    const auto events = make_events(distinct_count);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto m = make_counts(distinct_count);
+        state.ResumeTiming();
+
+        for (auto key : events)
+        {
+            ++m[key];
+        }
+
+        benchmark::DoNotOptimize(m);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * events.size()));
+}
+
+void count_upsert(benchmark::State& state)
+{
+    const auto distinct_count = static_cast<std::uint64_t>(state.range(0));
+    const auto events = make_events(distinct_count);
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto m = make_counts(distinct_count);
+        state.ResumeTiming();
+
+        for (auto key : events)
+        {
+            m.upsert(key, [] { return 1u; }, [](std::uint64_t& count) { ++count; });
+        }
+
+        benchmark::DoNotOptimize(m);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * events.size()));
+}
+} // namespace
+
+BENCHMARK(count_subscript)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(count_upsert)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
@@ -0,0 +1,224 @@
+#include "jg/dense_hash_map.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+template <class StoragePolicy>
+using map_type = jg::dense_hash_map<
+    std::string, std::uint64_t, std::hash<std::string>, std::equal_to<std::string>,
+    std::allocator<std::pair<const std::string, std::uint64_t>>,
+    jg::details::power_of_two_growth_policy, StoragePolicy>;
+
+auto make_key(std::uint64_t i) -> std::string
+{
+    return "a_key_long_enough_to_be_costly_to_hash_" + std::to_string(i);
+}
+
+// Erase-heavy churn: each step erases the entry at a random position by iterator and inserts a new
+// one, at the max load factor given by the second argument, so that chains get long.
+template <class StoragePolicy>
+void erase_churn(benchmark::State& state)
+{
+    const auto size = static_cast<std::uint64_t>(state.range(0));
+    const auto max_load_factor = static_cast<float>(state.range(1));
+
+    map_type<StoragePolicy> m;
+    m.max_load_factor(max_load_factor);
+
+    for (std::uint64_t i = 0; i < size; ++i)
+    {
+        m.try_emplace(make_key(i), i);
+    }
+
+    std::mt19937_64 engine{42};
+    std::uniform_int_distribution<std::uint64_t> distribution(0, size - 1);
+    std::uint64_t next_key = size;
+
+    for (auto _ : state)
+    {
+        const auto position = static_cast<std::ptrdiff_t>(distribution(engine));
+        m.erase(std::next(m.cbegin(), position));
+        m.try_emplace(make_key(next_key), next_key);
+        ++next_key;
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+void erase_churn_args(benchmark::internal::Benchmark* b)
+{
+    for (std::int64_t max_load_factor : {1, 4, 16})
+    {
+        b->Args({1 << 16, max_load_factor});
+        b->Args({1 << 20, max_load_factor});
+    }
+}
+
+BENCHMARK_TEMPLATE(erase_churn, jg::details::vector_storage_policy)->Apply(erase_churn_args);
+BENCHMARK_TEMPLATE(erase_churn, jg::details::doubly_linked_storage_policy<>)
+    ->Apply(erase_churn_args);
+
+// Same churn erasing by key, to compare moving the last node into the hole with leaving a tombstone
+// in insertion order.
+template <class StoragePolicy>
+void erase_key_churn(benchmark::State& state)
+{
+    const auto size = static_cast<std::uint64_t>(state.range(0));
+    const auto max_load_factor = static_cast<float>(state.range(1));
+
+    map_type<StoragePolicy> m;
+    m.max_load_factor(max_load_factor);
+    std::vector<std::string> keys;
+
+    for (std::uint64_t i = 0; i < size; ++i)
+    {
+        keys.push_back(make_key(i));
+        m.try_emplace(keys.back(), i);
+    }
+
+    std::mt19937_64 engine{42};
+    std::uniform_int_distribution<std::uint64_t> distribution(0, size - 1);
+    std::uint64_t next_key = size;
+
+    for (auto _ : state)
+    {
+        auto& key = keys[distribution(engine)];
+        m.erase(key);
+        key = make_key(next_key);
+        m.try_emplace(key, next_key);
+        ++next_key;
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+BENCHMARK_TEMPLATE(erase_key_churn, jg::details::vector_storage_policy)->Apply(erase_churn_args);
+BENCHMARK_TEMPLATE(erase_key_churn, jg::details::ordered_storage_policy<>)
+    ->Apply(erase_churn_args);
+
+using bulk_map_type = jg::dense_hash_map<std::uint64_t, std::uint64_t>;
+
+auto make_bulk_map(std::uint64_t size) -> bulk_map_type
+{
+    bulk_map_type m;
+
+    for (std::uint64_t i = 0; i < size; ++i)
+    {
+        m.try_emplace(i * 0x9E3779B97F4A7C15ull, i);
+    }
+
+    return m;
+}
+
+// Erases 30% of the entries.
+auto is_erased(const std::pair<const std::uint64_t, std::uint64_t>& pair) -> bool
+{
+    return pair.second % 10 < 3;
+}
+
+// Runs the tasks on all the hardware threads.
+struct thread_executor
+{
+    template <class Task>
+    void operator()(std::size_t count, Task task) const
+    {
+        std::atomic<std::size_t> next{0};
+        std::vector<std::thread> threads(std::max(1u, std::thread::hardware_concurrency()));
+
+        for (auto& thread : threads)
+        {
+            thread = std::thread([&] {
+                for (auto i = next++; i < count; i = next++)
+                {
+                    task(i);
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+};
+
+// Erasing the entries one by one, walking backward as std::erase_if used to.
+void erase_one_by_one(benchmark::State& state)
+{
+    const auto source = make_bulk_map(static_cast<std::uint64_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto m = source;
+        state.ResumeTiming();
+
+        for (auto i = m.size(); i > 0; --i)
+        {
+            const auto it = std::next(m.begin(), static_cast<std::ptrdiff_t>(i - 1));
+
+            if (is_erased(*it))
+            {
+                m.erase(it);
+            }
+        }
+
+        benchmark::DoNotOptimize(m);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * source.size()));
+}
+
+void bulk_erase_if(benchmark::State& state)
+{
+    const auto source = make_bulk_map(static_cast<std::uint64_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto m = source;
+        state.ResumeTiming();
+
+        std::erase_if(m, is_erased);
+        benchmark::DoNotOptimize(m);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * source.size()));
+}
+
+void parallel_erase_if(benchmark::State& state)
+{
+    const auto source = make_bulk_map(static_cast<std::uint64_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        auto m = source;
+        state.ResumeTiming();
+
+        m.erase_if(thread_executor{}, is_erased);
+        benchmark::DoNotOptimize(m);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * source.size()));
+}
+
+void bulk_erase_sizes(benchmark::internal::Benchmark* b)
+{
+    b->Arg(1 << 20)->Arg(10'000'000)->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK(erase_one_by_one)->Apply(bulk_erase_sizes);
+BENCHMARK(bulk_erase_if)->Apply(bulk_erase_sizes);
+BENCHMARK(parallel_erase_if)->Apply(bulk_erase_sizes);
+
+} // namespace
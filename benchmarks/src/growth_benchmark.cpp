@@ -0,0 +1,60 @@
+#include "tracking_allocator.hpp"
+
+#include "jg/dense_hash_map.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+
+namespace
+{
+template <class StoragePolicy>
+using map_type = jg::dense_hash_map<
+    std::uint64_t, std::uint64_t, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>,
+    jg::benchmarks::tracking_allocator<std::pair<const std::uint64_t, std::uint64_t>>,
+    jg::details::power_of_two_growth_policy, StoragePolicy>;
+
+// Inserts without reserving and reports the peak memory held by the map and the worst latency of a
+// single insertion, which is dominated by the growth of nodes_ and buckets_.
+template <class StoragePolicy>
+void growth(benchmark::State& state)
+{
+    using clock = std::chrono::steady_clock;
+
+    const auto size = static_cast<std::uint64_t>(state.range(0));
+    auto& tracker = jg::benchmarks::memory_tracker::instance();
+    std::size_t peak_bytes = 0;
+    clock::duration max_insert_latency{};
+
+    for (auto _ : state)
+    {
+        tracker.reset();
+        map_type<StoragePolicy> m;
+
+        for (std::uint64_t i = 0; i < size; ++i)
+        {
+            const auto start = clock::now();
+            m.try_emplace(i, i);
+            max_insert_latency = std::max(max_insert_latency, clock::now() - start);
+        }
+
+        benchmark::DoNotOptimize(m);
+        peak_bytes = std::max(peak_bytes, tracker.peak_bytes);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * size));
+    state.counters["peak_MB"] = static_cast<double>(peak_bytes) / (1024.0 * 1024.0);
+    state.counters["max_insert_us"] =
+        std::chrono::duration<double, std::micro>(max_insert_latency).count();
+}
+
+void growth_sizes(benchmark::internal::Benchmark* b)
+{
+    b->RangeMultiplier(16)->Range(1 << 16, 1 << 24)->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_TEMPLATE(growth, jg::details::vector_storage_policy)->Apply(growth_sizes);
+BENCHMARK_TEMPLATE(growth, jg::details::segmented_storage_policy<>)->Apply(growth_sizes);
+
+} // namespace
@@ -0,0 +1,70 @@
+#include "tracking_allocator.hpp"
+
+#include "jg/dense_hash_map.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+namespace
+{
+template <class GrowthPolicy>
+using map_type = jg::dense_hash_map<
+    std::uint64_t, std::uint64_t, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>,
+    jg::benchmarks::tracking_allocator<std::pair<const std::uint64_t, std::uint64_t>>,
+    GrowthPolicy>;
+
+// Memory/throughput trade-off of the growth policies: inserts without reserving, then looks every
+// key up, and reports the peak and final memory held by the map.
+template <class GrowthPolicy>
+void growth_policy(benchmark::State& state)
+{
+    const auto size = static_cast<std::uint64_t>(state.range(0));
+    auto& tracker = jg::benchmarks::memory_tracker::instance();
+    std::size_t peak_bytes = 0;
+    std::size_t final_bytes = 0;
+
+    for (auto _ : state)
+    {
+        tracker.reset();
+        map_type<GrowthPolicy> m;
+
+        for (std::uint64_t i = 0; i < size; ++i)
+        {
+            m.try_emplace(i * 0x9E3779B97F4A7C15ull, i);
+        }
+
+        std::uint64_t sum = 0;
+
+        for (std::uint64_t i = 0; i < size; ++i)
+        {
+            sum += m.find(i * 0x9E3779B97F4A7C15ull)->second;
+        }
+
+        benchmark::DoNotOptimize(sum);
+        peak_bytes = std::max(peak_bytes, tracker.peak_bytes);
+        final_bytes = tracker.current_bytes;
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * size));
+    state.counters["peak_MB"] = static_cast<double>(peak_bytes) / (1024.0 * 1024.0);
+    state.counters["final_MB"] = static_cast<double>(final_bytes) / (1024.0 * 1024.0);
+}
+
+void growth_policy_sizes(benchmark::internal::Benchmark* b)
+{
+    // Powers of ten, so that the power of two policies are not measured at their best case only.
+    for (std::int64_t size = 10'000; size <= 10'000'000; size *= 10)
+    {
+        b->Arg(size);
+    }
+
+    b->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_TEMPLATE(growth_policy, jg::details::power_of_two_growth_policy)
+    ->Apply(growth_policy_sizes);
+BENCHMARK_TEMPLATE(growth_policy, jg::details::speed_growth_policy)->Apply(growth_policy_sizes);
+BENCHMARK_TEMPLATE(growth_policy, jg::details::lean_growth_policy)->Apply(growth_policy_sizes);
+
+} // namespace
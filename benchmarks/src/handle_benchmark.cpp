@@ -0,0 +1,96 @@
+#include "jg/dense_hash_map.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+using map_type = jg::dense_hash_map<
+    std::string, std::uint64_t, std::hash<std::string>, std::equal_to<std::string>,
+    std::allocator<std::pair<const std::string, std::uint64_t>>,
+    jg::details::power_of_two_growth_policy, jg::details::handle_storage_policy<>>;
+
+auto make_key(std::uint64_t i) -> std::string { return "session/" + std::to_string(i * 7919); }
+
+auto make_map(std::size_t size) -> map_type
+{
+    map_type m;
+
+    for (std::uint64_t i = 0; i < size; ++i)
+    {
+        m.try_emplace(make_key(i), i);
+    }
+
+    return m;
+}
+
+auto make_accesses(std::size_t size) -> std::vector<std::size_t>
+{
+    std::mt19937_64 engine{42};
+    std::uniform_int_distribution<std::size_t> distribution(0, size - 1);
+    std::vector<std::size_t> accesses(1u << 16);
+
+    for (auto& access : accesses)
+    {
+        access = distribution(engine);
+    }
+
+    return accesses;
+}
+
+// The entries are accessed again and again by key, each access hashing it and walking its chain.
+void access_by_key(benchmark::State& state)
+{
+    const auto size = static_cast<std::size_t>(state.range(0));
+    auto m = make_map(size);
+    const auto accesses = make_accesses(size);
+    std::vector<std::string> keys;
+
+    for (std::uint64_t i = 0; i < size; ++i)
+    {
+        keys.push_back(make_key(i));
+    }
+
+    for (auto _ : state)
+    {
+        for (auto access : accesses)
+        {
+            benchmark::DoNotOptimize(++m.find(keys[access])->second);
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * accesses.size()));
+}
+
+// The same accesses through the handles taken when the entries were looked up the first time.
+void access_by_handle(benchmark::State& state)
+{
+    const auto size = static_cast<std::size_t>(state.range(0));
+    auto m = make_map(size);
+    const auto accesses = make_accesses(size);
+    std::vector<map_type::handle_type> handles;
+
+    for (std::uint64_t i = 0; i < size; ++i)
+    {
+        handles.push_back(m.handle_of(m.find(make_key(i))));
+    }
+
+    for (auto _ : state)
+    {
+        for (auto access : accesses)
+        {
+            benchmark::DoNotOptimize(++m.get(handles[access])->second);
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * accesses.size()));
+}
+
+BENCHMARK(access_by_key)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK(access_by_handle)->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+
+} // namespace
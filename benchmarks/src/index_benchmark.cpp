@@ -0,0 +1,159 @@
+#include "jg/dense_hash_map.hpp"
+#include "jg/dense_index.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct record
+{
+    std::string sku;
+    std::uint64_t quantity;
+};
+
+// Records with keys of 20 to 40 characters, past the small string buffer of std::string.
+auto make_records(std::size_t count) -> std::vector<record>
+{
+    std::vector<record> records;
+    records.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        records.push_back(
+            {"sku-" + std::to_string(i * 2654435761u % 1'000'000'007u) + "-" +
+                 std::string(i % 21, 's'),
+             i});
+    }
+
+    return records;
+}
+
+// Runs the tasks on all the hardware threads.
+struct thread_executor
+{
+    template <class Task>
+    void operator()(std::size_t count, Task task) const
+    {
+        std::atomic<std::size_t> next{0};
+        std::vector<std::thread> threads(std::max(1u, std::thread::hardware_concurrency()));
+
+        for (auto& thread : threads)
+        {
+            thread = std::thread([&] {
+                for (auto i = next++; i < count; i = next++)
+                {
+                    task(i);
+                }
+            });
+        }
+
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+};
+
+// The usual secondary index: a map from a copy of each key to its row.
+auto make_copy_index(const std::vector<record>& records)
+    -> jg::dense_hash_map<std::string, std::size_t>
+{
+    jg::dense_hash_map<std::string, std::size_t> index;
+    index.reserve(records.size());
+
+    for (std::size_t row = 0; row < records.size(); ++row)
+    {
+        index.try_emplace(records[row].sku, row);
+    }
+
+    return index;
+}
+
+void copy_index_build(benchmark::State& state)
+{
+    const auto records = make_records(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(make_copy_index(records).size());
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * records.size()));
+}
+
+void dense_index_build(benchmark::State& state)
+{
+    const auto records = make_records(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(jg::make_dense_index(records, &record::sku).size());
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * records.size()));
+}
+
+void dense_index_parallel_build(benchmark::State& state)
+{
+    const auto records = make_records(static_cast<std::size_t>(state.range(0)));
+    auto index = jg::make_dense_index(records, &record::sku);
+
+    for (auto _ : state)
+    {
+        index.build(records.size(), thread_executor{});
+        benchmark::DoNotOptimize(index.size());
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * records.size()));
+}
+
+// Looks up random keys, a tenth of them missing.
+template <class Index>
+void lookup(benchmark::State& state, const std::vector<record>& records, const Index& index)
+{
+    std::vector<std::string> probes;
+    std::mt19937_64 engine{42};
+
+    for (std::size_t i = 0; i < 4096; ++i)
+    {
+        const auto& sku = records[engine() % records.size()].sku;
+        probes.push_back(i % 10 == 0 ? sku + "-missing" : sku);
+    }
+
+    std::size_t i = 0;
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(index.find(probes[i++ % probes.size()]));
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations()));
+}
+
+void copy_index_lookup(benchmark::State& state)
+{
+    const auto records = make_records(static_cast<std::size_t>(state.range(0)));
+    lookup(state, records, make_copy_index(records));
+}
+
+void dense_index_lookup(benchmark::State& state)
+{
+    const auto records = make_records(static_cast<std::size_t>(state.range(0)));
+    lookup(state, records, jg::make_dense_index(records, &record::sku));
+}
+
+BENCHMARK(copy_index_build)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(dense_index_build)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(dense_index_parallel_build)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(copy_index_lookup)->Arg(100'000)->Arg(1'000'000);
+BENCHMARK(dense_index_lookup)->Arg(100'000)->Arg(1'000'000);
+
+} // namespace
@@ -0,0 +1,136 @@
+#include "jg/dense_hash_map.hpp"
+#include "jg/dense_hash_map_algorithms.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+using map_type = jg::dense_hash_map<std::uint64_t, std::uint64_t>;
+
+// A build map of random keys, and as many probe keys, half of them in the map.
+struct join_data
+{
+    explicit join_data(std::size_t size)
+    {
+        std::mt19937_64 engine{42};
+        build.reserve(size);
+
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const auto key = engine();
+            build.try_emplace(key, i);
+            probe_keys.push_back(i % 2 == 0 ? key : engine());
+        }
+
+        std::shuffle(probe_keys.begin(), probe_keys.end(), engine);
+    }
+
+    map_type build;
+    std::vector<std::uint64_t> probe_keys;
+};
+
+void join_find_loop(benchmark::State& state)
+{
+    const join_data data(static_cast<std::size_t>(state.range(0)));
+    std::vector<jg::probe_result<map_type>> results(data.probe_keys.size());
+
+    for (auto _ : state)
+    {
+        auto out = results.begin();
+
+        for (std::size_t i = 0; i < data.probe_keys.size(); ++i)
+        {
+            const auto it = data.build.find(data.probe_keys[i]);
+
+            if (it != data.build.end())
+            {
+                *out++ = {i, &*it};
+            }
+        }
+
+        benchmark::DoNotOptimize(out);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * results.size()));
+}
+
+void join_probe(benchmark::State& state)
+{
+    const join_data data(static_cast<std::size_t>(state.range(0)));
+    std::vector<jg::probe_result<map_type>> results(data.probe_keys.size());
+
+    for (auto _ : state)
+    {
+        auto out = jg::probe(data.build, data.probe_keys, results.begin());
+        benchmark::DoNotOptimize(out);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * results.size()));
+}
+
+void intersect_find_loop(benchmark::State& state)
+{
+    const join_data data(static_cast<std::size_t>(state.range(0)));
+    map_type other;
+
+    for (auto key : data.probe_keys)
+    {
+        other.try_emplace(key, key);
+    }
+
+    std::vector<std::uint64_t> keys(other.size());
+
+    for (auto _ : state)
+    {
+        auto out = keys.begin();
+
+        for (const auto& entry : other)
+        {
+            if (data.build.find(entry.first) != data.build.end())
+            {
+                *out++ = entry.first;
+            }
+        }
+
+        benchmark::DoNotOptimize(out);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * other.size()));
+}
+
+void intersect_keys(benchmark::State& state)
+{
+    const join_data data(static_cast<std::size_t>(state.range(0)));
+    map_type other;
+
+    for (auto key : data.probe_keys)
+    {
+        other.try_emplace(key, key);
+    }
+
+    std::vector<std::uint64_t> keys(other.size());
+
+    for (auto _ : state)
+    {
+        auto out = jg::intersect_keys(other, data.build, keys.begin());
+        benchmark::DoNotOptimize(out);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * other.size()));
+}
+
+void join_sizes(benchmark::internal::Benchmark* b)
+{
+    b->RangeMultiplier(16)->Range(1 << 12, 1 << 24)->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK(join_find_loop)->Apply(join_sizes);
+BENCHMARK(join_probe)->Apply(join_sizes);
+BENCHMARK(intersect_find_loop)->Apply(join_sizes);
+BENCHMARK(intersect_keys)->Apply(join_sizes);
+
+} // namespace
@@ -0,0 +1,148 @@
+#include "jg/dense_hash_map.hpp"
+#include "jg/dense_lru_cache.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <list>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// The usual LRU cache: a map to the entries of a list kept in recency order.
+class list_lru_cache
+{
+public:
+    explicit list_lru_cache(std::size_t capacity) : capacity_(capacity)
+    {
+        map_.reserve(capacity);
+    }
+
+    auto get(std::uint64_t key) -> std::uint64_t*
+    {
+        const auto it = map_.find(key);
+
+        if (it == map_.end())
+        {
+            return nullptr;
+        }
+
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return &it->second->second;
+    }
+
+    void put(std::uint64_t key, std::uint64_t value)
+    {
+        if (auto found = get(key))
+        {
+            *found = value;
+            return;
+        }
+
+        if (map_.size() == capacity_)
+        {
+            map_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+
+        entries_.emplace_front(key, value);
+        map_.try_emplace(key, entries_.begin());
+    }
+
+private:
+    using entries_type = std::list<std::pair<std::uint64_t, std::uint64_t>>;
+
+    entries_type entries_;
+    jg::dense_hash_map<std::uint64_t, entries_type::iterator> map_;
+    std::size_t capacity_;
+};
+
+// Zipf-like keys: a few hot ones and a long tail, about 4 times more distinct keys than the
+// cache holds.
+auto make_requests(std::uint64_t capacity) -> std::vector<std::uint64_t>
+{
+    std::mt19937_64 engine{42};
+    std::lognormal_distribution<double> distribution(0.0, 2.0);
+    std::vector<std::uint64_t> requests(1u << 20);
+
+    for (auto& key : requests)
+    {
+        key = static_cast<std::uint64_t>(distribution(engine) * static_cast<double>(capacity));
+    }
+
+    return requests;
+}
+
+template <class Cache>
+void lru_get_or_put(benchmark::State& state)
+{
+    const auto capacity = static_cast<std::uint64_t>(state.range(0));
+    const auto requests = make_requests(capacity);
+    Cache cache(capacity);
+
+    for (auto _ : state)
+    {
+        for (auto key : requests)
+        {
+            if (auto value = cache.get(key))
+            {
+                benchmark::DoNotOptimize(*value);
+            }
+            else
+            {
+                cache.put(key, key);
+            }
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * requests.size()));
+}
+
+// The hits of the batch are looked up through get_many(), then the misses are put.
+void lru_get_many(benchmark::State& state)
+{
+    const auto capacity = static_cast<std::uint64_t>(state.range(0));
+    const auto requests = make_requests(capacity);
+    jg::dense_lru_cache<std::uint64_t, std::uint64_t> cache(capacity);
+    std::vector<std::uint64_t> misses;
+    constexpr std::size_t batch_size = 64;
+
+    for (auto _ : state)
+    {
+        for (auto first = requests.begin(); first != requests.end(); first += batch_size)
+        {
+            misses.clear();
+            cache.get_many(first, first + batch_size, [&](auto it, std::uint64_t* value) {
+                if (value)
+                {
+                    benchmark::DoNotOptimize(*value);
+                }
+                else
+                {
+                    misses.push_back(*it);
+                }
+            });
+
+            for (auto key : misses)
+            {
+                cache.put(key, key);
+            }
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * requests.size()));
+}
+
+void lru_capacities(benchmark::internal::Benchmark* b)
+{
+    b->Arg(1 << 10)->Arg(1 << 16)->Arg(1 << 20);
+}
+
+BENCHMARK_TEMPLATE(lru_get_or_put, list_lru_cache)->Apply(lru_capacities);
+BENCHMARK_TEMPLATE(lru_get_or_put, jg::dense_lru_cache<std::uint64_t, std::uint64_t>)
+    ->Apply(lru_capacities);
+BENCHMARK(lru_get_many)->Apply(lru_capacities);
+
+} // namespace
@@ -0,0 +1,163 @@
+#include "jg/dense_hash_map.hpp"
+#include "jg/dense_hash_multimap.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using multimap_type = jg::dense_hash_multimap<std::uint64_t, std::uint64_t>;
+using tagged_items = std::vector<std::pair<std::uint64_t, std::uint64_t>>;
+
+// (tag, item) pairs: 1 << 20 items spread over tag_count tags.
+auto make_tagged_items(std::uint64_t tag_count) -> tagged_items
+{
+    std::mt19937_64 engine{42};
+    std::uniform_int_distribution<std::uint64_t> tag(0, tag_count - 1);
+    tagged_items items(1u << 20);
+    std::uint64_t item = 0;
+
+    for (auto& tagged : items)
+    {
+        tagged = {tag(engine), item++};
+    }
+
+    return items;
+}
+
+void index_map_of_vectors(benchmark::State& state)
+{
+    const auto items = make_tagged_items(static_cast<std::uint64_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        jg::dense_hash_map<std::uint64_t, std::vector<std::uint64_t>> index;
+
+        for (const auto& [tag, item] : items)
+        {
+            index[tag].push_back(item);
+        }
+
+        benchmark::DoNotOptimize(index);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * items.size()));
+}
+
+void index_multimap(benchmark::State& state)
+{
+    const auto items = make_tagged_items(static_cast<std::uint64_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        multimap_type index;
+
+        for (const auto& [tag, item] : items)
+        {
+            index.emplace(tag, item);
+        }
+
+        benchmark::DoNotOptimize(index);
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * items.size()));
+}
+
+template <class Index>
+void scan_tags(benchmark::State& state, const Index& index, std::uint64_t tag_count)
+{
+    std::size_t item_count = 0;
+
+    for (auto _ : state)
+    {
+        std::uint64_t sum = 0;
+
+        for (std::uint64_t tag = 0; tag < tag_count; ++tag)
+        {
+            if constexpr (std::is_same_v<typename Index::mapped_type, std::vector<std::uint64_t>>)
+            {
+                for (const auto item : index.find(tag)->second)
+                {
+                    sum += item;
+                }
+            }
+            else
+            {
+                const auto [first, last] = index.equal_range(tag);
+
+                for (auto it = first; it != last; ++it)
+                {
+                    sum += it->second;
+                }
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    for (const auto& entry : index)
+    {
+        if constexpr (std::is_same_v<typename Index::mapped_type, std::vector<std::uint64_t>>)
+        {
+            item_count += entry.second.size();
+        }
+        else
+        {
+            ++item_count;
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * item_count));
+}
+
+void lookup_map_of_vectors(benchmark::State& state)
+{
+    const auto tag_count = static_cast<std::uint64_t>(state.range(0));
+    jg::dense_hash_map<std::uint64_t, std::vector<std::uint64_t>> index;
+
+    for (const auto& [tag, item] : make_tagged_items(tag_count))
+    {
+        index[tag].push_back(item);
+    }
+
+    scan_tags(state, index, tag_count);
+}
+
+auto make_multimap(std::uint64_t tag_count) -> multimap_type
+{
+    multimap_type index;
+
+    for (const auto& [tag, item] : make_tagged_items(tag_count))
+    {
+        index.emplace(tag, item);
+    }
+
+    return index;
+}
+
+// The entries appended since the last growth are not regrouped yet.
+void lookup_multimap(benchmark::State& state)
+{
+    const auto tag_count = static_cast<std::uint64_t>(state.range(0));
+    scan_tags(state, make_multimap(tag_count), tag_count);
+}
+
+void lookup_multimap_regrouped(benchmark::State& state)
+{
+    const auto tag_count = static_cast<std::uint64_t>(state.range(0));
+    auto index = make_multimap(tag_count);
+    index.shrink_to_fit();
+    scan_tags(state, index, tag_count);
+}
+} // namespace
+
+BENCHMARK(index_map_of_vectors)->Arg(1 << 4)->Arg(1 << 12)->Arg(1 << 18);
+BENCHMARK(index_multimap)->Arg(1 << 4)->Arg(1 << 12)->Arg(1 << 18);
+BENCHMARK(lookup_map_of_vectors)->Arg(1 << 4)->Arg(1 << 12)->Arg(1 << 18);
+BENCHMARK(lookup_multimap)->Arg(1 << 4)->Arg(1 << 12)->Arg(1 << 18);
+BENCHMARK(lookup_multimap_regrouped)->Arg(1 << 4)->Arg(1 << 12)->Arg(1 << 18);
@@ -0,0 +1,99 @@
+#ifndef JG_BENCHMARKS_PERF_COUNTERS_HPP
+#define JG_BENCHMARKS_PERF_COUNTERS_HPP
+
+#include <cstdint>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace jg::benchmarks
+{
+
+// Thin wrapper around a single hardware counter of perf_event_open(2).
+// available() is false when the kernel refuses to open the counter (perf_event_paranoid,
+// containers, non-Linux platforms...), in which case the benchmarks simply skip reporting it.
+class perf_counter
+{
+public:
+#if defined(__linux__)
+    perf_counter(std::uint32_t type, std::uint64_t config)
+    {
+        perf_event_attr attr{};
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+
+        fd_ = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+
+    ~perf_counter()
+    {
+        if (available())
+        {
+            ::close(fd_);
+        }
+    }
+
+    void start()
+    {
+        if (available())
+        {
+            ::ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    auto stop() -> std::uint64_t
+    {
+        std::uint64_t value = 0;
+
+        if (available())
+        {
+            ::ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+
+            if (::read(fd_, &value, sizeof(value)) != sizeof(value))
+            {
+                value = 0;
+            }
+        }
+
+        return value;
+    }
+#else
+    perf_counter(std::uint32_t /*type*/, std::uint64_t /*config*/) {}
+
+    void start() {}
+
+    auto stop() -> std::uint64_t { return 0; }
+#endif
+
+    perf_counter(const perf_counter&) = delete;
+    auto operator=(const perf_counter&) -> perf_counter& = delete;
+
+    auto available() const -> bool { return fd_ >= 0; }
+
+private:
+    int fd_ = -1;
+};
+
+#if defined(__linux__)
+inline auto make_dtlb_miss_counter() -> perf_counter
+{
+    return perf_counter(
+        PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+}
+#else
+inline auto make_dtlb_miss_counter() -> perf_counter { return perf_counter(0, 0); }
+#endif
+
+} // namespace jg::benchmarks
+
+#endif // JG_BENCHMARKS_PERF_COUNTERS_HPP
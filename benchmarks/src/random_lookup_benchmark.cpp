@@ -0,0 +1,92 @@
+#include "perf_counters.hpp"
+
+#include "jg/dense_hash_map.hpp"
+#include "jg/huge_page_allocator.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+template <class Allocator>
+using map_type = jg::dense_hash_map<
+    std::uint64_t, std::uint64_t, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>,
+    Allocator>;
+
+auto make_keys(std::size_t count) -> std::vector<std::uint64_t>
+{
+    std::mt19937_64 engine{42};
+    std::vector<std::uint64_t> keys(count);
+
+    for (auto& key : keys)
+    {
+        key = engine();
+    }
+
+    return keys;
+}
+
+template <class Allocator>
+void random_lookup(benchmark::State& state)
+{
+    const auto size = static_cast<std::size_t>(state.range(0));
+    const auto keys = make_keys(size);
+
+    map_type<Allocator> m;
+    m.reserve(size);
+
+    for (auto key : keys)
+    {
+        m.try_emplace(key, key);
+    }
+
+    std::mt19937_64 engine{1337};
+    std::uniform_int_distribution<std::size_t> distribution(0, size - 1);
+    std::vector<std::uint64_t> lookups(1u << 16);
+
+    for (auto& key : lookups)
+    {
+        key = keys[distribution(engine)];
+    }
+
+    auto dtlb_misses = jg::benchmarks::make_dtlb_miss_counter();
+    std::uint64_t total_misses = 0;
+    std::uint64_t total_lookups = 0;
+
+    for (auto _ : state)
+    {
+        dtlb_misses.start();
+
+        for (auto key : lookups)
+        {
+            benchmark::DoNotOptimize(m.find(key));
+        }
+
+        total_misses += dtlb_misses.stop();
+        total_lookups += lookups.size();
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(total_lookups));
+
+    if (dtlb_misses.available())
+    {
+        state.counters["dTLB-misses/lookup"] =
+            static_cast<double>(total_misses) / static_cast<double>(total_lookups);
+    }
+}
+
+void lookup_sizes(benchmark::internal::Benchmark* b)
+{
+    b->RangeMultiplier(8)->Range(1 << 12, 1 << 24);
+}
+
+BENCHMARK_TEMPLATE(random_lookup, std::allocator<std::pair<const std::uint64_t, std::uint64_t>>)
+    ->Apply(lookup_sizes);
+BENCHMARK_TEMPLATE(
+    random_lookup, jg::huge_page_allocator<std::pair<const std::uint64_t, std::uint64_t>>)
+    ->Apply(lookup_sizes);
+
+} // namespace
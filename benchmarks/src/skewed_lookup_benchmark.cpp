@@ -0,0 +1,93 @@
+#include "jg/dense_hash_map.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+template <class StoragePolicy>
+using map_type = jg::dense_hash_map<
+    std::uint64_t, std::uint64_t, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>,
+    std::allocator<std::pair<const std::uint64_t, std::uint64_t>>,
+    jg::details::power_of_two_growth_policy, StoragePolicy>;
+
+// The first 1% of the keys, inserted first and thus at the tail of their chains, take 60% of the
+// lookups.
+auto make_skewed_lookups(std::uint64_t size) -> std::vector<std::uint64_t>
+{
+    std::mt19937_64 engine{42};
+    std::bernoulli_distribution is_hot(0.6);
+    std::uniform_int_distribution<std::uint64_t> hot(0, size / 100 - 1);
+    std::uniform_int_distribution<std::uint64_t> any(0, size - 1);
+    std::vector<std::uint64_t> lookups(1u << 16);
+
+    for (auto& key : lookups)
+    {
+        key = is_hot(engine) ? hot(engine) : any(engine);
+    }
+
+    return lookups;
+}
+
+template <class Map>
+auto average_probe_depth(const Map& m, const std::vector<std::uint64_t>& lookups) -> double
+{
+    std::uint64_t total_depth = 0;
+
+    for (auto key : lookups)
+    {
+        total_depth += m.probe_depth(key);
+    }
+
+    return static_cast<double>(total_depth) / static_cast<double>(lookups.size());
+}
+
+// Skewed lookups at the max load factor given by the second argument. Reports the probe depth
+// averaged over the lookups before and after running them.
+template <class StoragePolicy>
+void skewed_lookup(benchmark::State& state)
+{
+    const auto size = static_cast<std::uint64_t>(state.range(0));
+    map_type<StoragePolicy> m;
+    m.max_load_factor(static_cast<float>(state.range(1)));
+
+    for (std::uint64_t i = 0; i < size; ++i)
+    {
+        m.try_emplace(i, i);
+    }
+
+    const auto lookups = make_skewed_lookups(size);
+    state.counters["probe_depth_before"] = average_probe_depth(m, lookups);
+
+    for (auto _ : state)
+    {
+        std::uint64_t sum = 0;
+
+        for (auto key : lookups)
+        {
+            sum += m.find(key)->second;
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.counters["probe_depth_after"] = average_probe_depth(m, lookups);
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * lookups.size()));
+}
+
+void skewed_lookup_args(benchmark::internal::Benchmark* b)
+{
+    for (std::int64_t max_load_factor : {1, 4, 16})
+    {
+        b->Args({1 << 20, max_load_factor});
+    }
+}
+
+BENCHMARK_TEMPLATE(skewed_lookup, jg::details::vector_storage_policy)->Apply(skewed_lookup_args);
+BENCHMARK_TEMPLATE(skewed_lookup, jg::details::move_to_front_storage_policy<>)
+    ->Apply(skewed_lookup_args);
+
+} // namespace
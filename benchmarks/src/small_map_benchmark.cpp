@@ -0,0 +1,53 @@
+#include "tracking_allocator.hpp"
+
+#include "jg/dense_hash_map.hpp"
+#include "jg/small_dense_hash_map.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+
+namespace
+{
+template <class StoragePolicy>
+using map_type = jg::dense_hash_map<
+    std::uint64_t, std::uint64_t, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>,
+    jg::benchmarks::tracking_allocator<std::pair<const std::uint64_t, std::uint64_t>>,
+    jg::details::power_of_two_growth_policy, StoragePolicy>;
+
+// Builds, probes and destroys many short-lived small maps, and reports the number of allocations
+// made per map.
+template <class StoragePolicy>
+void small_maps(benchmark::State& state)
+{
+    const auto size = static_cast<std::uint64_t>(state.range(0));
+    auto& tracker = jg::benchmarks::memory_tracker::instance();
+    tracker.reset();
+
+    for (auto _ : state)
+    {
+        map_type<StoragePolicy> m;
+
+        for (std::uint64_t i = 0; i < size; ++i)
+        {
+            m.try_emplace(i * 7919, i);
+        }
+
+        for (std::uint64_t i = 0; i < size; ++i)
+        {
+            benchmark::DoNotOptimize(m.find(i * 7919));
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * size));
+    state.counters["allocs_per_map"] =
+        static_cast<double>(tracker.allocations) / static_cast<double>(state.iterations());
+}
+
+void small_sizes(benchmark::internal::Benchmark* b) { b->Arg(4)->Arg(7)->Arg(16)->Arg(32); }
+
+BENCHMARK_TEMPLATE(small_maps, jg::details::vector_storage_policy)->Apply(small_sizes);
+BENCHMARK_TEMPLATE(small_maps, jg::details::single_block_storage_policy)->Apply(small_sizes);
+BENCHMARK_TEMPLATE(small_maps, jg::details::small_storage_policy<8>)->Apply(small_sizes);
+
+} // namespace
@@ -0,0 +1,98 @@
+#include "jg/dense_hash_map.hpp"
+#include "jg/dense_string_map.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+// Keys of 20 to 40 characters, past the small string buffer of std::string.
+auto make_keys(std::size_t count) -> std::vector<std::string>
+{
+    std::vector<std::string> keys;
+    keys.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        keys.push_back("/users/" + std::to_string(i * 2654435761u % 1'000'000'007u) + "/" +
+                       std::string(i % 21, 'k'));
+    }
+
+    return keys;
+}
+
+template <class Map>
+void string_map_load(benchmark::State& state)
+{
+    const auto keys = make_keys(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state)
+    {
+        Map m;
+
+        for (const auto& key : keys)
+        {
+            m.try_emplace(key, key.size());
+        }
+
+        benchmark::DoNotOptimize(m.size());
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * keys.size()));
+}
+
+template <class Map>
+void string_map_lookup(benchmark::State& state)
+{
+    const auto keys = make_keys(static_cast<std::size_t>(state.range(0)));
+    Map m;
+
+    for (const auto& key : keys)
+    {
+        m.try_emplace(key, key.size());
+    }
+
+    std::mt19937_64 engine{42};
+    std::vector<std::string_view> lookups(1u << 16);
+
+    for (auto& lookup : lookups)
+    {
+        lookup = keys[engine() % keys.size()];
+    }
+
+    for (auto _ : state)
+    {
+        for (auto lookup : lookups)
+        {
+            benchmark::DoNotOptimize(m.find(lookup));
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * lookups.size()));
+}
+
+struct string_view_hash
+{
+    using is_transparent = void;
+
+    auto operator()(std::string_view key) const -> std::size_t
+    {
+        return std::hash<std::string_view>{}(key);
+    }
+};
+
+using string_map =
+    jg::dense_hash_map<std::string, std::uint64_t, string_view_hash, std::equal_to<>>;
+using arena_map = jg::dense_string_map<std::uint64_t>;
+
+BENCHMARK_TEMPLATE(string_map_load, string_map)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(string_map_load, arena_map)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(string_map_lookup, string_map)->Arg(1 << 16)->Arg(1 << 20);
+BENCHMARK_TEMPLATE(string_map_lookup, arena_map)->Arg(1 << 16)->Arg(1 << 20);
+
+} // namespace
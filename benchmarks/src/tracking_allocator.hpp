@@ -0,0 +1,80 @@
+#ifndef JG_BENCHMARKS_TRACKING_ALLOCATOR_HPP
+#define JG_BENCHMARKS_TRACKING_ALLOCATOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+
+namespace jg::benchmarks
+{
+
+// Process-wide RSS high-water marks cannot be reset between benchmarks, so the benchmarks track the
+// live and peak number of bytes requested by the containers instead.
+struct memory_tracker
+{
+    static auto instance() -> memory_tracker&
+    {
+        static memory_tracker tracker;
+        return tracker;
+    }
+
+    void reset()
+    {
+        current_bytes = 0;
+        peak_bytes = 0;
+        allocations = 0;
+    }
+
+    void on_allocate(std::size_t bytes)
+    {
+        current_bytes += bytes;
+        peak_bytes = std::max(peak_bytes, current_bytes);
+        ++allocations;
+    }
+
+    void on_deallocate(std::size_t bytes) { current_bytes -= bytes; }
+
+    std::size_t current_bytes = 0;
+    std::size_t peak_bytes = 0;
+    std::size_t allocations = 0;
+};
+
+template <class T>
+struct tracking_allocator
+{
+    using value_type = T;
+
+    tracking_allocator() = default;
+
+    template <class U>
+    constexpr tracking_allocator(const tracking_allocator<U>& /*other*/) noexcept
+    {}
+
+    auto allocate(std::size_t n) -> T*
+    {
+        memory_tracker::instance().on_allocate(n * sizeof(T));
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        memory_tracker::instance().on_deallocate(n * sizeof(T));
+        std::allocator<T>{}.deallocate(p, n);
+    }
+};
+
+template <class T, class U>
+constexpr auto operator==(const tracking_allocator<T>&, const tracking_allocator<U>&) -> bool
+{
+    return true;
+}
+
+template <class T, class U>
+constexpr auto operator!=(const tracking_allocator<T>&, const tracking_allocator<U>&) -> bool
+{
+    return false;
+}
+
+} // namespace jg::benchmarks
+
+#endif // JG_BENCHMARKS_TRACKING_ALLOCATOR_HPP
@@ -0,0 +1,116 @@
+#include "jg/dense_hash_map.hpp"
+#include "jg/dense_ttl_map.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+using namespace std::chrono_literals;
+using time_point = std::chrono::steady_clock::time_point;
+
+// The usual expiring map: a map to the values and their deadlines, and a priority queue of the
+// deadlines, reaped by erasing the keys one by one. The stale entries of the queue are skipped.
+class queue_ttl_map
+{
+public:
+    void put(std::uint64_t key, std::uint64_t value, time_point deadline)
+    {
+        map_.insert_or_assign(key, std::pair{value, deadline});
+        deadlines_.emplace(deadline, key);
+    }
+
+    auto get(std::uint64_t key, time_point now) -> std::uint64_t*
+    {
+        const auto it = map_.find(key);
+        return it == map_.end() || it->second.second <= now ? nullptr : &it->second.first;
+    }
+
+    auto expire(time_point now) -> std::size_t
+    {
+        std::size_t erased = 0;
+
+        while (!deadlines_.empty() && deadlines_.top().first <= now)
+        {
+            const auto [deadline, key] = deadlines_.top();
+            deadlines_.pop();
+            const auto it = map_.find(key);
+
+            if (it != map_.end() && it->second.second == deadline)
+            {
+                map_.erase(it);
+                ++erased;
+            }
+        }
+
+        return erased;
+    }
+
+private:
+    using deadline_type = std::pair<time_point, std::uint64_t>;
+
+    jg::dense_hash_map<std::uint64_t, std::pair<std::uint64_t, time_point>> map_;
+    std::priority_queue<deadline_type, std::vector<deadline_type>, std::greater<>> deadlines_;
+};
+
+// Sessions: every millisecond, requests_per_ms keys are looked up and put again with a TTL of
+// 1 to 2 seconds, a quarter of them new. The map is expired every expire_period_ms. Runs for 10
+// simulated seconds.
+template <class Map>
+void session_churn(benchmark::State& state)
+{
+    const auto requests_per_ms = static_cast<std::uint64_t>(state.range(0));
+    const auto expire_period_ms = static_cast<int>(state.range(1));
+    std::mt19937_64 engine{42};
+    std::uniform_int_distribution<std::uint64_t> ttl_ms(1000, 2000);
+    std::uint64_t processed = 0;
+
+    for (auto _ : state)
+    {
+        Map m;
+        std::uint64_t next_key = 0;
+        time_point now{1000s};
+
+        for (int ms = 0; ms < 10'000; ++ms, now += 1ms)
+        {
+            for (std::uint64_t i = 0; i < requests_per_ms; ++i)
+            {
+                const auto key = i % 4 == 0 || next_key < 1000 ? next_key++ : engine() % next_key;
+
+                if (auto value = m.get(key, now))
+                {
+                    benchmark::DoNotOptimize(*value);
+                }
+
+                m.put(key, key, now + std::chrono::milliseconds(ttl_ms(engine)));
+            }
+
+            if (ms % expire_period_ms == 0)
+            {
+                benchmark::DoNotOptimize(m.expire(now));
+            }
+        }
+
+        processed += 10'000 * requests_per_ms;
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(processed));
+}
+
+void session_args(benchmark::internal::Benchmark* b)
+{
+    b->Args({16, 1})->Args({256, 1})->Args({256, 1000})->Unit(benchmark::kMillisecond);
+}
+
+BENCHMARK_TEMPLATE(session_churn, queue_ttl_map)->Apply(session_args);
+BENCHMARK_TEMPLATE(session_churn, jg::dense_ttl_map<std::uint64_t, std::uint64_t>)
+    ->Apply(session_args);
+
+} // namespace
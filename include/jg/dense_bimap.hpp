@@ -0,0 +1,788 @@
+#ifndef JG_DENSE_BIMAP_HPP
+#define JG_DENSE_BIMAP_HPP
+
+#include "dense_hash_map.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jg
+{
+
+namespace details
+{
+    // The two directions of a dense_bimap.
+    enum class bimap_side
+    {
+        left,
+        right
+    };
+
+    // Node of a dense_bimap: a (left, right) record, chained in the buckets of each side.
+    template <class Left, class Right, class Pair = std::pair<Left, Right>>
+    struct bimap_node : disable_copy_constructor<Pair>,
+                        disable_copy_assignment<Pair>,
+                        disable_move_constructor<Pair>,
+                        disable_move_assignment<Pair>
+    {
+        template <class... Args>
+        constexpr bimap_node(node_index_t<Left, Right> left_next, Args&&... args)
+            : left_next(left_next), pair(std::forward<Args>(args)...)
+        {}
+
+        template <class Allocator, class... Args>
+        constexpr bimap_node(
+            std::allocator_arg_t, const Allocator& alloc, node_index_t<Left, Right> left_next,
+            Args&&... args)
+            : left_next(left_next), pair(std::allocator_arg, alloc, std::forward<Args>(args)...)
+        {}
+
+        template <class Allocator>
+        constexpr bimap_node(std::allocator_arg_t, const Allocator& alloc, const bimap_node& other)
+            : left_next(other.left_next)
+            , right_next(other.right_next)
+            , pair(std::allocator_arg, alloc, other.pair.pair())
+        {}
+
+        template <class Allocator>
+        constexpr bimap_node(std::allocator_arg_t, const Allocator& alloc, bimap_node&& other)
+            : left_next(other.left_next)
+            , right_next(other.right_next)
+            , pair(std::allocator_arg, alloc, std::move(other.pair.pair()))
+        {}
+
+        node_index_t<Left, Right> left_next = node_end_index<Left, Right>;
+        node_index_t<Left, Right> right_next = node_end_index<Left, Right>;
+        key_value_pair_t<Left, Right> pair;
+    };
+} // namespace details
+
+// A bidirectional hash map: each left value maps to one right value and the other way round. The
+// (left, right) records are stored contiguously in a single vector of nodes, as in a
+// dense_hash_map, and each side has its own bucket array, chained through a next index of its own
+// in the nodes. Both directions share the records instead of each holding a copy of both values,
+// and an erase from either side unlinks the node from both chains and moves the last node into
+// its place in one go, so the two sides cannot disagree.
+//
+// The entries are immutable: change one by erasing it and inserting the new pair. An insertion
+// fails when either of its values is already mapped.
+template <
+    class Left, class Right, class LeftHash = std::hash<Left>,
+    class LeftPred = std::equal_to<Left>, class RightHash = std::hash<Right>,
+    class RightPred = std::equal_to<Right>,
+    class Allocator = std::allocator<std::pair<const Left, Right>>,
+    class GrowthPolicy = details::power_of_two_growth_policy>
+class dense_bimap
+{
+private:
+    using storage_node_type = details::bimap_node<Left, Right>;
+    using nodes_container_type =
+        std::vector<storage_node_type, details::rebind_alloc<Allocator, storage_node_type>>;
+    using node_index_type = details::node_index_t<Left, Right>;
+    using buckets_container_type =
+        std::vector<node_index_type, details::rebind_alloc<Allocator, node_index_type>>;
+    using side = details::bimap_side;
+
+    static inline constexpr node_index_type node_end_index = details::node_end_index<Left, Right>;
+
+public:
+    using left_type = Left;
+    using right_type = Right;
+    using value_type = std::pair<const Left, Right>;
+    using size_type = typename nodes_container_type::size_type;
+    using difference_type = typename nodes_container_type::difference_type;
+    using left_hasher = LeftHash;
+    using left_key_equal = typename details::key_equal<LeftHash, LeftPred, Left>::type;
+    using right_hasher = RightHash;
+    using right_key_equal = typename details::key_equal<RightHash, RightPred, Right>::type;
+    using allocator_type = Allocator;
+    using reference = const value_type&;
+    using const_reference = const value_type&;
+    using pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+    using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+    using const_iterator =
+        details::dense_hash_map_iterator<Left, Right, nodes_container_type, true, true>;
+    using iterator = const_iterator;
+
+    constexpr dense_bimap() : dense_bimap(default_bucket_count()) {}
+
+    constexpr explicit dense_bimap(
+        size_type bucket_count, const LeftHash& left_hash = LeftHash(),
+        const left_key_equal& left_equal = left_key_equal(),
+        const RightHash& right_hash = RightHash(),
+        const right_key_equal& right_equal = right_key_equal(),
+        const allocator_type& alloc = allocator_type())
+        : nodes_(typename nodes_container_type::allocator_type(alloc))
+        , left_buckets_(typename buckets_container_type::allocator_type(alloc))
+        , right_buckets_(typename buckets_container_type::allocator_type(alloc))
+        , left_hash_(left_hash)
+        , left_equal_(left_equal)
+        , right_hash_(right_hash)
+        , right_equal_(right_equal)
+    {
+        rebuild_buckets(bucket_count);
+    }
+
+    constexpr dense_bimap(size_type bucket_count, const allocator_type& alloc)
+        : dense_bimap(
+              bucket_count, LeftHash(), left_key_equal(), RightHash(), right_key_equal(), alloc)
+    {}
+
+    constexpr explicit dense_bimap(const allocator_type& alloc)
+        : dense_bimap(default_bucket_count(), alloc)
+    {}
+
+    template <class InputIt>
+    constexpr dense_bimap(
+        InputIt first, InputIt last, size_type bucket_count = default_bucket_count(),
+        const allocator_type& alloc = allocator_type())
+        : dense_bimap(bucket_count, alloc)
+    {
+        insert(first, last);
+    }
+
+    constexpr dense_bimap(
+        std::initializer_list<value_type> init, size_type bucket_count = default_bucket_count(),
+        const allocator_type& alloc = allocator_type())
+        : dense_bimap(init.begin(), init.end(), bucket_count, alloc)
+    {}
+
+    constexpr dense_bimap(const dense_bimap& other) = default;
+
+    constexpr dense_bimap(const dense_bimap& other, const allocator_type& alloc)
+        : nodes_(other.nodes_, typename nodes_container_type::allocator_type(alloc))
+        , left_buckets_(other.left_buckets_, typename buckets_container_type::allocator_type(alloc))
+        , right_buckets_(
+              other.right_buckets_, typename buckets_container_type::allocator_type(alloc))
+        , left_hash_(other.left_hash_)
+        , left_equal_(other.left_equal_)
+        , right_hash_(other.right_hash_)
+        , right_equal_(other.right_equal_)
+        , max_load_factor_(other.max_load_factor_)
+    {}
+
+    constexpr dense_bimap(dense_bimap&& other) noexcept(
+        std::is_nothrow_move_constructible_v<nodes_container_type>&&
+            std::is_nothrow_move_constructible_v<buckets_container_type>) = default;
+
+    ~dense_bimap() = default;
+
+    constexpr auto operator=(const dense_bimap& other) -> dense_bimap& = default;
+    constexpr auto operator=(dense_bimap&& other) noexcept(
+        std::is_nothrow_move_assignable_v<nodes_container_type>&&
+            std::is_nothrow_move_assignable_v<buckets_container_type>) -> dense_bimap& = default;
+
+    constexpr auto operator=(std::initializer_list<value_type> ilist) -> dense_bimap&
+    {
+        clear();
+        insert(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    constexpr auto get_allocator() const -> allocator_type
+    {
+        return allocator_type(nodes_.get_allocator());
+    }
+
+    constexpr auto begin() const noexcept -> const_iterator
+    {
+        return const_iterator{nodes_.begin()};
+    }
+
+    constexpr auto cbegin() const noexcept -> const_iterator { return begin(); }
+
+    constexpr auto end() const noexcept -> const_iterator { return const_iterator{nodes_.end()}; }
+
+    constexpr auto cend() const noexcept -> const_iterator { return end(); }
+
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return nodes_.empty(); }
+
+    constexpr auto size() const noexcept -> size_type { return nodes_.size(); }
+
+    constexpr auto max_size() const noexcept -> size_type
+    {
+        return std::min<size_type>(nodes_.max_size(), node_end_index - 1);
+    }
+
+    constexpr void clear() noexcept
+    {
+        nodes_.clear();
+        std::fill(left_buckets_.begin(), left_buckets_.end(), node_end_index);
+        std::fill(right_buckets_.begin(), right_buckets_.end(), node_end_index);
+    }
+
+    // Inserts the (left, right) pair built from args, unless its left or its right value is
+    // already mapped. Returns the new entry, or else the entry of the left value if it is mapped,
+    // or of the right value.
+    template <class... Args>
+    auto emplace(Args&&... args) -> std::pair<iterator, bool>
+    {
+        // The values must be built to be looked up, and the arguments may refer to an entry.
+        nodes_.emplace_back(node_end_index, std::forward<Args>(args)...);
+        const auto index = static_cast<node_index_type>(nodes_.size() - 1);
+
+#ifndef JG_NO_EXCEPTION
+        try
+        {
+#endif
+            const auto& pair = nodes_.back().pair.pair();
+            const auto left_hash = left_hash_(pair.first);
+            auto found = find_index<side::left>(pair.first, left_hash);
+
+            if (found == node_end_index)
+            {
+                const auto right_hash = right_hash_(pair.second);
+                found = find_index<side::right>(pair.second, right_hash);
+
+                if (found == node_end_index)
+                {
+                    if (size() > bucket_count() * max_load_factor())
+                    {
+                        rehash(details::grow_bucket_count<GrowthPolicy>(bucket_count()));
+                    }
+                    else
+                    {
+                        link<side::left>(index, left_hash);
+                        link<side::right>(index, right_hash);
+                    }
+
+                    return {std::prev(end()), true};
+                }
+            }
+
+            nodes_.pop_back();
+            return {std::next(begin(), static_cast<difference_type>(found)), false};
+#ifndef JG_NO_EXCEPTION
+        }
+        catch (...)
+        {
+            nodes_.pop_back();
+            throw;
+        }
+#endif
+    }
+
+    auto insert(const value_type& value) -> std::pair<iterator, bool> { return emplace(value); }
+
+    auto insert(value_type&& value) -> std::pair<iterator, bool>
+    {
+        return emplace(std::move(value));
+    }
+
+    template <class P, std::enable_if_t<std::is_constructible_v<value_type, P&&>, int> = 0>
+    auto insert(P&& value) -> std::pair<iterator, bool>
+    {
+        return emplace(std::forward<P>(value));
+    }
+
+    template <class InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        if constexpr (std::is_base_of_v<
+                          std::forward_iterator_tag,
+                          typename std::iterator_traits<InputIt>::iterator_category>)
+        {
+            reserve(size() + static_cast<size_type>(std::distance(first, last)));
+        }
+
+        for (; first != last; ++first)
+        {
+            emplace(*first);
+        }
+    }
+
+    void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+
+    // Erases the entry at pos, which the last entry replaces.
+    constexpr auto erase(const_iterator pos) -> iterator
+    {
+        const auto position = std::distance(cbegin(), pos);
+        erase_at(static_cast<node_index_type>(position));
+        return std::next(begin(), position);
+    }
+
+    constexpr auto erase_left(const left_type& left) -> size_type
+    {
+        return do_erase<side::left>(left);
+    }
+
+    template <
+        class K,
+        class Useless = std::enable_if_t<details::is_transparent_lookup_v<LeftHash, LeftPred>, K>>
+    constexpr auto erase_left(const K& left) -> size_type
+    {
+        return do_erase<side::left>(left);
+    }
+
+    constexpr auto erase_right(const right_type& right) -> size_type
+    {
+        return do_erase<side::right>(right);
+    }
+
+    template <
+        class K,
+        class Useless = std::enable_if_t<details::is_transparent_lookup_v<RightHash, RightPred>, K>>
+    constexpr auto erase_right(const K& right) -> size_type
+    {
+        return do_erase<side::right>(right);
+    }
+
+    // Erases the entries for which pred(value) holds. The remaining entries keep their order, and
+    // the chains of both sides are rebuilt once.
+    template <class Predicate>
+    constexpr auto erase_if(Predicate pred) -> size_type
+    {
+        const auto old_size = size();
+        auto kept = nodes_.begin();
+
+        for (auto it = nodes_.begin(); it != nodes_.end(); ++it)
+        {
+            if (pred(std::as_const(it->pair.const_key_pair())))
+            {
+                continue;
+            }
+
+            if (kept != it)
+            {
+                *kept = std::move(*it);
+            }
+
+            ++kept;
+        }
+
+        nodes_.erase(kept, nodes_.end());
+
+        if (size() != old_size)
+        {
+            relink_nodes();
+        }
+
+        return old_size - size();
+    }
+
+    constexpr void swap(dense_bimap& other) noexcept(
+        std::allocator_traits<Allocator>::is_always_equal::value&&
+            std::is_nothrow_swappable_v<LeftHash>&& std::is_nothrow_swappable_v<left_key_equal>&&
+                std::is_nothrow_swappable_v<RightHash>&&
+                    std::is_nothrow_swappable_v<right_key_equal>)
+    {
+        using std::swap;
+        swap(nodes_, other.nodes_);
+        swap(left_buckets_, other.left_buckets_);
+        swap(right_buckets_, other.right_buckets_);
+        swap(left_hash_, other.left_hash_);
+        swap(left_equal_, other.left_equal_);
+        swap(right_hash_, other.right_hash_);
+        swap(right_equal_, other.right_equal_);
+        swap(max_load_factor_, other.max_load_factor_);
+    }
+
+    constexpr auto find_left(const left_type& left) const -> const_iterator
+    {
+        return position_of<side::left>(left);
+    }
+
+    template <
+        class K,
+        class Useless = std::enable_if_t<details::is_transparent_lookup_v<LeftHash, LeftPred>, K>>
+    constexpr auto find_left(const K& left) const -> const_iterator
+    {
+        return position_of<side::left>(left);
+    }
+
+    constexpr auto find_right(const right_type& right) const -> const_iterator
+    {
+        return position_of<side::right>(right);
+    }
+
+    template <
+        class K,
+        class Useless = std::enable_if_t<details::is_transparent_lookup_v<RightHash, RightPred>, K>>
+    constexpr auto find_right(const K& right) const -> const_iterator
+    {
+        return position_of<side::right>(right);
+    }
+
+    constexpr auto contains_left(const left_type& left) const -> bool
+    {
+        return find_left(left) != end();
+    }
+
+    template <
+        class K,
+        class Useless = std::enable_if_t<details::is_transparent_lookup_v<LeftHash, LeftPred>, K>>
+    constexpr auto contains_left(const K& left) const -> bool
+    {
+        return find_left(left) != end();
+    }
+
+    constexpr auto contains_right(const right_type& right) const -> bool
+    {
+        return find_right(right) != end();
+    }
+
+    template <
+        class K,
+        class Useless = std::enable_if_t<details::is_transparent_lookup_v<RightHash, RightPred>, K>>
+    constexpr auto contains_right(const K& right) const -> bool
+    {
+        return find_right(right) != end();
+    }
+
+    // The right value mapped to left.
+    constexpr auto at_left(const left_type& left) const -> const right_type&
+    {
+        return checked(find_left(left))->second;
+    }
+
+    // The left value mapped to right.
+    constexpr auto at_right(const right_type& right) const -> const left_type&
+    {
+        return checked(find_right(right))->first;
+    }
+
+    constexpr auto bucket_count() const noexcept -> size_type { return left_buckets_.size(); }
+
+    constexpr auto load_factor() const -> float
+    {
+        return size() / static_cast<float>(bucket_count());
+    }
+
+    constexpr auto max_load_factor() const -> float { return max_load_factor_; }
+
+    constexpr void max_load_factor(float ml)
+    {
+        assert(ml > 0.0f && "The max load factor must be greater than 0.0f.");
+        max_load_factor_ = ml;
+        rehash(8);
+    }
+
+    constexpr void rehash(size_type count) { rebuild_buckets(count); }
+
+    constexpr void reserve(size_type count)
+    {
+        rehash(static_cast<size_type>(std::ceil(count / max_load_factor())));
+        nodes_.reserve(count);
+    }
+
+    constexpr auto left_hash_function() const -> left_hasher { return left_hash_; }
+
+    constexpr auto left_key_eq() const -> left_key_equal { return left_equal_; }
+
+    constexpr auto right_hash_function() const -> right_hasher { return right_hash_; }
+
+    constexpr auto right_key_eq() const -> right_key_equal { return right_equal_; }
+
+private:
+    static constexpr auto default_bucket_count() -> size_type
+    {
+        return GrowthPolicy::minimum_capacity();
+    }
+
+    template <side Side>
+    static constexpr auto key_of(const storage_node_type& node) -> const auto&
+    {
+        if constexpr (Side == side::left)
+        {
+            return node.pair.const_key_pair().first;
+        }
+        else
+        {
+            return node.pair.const_key_pair().second;
+        }
+    }
+
+    template <side Side>
+    static constexpr auto next_of(storage_node_type& node) -> node_index_type&
+    {
+        return Side == side::left ? node.left_next : node.right_next;
+    }
+
+    template <side Side>
+    static constexpr auto next_of(const storage_node_type& node) -> node_index_type
+    {
+        return Side == side::left ? node.left_next : node.right_next;
+    }
+
+    template <side Side, class K>
+    constexpr auto hash_of(const K& key) const -> std::size_t
+    {
+        if constexpr (Side == side::left)
+        {
+            return left_hash_(key);
+        }
+        else
+        {
+            return right_hash_(key);
+        }
+    }
+
+    template <side Side>
+    constexpr auto bucket_of(std::size_t hash) -> node_index_type&
+    {
+        auto& buckets = Side == side::left ? left_buckets_ : right_buckets_;
+        return buckets[GrowthPolicy::compute_index(hash, bucket_count())];
+    }
+
+    template <side Side, class K>
+    constexpr auto find_index(const K& key, std::size_t hash) const -> node_index_type
+    {
+        const auto& buckets = Side == side::left ? left_buckets_ : right_buckets_;
+
+        // A moved-from bimap has no bucket.
+        if (buckets.empty())
+        {
+            return node_end_index;
+        }
+
+        for (auto index = buckets[GrowthPolicy::compute_index(hash, bucket_count())];
+             index != node_end_index; index = next_of<Side>(nodes_[index]))
+        {
+            const auto& node_key = key_of<Side>(nodes_[index]);
+
+            if constexpr (Side == side::left)
+            {
+                if (left_equal_(node_key, key))
+                {
+                    return index;
+                }
+            }
+            else
+            {
+                if (right_equal_(node_key, key))
+                {
+                    return index;
+                }
+            }
+        }
+
+        return node_end_index;
+    }
+
+    template <side Side, class K>
+    constexpr auto position_of(const K& key) const -> const_iterator
+    {
+        const auto index = find_index<Side>(key, hash_of<Side>(key));
+        return index == node_end_index ? end()
+                                       : std::next(begin(), static_cast<difference_type>(index));
+    }
+
+    constexpr auto checked(const_iterator it) const -> const_iterator
+    {
+        if (it == end())
+        {
+#ifdef JG_NO_EXCEPTION
+            std::abort();
+#else
+            throw std::out_of_range("The specified key does not exists in this bimap.");
+#endif
+        }
+
+        return it;
+    }
+
+    template <side Side, class K>
+    constexpr auto do_erase(const K& key) -> size_type
+    {
+        const auto index = find_index<Side>(key, hash_of<Side>(key));
+
+        if (index == node_end_index)
+        {
+            return 0u;
+        }
+
+        erase_at(index);
+        return 1u;
+    }
+
+    template <side Side>
+    constexpr void link(node_index_type index, std::size_t hash)
+    {
+        auto& bucket = bucket_of<Side>(hash);
+        next_of<Side>(nodes_[index]) = bucket;
+        bucket = index;
+    }
+
+    // The link referring to the node at index in the chain of its Side value: its bucket or the
+    // next index of its predecessor.
+    template <side Side>
+    constexpr auto link_to(node_index_type index) -> node_index_type&
+    {
+        auto* link = &bucket_of<Side>(hash_of<Side>(key_of<Side>(nodes_[index])));
+
+        while (*link != index)
+        {
+            link = &next_of<Side>(nodes_[*link]);
+        }
+
+        return *link;
+    }
+
+    // Unlinks the node at index from both chains, then moves the last node in its place, both of
+    // its links now referring to index.
+    constexpr void erase_at(node_index_type index)
+    {
+        auto& node = nodes_[index];
+        link_to<side::left>(index) = node.left_next;
+        link_to<side::right>(index) = node.right_next;
+
+        const auto last = static_cast<node_index_type>(nodes_.size() - 1);
+
+        if (index != last)
+        {
+            link_to<side::left>(last) = index;
+            link_to<side::right>(last) = index;
+            node = std::move(nodes_[last]);
+        }
+
+        nodes_.pop_back();
+    }
+
+    constexpr void rebuild_buckets(size_type count)
+    {
+        count = std::max(GrowthPolicy::minimum_capacity(), count);
+        count = std::max(count, static_cast<size_type>(size() / max_load_factor()));
+        count = GrowthPolicy::compute_closest_capacity(count);
+
+        if (count == bucket_count())
+        {
+            return;
+        }
+
+        // Both arrays are allocated before either one is replaced, so that they keep the same size
+        // if an allocation throws.
+        buckets_container_type left_buckets(count, node_end_index, left_buckets_.get_allocator());
+        buckets_container_type right_buckets(
+            count, node_end_index, right_buckets_.get_allocator());
+
+        left_buckets_.swap(left_buckets);
+        right_buckets_.swap(right_buckets);
+        relink_nodes();
+    }
+
+    // Rebuilds the chains of both sides from scratch, for the current bucket count.
+    constexpr void relink_nodes()
+    {
+        std::fill(left_buckets_.begin(), left_buckets_.end(), node_end_index);
+        std::fill(right_buckets_.begin(), right_buckets_.end(), node_end_index);
+
+        for (node_index_type index = 0; index < nodes_.size(); ++index)
+        {
+            const auto& pair = nodes_[index].pair.const_key_pair();
+            link<side::left>(index, left_hash_(pair.first));
+            link<side::right>(index, right_hash_(pair.second));
+        }
+    }
+
+    nodes_container_type nodes_;
+    buckets_container_type left_buckets_;
+    buckets_container_type right_buckets_;
+    LeftHash left_hash_;
+    left_key_equal left_equal_;
+    RightHash right_hash_;
+    right_key_equal right_equal_;
+    float max_load_factor_ = details::policy_max_load_factor<GrowthPolicy>();
+};
+
+// Equal when both hold the same pairs, whatever their order.
+template <
+    class Left, class Right, class LeftHash, class LeftPred, class RightHash, class RightPred,
+    class Allocator, class GrowthPolicy>
+auto operator==(
+    const dense_bimap<
+        Left, Right, LeftHash, LeftPred, RightHash, RightPred, Allocator, GrowthPolicy>& lhs,
+    const dense_bimap<
+        Left, Right, LeftHash, LeftPred, RightHash, RightPred, Allocator, GrowthPolicy>& rhs)
+    -> bool
+{
+    if (lhs.size() != rhs.size())
+    {
+        return false;
+    }
+
+    for (const auto& [left, right] : lhs)
+    {
+        const auto it = rhs.find_left(left);
+
+        if (it == rhs.end() || !(it->second == right))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <
+    class Left, class Right, class LeftHash, class LeftPred, class RightHash, class RightPred,
+    class Allocator, class GrowthPolicy>
+auto operator!=(
+    const dense_bimap<
+        Left, Right, LeftHash, LeftPred, RightHash, RightPred, Allocator, GrowthPolicy>& lhs,
+    const dense_bimap<
+        Left, Right, LeftHash, LeftPred, RightHash, RightPred, Allocator, GrowthPolicy>& rhs)
+    -> bool
+{
+    return !(lhs == rhs);
+}
+
+namespace pmr
+{
+    template <
+        class Left, class Right, class LeftHash = std::hash<Left>,
+        class LeftPred = std::equal_to<Left>, class RightHash = std::hash<Right>,
+        class RightPred = std::equal_to<Right>,
+        class GrowthPolicy = details::power_of_two_growth_policy>
+    using dense_bimap = dense_bimap<
+        Left, Right, LeftHash, LeftPred, RightHash, RightPred,
+        std::pmr::polymorphic_allocator<std::pair<const Left, Right>>, GrowthPolicy>;
+} // namespace pmr
+
+} // namespace jg
+
+namespace std
+{
+template <class Left, class Right, class Allocator>
+struct uses_allocator<jg::details::bimap_node<Left, Right>, Allocator> : true_type
+{
+};
+
+template <
+    class Left, class Right, class LeftHash, class LeftPred, class RightHash, class RightPred,
+    class Allocator, class GrowthPolicy>
+constexpr void swap(
+    jg::dense_bimap<Left, Right, LeftHash, LeftPred, RightHash, RightPred, Allocator, GrowthPolicy>&
+        lhs,
+    jg::dense_bimap<Left, Right, LeftHash, LeftPred, RightHash, RightPred, Allocator, GrowthPolicy>&
+        rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+    lhs.swap(rhs);
+}
+
+template <
+    class Left, class Right, class LeftHash, class LeftPred, class RightHash, class RightPred,
+    class Allocator, class GrowthPolicy, class Predicate>
+constexpr auto erase_if(
+    jg::dense_bimap<Left, Right, LeftHash, LeftPred, RightHash, RightPred, Allocator, GrowthPolicy>&
+        c,
+    Predicate pred) ->
+    typename jg::dense_bimap<
+        Left, Right, LeftHash, LeftPred, RightHash, RightPred, Allocator, GrowthPolicy>::size_type
+{
+    return c.erase_if(std::move(pred));
+}
+
+} // namespace std
+
+#endif // JG_DENSE_BIMAP_HPP
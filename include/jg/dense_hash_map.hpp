@@ -3,11 +3,23 @@
 
 #include "details/bucket_iterator.hpp"
 #include "details/dense_hash_map_iterator.hpp"
+#include "details/doubly_linked_storage_policy.hpp"
+#include "details/handle_storage_policy.hpp"
+#include "details/modulo_growth_policy.hpp"
+#include "details/move_to_front_storage_policy.hpp"
 #include "details/node.hpp"
+#include "details/node_handle.hpp"
+#include "details/ordered_storage_policy.hpp"
+#include "details/out_of_line_storage_policy.hpp"
 #include "details/power_of_two_growth_policy.hpp"
+#include "details/segmented_storage_policy.hpp"
+#include "details/single_block_storage_policy.hpp"
+#include "details/split_storage.hpp"
 #include "details/type_traits.hpp"
+#include "details/vector_storage_policy.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <functional>
@@ -24,6 +36,29 @@ namespace details
 {
     static constexpr const float default_max_load_factor = 0.875f;
 
+    // clear(keep_capacity) resets the buckets in use one by one, instead of filling all of them,
+    // when there are more than that many buckets per entry.
+    static constexpr const std::size_t sparse_clear_ratio = 16u;
+
+    // Range erase compacts the nodes and rebuilds the buckets in one pass, rather than erasing the
+    // entries one by one, when erasing at least one entry out of that many.
+    static constexpr const std::size_t bulk_erase_ratio = 3u;
+
+    // Number of consecutive nodes handled by one task of the parallel algorithms.
+    static constexpr const std::size_t parallel_chunk_size = 1u << 14;
+
+    // How many keys ahead find_batch() prefetches, and the size under which the map is expected
+    // to fit in the caches, where prefetching only adds overhead.
+    static constexpr const std::size_t probe_batch_size = 16u;
+    static constexpr const std::size_t probe_prefetch_min_size = 1u << 14;
+
+    inline void prefetch([[maybe_unused]] const void* address) noexcept
+    {
+#ifdef __GNUC__
+        __builtin_prefetch(address);
+#endif
+    }
+
     template <
         class Key, class T, class Container, bool isConst, bool projectToConstKey, class Nodes>
     [[nodiscard]] constexpr auto bucket_iterator_to_iterator(
@@ -33,12 +68,12 @@ namespace details
         if (bucket_it.current_node_index() == details::node_end_index<Key, T>)
         {
             return dense_hash_map_iterator<Key, T, Container, isConst, projectToConstKey>{
-                nodes.end()};
+                nodes.end(), nodes.end()};
         }
         else
         {
             return dense_hash_map_iterator<Key, T, Container, isConst, projectToConstKey>{
-                std::next(nodes.begin(), bucket_it.current_node_index())};
+                std::next(nodes.begin(), bucket_it.current_node_index()), nodes.end()};
         }
     }
 
@@ -58,6 +93,19 @@ namespace details
     template <class Pred>
     inline constexpr bool is_transparent_v = is_detected<detect_is_transparent, Pred>::value;
 
+    // Heterogeneous lookup is enabled either by a Hash::transparent_key_equal type or, as in C++20,
+    // by an is_transparent tag on both the hasher and the key equal.
+    template <class Hash, class Pred>
+    inline constexpr bool is_transparent_lookup_v =
+        is_transparent_key_equal_v<Hash> || (is_transparent_v<Hash> && is_transparent_v<Pred>);
+
+    // The keys taken by the heterogeneous insertion and erase members. key_type has overloads of
+    // its own, and whatever converts to an iterator is a position, not a key.
+    template <class K, class Key, class Iterator, class ConstIterator>
+    inline constexpr bool is_heterogeneous_key_v =
+        !std::is_same_v<std::remove_cv_t<std::remove_reference_t<K>>, Key> &&
+        !std::is_convertible_v<K, Iterator> && !std::is_convertible_v<K, ConstIterator>;
+
     template <class Hash, class Pred, class Key, bool = is_transparent_key_equal_v<Hash>>
     struct key_equal
     {
@@ -78,6 +126,149 @@ namespace details
             "std::equal_to<Key>");
     };
 
+    template <class Policy, class Key, class T, class Allocator>
+    using detect_storage_node = typename Policy::template node<Key, T, Allocator>;
+
+    template <class Policy, class Key, class T, class Allocator>
+    using storage_node_t = typename detected_or<
+        node<Key, T>, detect_storage_node, Policy, Key, T, Allocator>::type;
+
+    // Storage policies either provide the nodes_ and buckets_ containers, stored side by side, or
+    // a whole storage type owning both.
+    template <class Policy, class Node, class Allocator, class = void>
+    struct storage_selector
+    {
+        using nodes_container_type =
+            typename Policy::template nodes_container<Node, rebind_alloc<Allocator, Node>>;
+        using index_type = typename nodes_container_type::size_type;
+        using buckets_container_type = typename Policy::template buckets_container<
+            index_type, rebind_alloc<Allocator, index_type>>;
+        using type = split_storage<nodes_container_type, buckets_container_type>;
+    };
+
+    template <class Policy, class Node, class Allocator>
+    struct storage_selector<
+        Policy, Node, Allocator, std::void_t<typename Policy::template storage<Node, Allocator>>>
+    {
+        using type = typename Policy::template storage<Node, Allocator>;
+    };
+
+    template <class Policy, class Node, class Allocator>
+    using storage_t = typename storage_selector<Policy, Node, Allocator>::type;
+
+    template <class Policy>
+    using detect_linear_scan_capacity = decltype(Policy::linear_scan_capacity);
+
+    // Maximum number of entries a map keeps without buckets, looked up by a linear scan. 0 unless
+    // the storage policy opts in.
+    template <class Policy>
+    constexpr auto linear_scan_capacity() -> std::size_t
+    {
+        if constexpr (is_detected<detect_linear_scan_capacity, Policy>::value)
+        {
+            return Policy::linear_scan_capacity;
+        }
+        else
+        {
+            return 0u;
+        }
+    }
+
+    template <class Policy>
+    using detect_move_to_front_on_hit = decltype(Policy::move_to_front_on_hit);
+
+    template <class Policy>
+    constexpr auto move_to_front_on_hit() -> bool
+    {
+        if constexpr (is_detected<detect_move_to_front_on_hit, Policy>::value)
+        {
+            return Policy::move_to_front_on_hit;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    template <class Policy>
+    using detect_grow_bucket_count = decltype(Policy::grow_bucket_count(std::size_t{}));
+
+    template <class Policy>
+    using detect_grow_node_capacity = decltype(Policy::grow_node_capacity(std::size_t{}));
+
+    template <class Policy>
+    using detect_default_max_load_factor = decltype(Policy::default_max_load_factor);
+
+    // The growth policy decides how far buckets_ grows, which defaults to doubling.
+    template <class Policy>
+    constexpr auto grow_bucket_count(std::size_t bucket_count) -> std::size_t
+    {
+        if constexpr (is_detected<detect_grow_bucket_count, Policy>::value)
+        {
+            return Policy::grow_bucket_count(bucket_count);
+        }
+        else
+        {
+            return bucket_count * 2;
+        }
+    }
+
+    // Without grow_node_capacity, nodes_ grows the way its container does.
+    template <class Policy>
+    inline constexpr bool has_node_growth_v = is_detected<detect_grow_node_capacity, Policy>::value;
+
+    template <class Policy>
+    constexpr auto policy_max_load_factor() -> float
+    {
+        if constexpr (is_detected<detect_default_max_load_factor, Policy>::value)
+        {
+            return Policy::default_max_load_factor;
+        }
+        else
+        {
+            return default_max_load_factor;
+        }
+    }
+
+    template <class Node>
+    using detect_cached_hash = decltype(std::declval<Node&>().hash);
+
+    template <class Node>
+    inline constexpr bool has_cached_hash_v = is_detected<detect_cached_hash, Node>::value;
+
+    // The number of tombstones of a map whose nodes can be tombstones, nothing for the others.
+    template <bool hasTombstones>
+    struct tombstone_counter
+    {
+        constexpr tombstone_counter() = default;
+        constexpr tombstone_counter(const tombstone_counter&) = default;
+
+        constexpr tombstone_counter(tombstone_counter&& other) noexcept
+            : tombstone_count(std::exchange(other.tombstone_count, 0u))
+        {}
+
+        constexpr auto operator=(const tombstone_counter&) -> tombstone_counter& = default;
+
+        constexpr auto operator=(tombstone_counter&& other) noexcept -> tombstone_counter&
+        {
+            tombstone_count = std::exchange(other.tombstone_count, 0u);
+            return *this;
+        }
+
+        std::size_t tombstone_count = 0u;
+    };
+
+    template <>
+    struct tombstone_counter<false>
+    {
+    };
+
+    template <class Node>
+    using detect_prev_link = decltype(std::declval<Node&>().prev);
+
+    template <class Node>
+    inline constexpr bool has_prev_link_v = is_detected<detect_prev_link, Node>::value;
+
     template <class InputIt>
     using iter_key_t =
         std::remove_const_t<typename std::iterator_traits<InputIt>::value_type::first_type>;
@@ -113,19 +304,36 @@ namespace details
 
 } // namespace details
 
+// Tag asking clear() to keep the bucket count and the node capacity of the map.
+struct keep_capacity_t
+{
+    explicit keep_capacity_t() = default;
+};
+
+inline constexpr keep_capacity_t keep_capacity{};
+
 template <
     class Key, class T, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>,
     class Allocator = std::allocator<std::pair<const Key, T>>,
-    class GrowthPolicy = details::power_of_two_growth_policy>
-class dense_hash_map : private GrowthPolicy
+    class GrowthPolicy = details::power_of_two_growth_policy,
+    class StoragePolicy = details::vector_storage_policy>
+class dense_hash_map
+    : private GrowthPolicy
+    , private details::tombstone_counter<details::has_tombstones_v<
+          details::storage_node_t<StoragePolicy, Key, T, Allocator>>>
+    , private details::handle_table<
+          Allocator,
+          details::has_handle_slot_v<details::storage_node_t<StoragePolicy, Key, T, Allocator>>>
 {
 private:
-    using node_type = details::node<Key, T>;
-    using nodes_container_type =
-        std::vector<node_type, details::rebind_alloc<Allocator, node_type>>;
+    template <class, class, class, class, class, class, class>
+    friend class dense_hash_map;
+
+    using storage_node_type = details::storage_node_t<StoragePolicy, Key, T, Allocator>;
+    using storage_type = details::storage_t<StoragePolicy, storage_node_type, Allocator>;
+    using nodes_container_type = typename storage_type::nodes_container_type;
     using nodes_size_type = typename nodes_container_type::size_type;
-    using buckets_container_type =
-        std::vector<nodes_size_type, details::rebind_alloc<Allocator, nodes_size_type>>;
+    using buckets_container_type = typename storage_type::buckets_container_type;
     using node_index_type = details::node_index_t<Key, T>;
     using GrowthPolicy::compute_closest_capacity;
     using GrowthPolicy::compute_index;
@@ -133,27 +341,38 @@ private:
     using deduced_key_equal = typename details::key_equal<Hash, Pred, Key>::type;
 
     static inline constexpr node_index_type node_end_index = details::node_end_index<Key, T>;
+    static inline constexpr bool has_cached_hash = details::has_cached_hash_v<storage_node_type>;
+    static inline constexpr bool has_prev_link = details::has_prev_link_v<storage_node_type>;
+    static inline constexpr bool has_tombstones = details::has_tombstones_v<storage_node_type>;
+    static inline constexpr bool has_handles = details::has_handle_slot_v<storage_node_type>;
+    static inline constexpr std::size_t linear_scan_capacity =
+        details::linear_scan_capacity<StoragePolicy>();
+    static inline constexpr bool move_to_front_on_hit =
+        details::move_to_front_on_hit<StoragePolicy>();
+
+    static_assert(
+        !has_tombstones || linear_scan_capacity == 0,
+        "The nodes of a map scanned linearly cannot be tombstones.");
+
+    using tombstone_counter_type = details::tombstone_counter<has_tombstones>;
+    using handle_table_type = details::handle_table<Allocator, has_handles>;
 
     static inline constexpr bool is_nothrow_move_constructible =
         std::allocator_traits<Allocator>::is_always_equal::value &&
         std::is_nothrow_move_constructible_v<Hash> &&
         std::is_nothrow_move_constructible_v<deduced_key_equal> &&
-        std::is_nothrow_move_constructible_v<nodes_container_type> &&
-        std::is_nothrow_move_constructible_v<buckets_container_type>;
+        std::is_nothrow_move_constructible_v<storage_type>;
     static inline constexpr bool is_nothrow_move_assignable =
         std::allocator_traits<Allocator>::is_always_equal::value &&
         std::is_nothrow_move_assignable_v<Hash> &&
         std::is_nothrow_move_assignable_v<deduced_key_equal> &&
-        std::is_nothrow_move_assignable_v<nodes_container_type> &&
-        std::is_nothrow_move_assignable_v<buckets_container_type>;
+        std::is_nothrow_move_assignable_v<storage_type>;
     static inline constexpr bool is_nothrow_swappable =
-        std::is_nothrow_swappable_v<buckets_container_type> &&
-        std::is_nothrow_swappable_v<nodes_container_type> &&
+        std::is_nothrow_swappable_v<storage_type> &&
         std::allocator_traits<Allocator>::is_always_equal::value &&
         std::is_nothrow_swappable_v<Hash> && std::is_nothrow_swappable_v<deduced_key_equal>;
     static inline constexpr bool is_nothrow_default_constructible =
-        std::is_nothrow_default_constructible_v<buckets_container_type> &&
-        std::is_nothrow_default_constructible_v<nodes_container_type> &&
+        std::is_nothrow_default_constructible_v<storage_type> &&
         std::is_nothrow_default_constructible_v<Hash> &&
         std::is_nothrow_default_constructible_v<deduced_key_equal>;
 
@@ -175,15 +394,29 @@ public:
         details::dense_hash_map_iterator<Key, T, nodes_container_type, true, true>;
     using local_iterator = details::bucket_iterator<Key, T, nodes_container_type, false, true>;
     using const_local_iterator = details::bucket_iterator<Key, T, nodes_container_type, true, true>;
+    using node_type = details::node_handle<storage_node_type, Key, T, Allocator>;
+    using insert_return_type = details::insert_return_type<iterator, node_type>;
+    using handle_type = details::entry_handle;
+
+private:
+    template <class K>
+    static constexpr bool is_heterogeneous_key =
+        details::is_transparent_lookup_v<Hash, Pred> &&
+        details::is_heterogeneous_key_v<K, Key, iterator, const_iterator>;
+
+    template <class K>
+    static constexpr bool is_heterogeneous_insert_key =
+        is_heterogeneous_key<K> && std::is_constructible_v<Key, K&&>;
 
+public:
     constexpr dense_hash_map() noexcept(is_nothrow_default_constructible)
-        : dense_hash_map(minimum_capacity())
+        : dense_hash_map(default_bucket_count())
     {}
 
     constexpr explicit dense_hash_map(
         size_type bucket_count, const Hash& hash = Hash(), const key_equal& equal = key_equal(),
         const allocator_type& alloc = allocator_type())
-        : hash_(hash), key_equal_(equal), buckets_(alloc), nodes_(alloc)
+        : handle_table_type(alloc), hash_(hash), key_equal_(equal), storage_(alloc)
     {
         rehash(bucket_count);
     }
@@ -198,12 +431,12 @@ public:
     {}
 
     constexpr explicit dense_hash_map(const allocator_type& alloc)
-        : dense_hash_map(minimum_capacity(), hasher(), key_equal(), alloc)
+        : dense_hash_map(default_bucket_count(), hasher(), key_equal(), alloc)
     {}
 
     template <class InputIt>
     constexpr dense_hash_map(
-        InputIt first, InputIt last, size_type bucket_count = minimum_capacity(),
+        InputIt first, InputIt last, size_type bucket_count = default_bucket_count(),
         const Hash& hash = Hash(), const key_equal& equal = key_equal(),
         const allocator_type& alloc = allocator_type())
         : dense_hash_map(bucket_count, hash, equal, alloc)
@@ -231,24 +464,30 @@ public:
     {}
 
     constexpr dense_hash_map(const dense_hash_map& other, const allocator_type& alloc)
-        : hash_(other.hash_)
+        : tombstone_counter_type(other)
+        , handle_table_type(other, alloc)
+        , hash_(other.hash_)
         , key_equal_(other.key_equal_)
-        , buckets_(other.buckets_, alloc)
-        , nodes_(other.nodes_, alloc)
+        , storage_(other.storage_, alloc)
+        , max_load_factor_(other.max_load_factor_)
+        , min_load_factor_(other.min_load_factor_)
     {}
 
     constexpr dense_hash_map(dense_hash_map&& other) noexcept(is_nothrow_move_constructible) =
         default;
 
     constexpr dense_hash_map(dense_hash_map&& other, const allocator_type& alloc)
-        : hash_(std::move(other.hash_))
+        : tombstone_counter_type(std::move(other))
+        , handle_table_type(std::move(other), alloc)
+        , hash_(std::move(other.hash_))
         , key_equal_(std::move(other.key_equal_))
-        , buckets_(std::move(other.buckets_), alloc)
-        , nodes_(std::move(other.nodes_), alloc)
+        , storage_(std::move(other.storage_), alloc)
+        , max_load_factor_(other.max_load_factor_)
+        , min_load_factor_(other.min_load_factor_)
     {}
 
     constexpr dense_hash_map(
-        std::initializer_list<value_type> init, size_type bucket_count = minimum_capacity(),
+        std::initializer_list<value_type> init, size_type bucket_count = default_bucket_count(),
         const hasher& hash = hasher(), const key_equal& equal = key_equal(),
         const allocator_type& alloc = allocator_type())
         : dense_hash_map(init.begin(), init.end(), bucket_count, hash, equal, alloc)
@@ -268,11 +507,11 @@ public:
     // 2 missing constructors from https://cplusplus.github.io/LWG/issue2713
     template <class InputIterator>
     dense_hash_map(InputIterator first, InputIterator last, const allocator_type& alloc)
-        : dense_hash_map(first, last, minimum_capacity(), hasher(), key_equal(), alloc)
+        : dense_hash_map(first, last, default_bucket_count(), hasher(), key_equal(), alloc)
     {}
 
     dense_hash_map(std::initializer_list<value_type> init, const allocator_type& alloc)
-        : dense_hash_map(init, minimum_capacity(), hasher(), key_equal(), alloc)
+        : dense_hash_map(init, default_bucket_count(), hasher(), key_equal(), alloc)
     {}
 
     ~dense_hash_map() = default;
@@ -288,37 +527,78 @@ public:
         return *this;
     }
 
-    constexpr auto get_allocator() const -> allocator_type { return buckets_.get_allocator(); }
+    constexpr auto get_allocator() const -> allocator_type { return storage_.get_allocator(); }
+
+    constexpr auto begin() noexcept -> iterator { return node_iterator(0); }
+
+    constexpr auto begin() const noexcept -> const_iterator { return node_position(0u); }
+
+    constexpr auto cbegin() const noexcept -> const_iterator { return node_position(0u); }
 
-    constexpr auto begin() noexcept -> iterator { return iterator{nodes_.begin()}; }
+    constexpr auto end() noexcept -> iterator { return iterator{nodes().end(), nodes().end()}; }
 
-    constexpr auto begin() const noexcept -> const_iterator
+    constexpr auto end() const noexcept -> const_iterator
     {
-        return const_iterator{nodes_.begin()};
+        return const_iterator{nodes().end(), nodes().end()};
     }
 
-    constexpr auto cbegin() const noexcept -> const_iterator
+    constexpr auto cend() const noexcept -> const_iterator
     {
-        return const_iterator{nodes_.cbegin()};
+        return const_iterator{nodes().cend(), nodes().cend()};
     }
 
-    constexpr auto end() noexcept -> iterator { return iterator{nodes_.end()}; }
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return size() == 0u; }
 
-    constexpr auto end() const noexcept -> const_iterator { return const_iterator{nodes_.end()}; }
+    constexpr auto size() const noexcept -> size_type { return nodes().size() - tombstones(); }
 
-    constexpr auto cend() const noexcept -> const_iterator { return const_iterator{nodes_.cend()}; }
+    constexpr auto max_size() const noexcept -> size_type { return nodes().max_size(); }
 
-    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return nodes_.empty(); }
+    constexpr void clear() noexcept
+    {
+        reset_tombstones();
+        release_handles();
+        nodes().clear();
+        buckets().clear();
+        rehash(0u);
+    }
 
-    constexpr auto size() const noexcept -> size_type { return nodes_.size(); }
+    // Empties the map without giving back any memory, for maps refilled over and over. When the map
+    // is sparse, only the buckets in use are reset, found by walking the nodes.
+    constexpr void clear(keep_capacity_t) noexcept
+    {
+        if (size() * details::sparse_clear_ratio < bucket_count())
+        {
+            for (const auto& node : nodes())
+            {
+                if constexpr (has_tombstones)
+                {
+                    if (node.is_tombstone())
+                    {
+                        continue;
+                    }
+                }
+
+                buckets()[compute_index(node_hash(node), bucket_count())] = node_end_index;
+            }
+        }
+        else
+        {
+            std::fill(buckets().begin(), buckets().end(), node_end_index);
+        }
 
-    constexpr auto max_size() const noexcept -> size_type { return nodes_.max_size(); }
+        reset_tombstones();
+        release_handles();
+        nodes().clear();
+    }
 
-    constexpr void clear() noexcept
+    // Shrinks the buckets to the smallest count fitting size() and gives back the unused memory,
+    // compacting the nodes of an ordered map first.
+    constexpr void shrink_to_fit()
     {
-        nodes_.clear();
-        buckets_.clear();
+        drop_tombstones();
         rehash(0u);
+        buckets().shrink_to_fit();
+        nodes().shrink_to_fit();
     }
 
     constexpr auto insert(const value_type& value) -> std::pair<iterator, bool>
@@ -367,6 +647,170 @@ public:
         insert(ilist.begin(), ilist.end());
     }
 
+    // Inserts the node extracted from another map without moving the pair out of it. If the key is
+    // already present, the node is handed back in the result.
+    auto insert(node_type&& nh) -> insert_return_type
+    {
+        if (nh.empty())
+        {
+            return {end(), false, node_type{}};
+        }
+
+        assert(get_allocator() == nh.get_allocator() && "The node handle allocator must be equal.");
+
+        const auto hash = hash_(nh.key());
+        const auto index =
+            is_linear() ? scan_nodes(nh.key(), hash) : find_node_index(nh.key(), hash);
+
+        if (index != node_end_index)
+        {
+            return {node_iterator(index), false, std::move(nh)};
+        }
+
+        check_for_rehash();
+        adopt_node(nh.release(), hash);
+
+        return {std::prev(end()), true, node_type{}};
+    }
+
+    auto insert(const_iterator /*hint*/, node_type&& nh) -> iterator
+    {
+        return insert(std::move(nh)).position;
+    }
+
+    auto extract(const_iterator position) -> node_type
+    {
+        const auto index = position_of(position);
+        const auto it = std::next(nodes().begin(), index);
+
+        if (is_linear())
+        {
+            node_type nh{std::move(*it), get_allocator()};
+            do_erase_unchained(it);
+            shrink_if_sparse();
+            return nh;
+        }
+
+        // Find what links to the node while its key can still be hashed.
+        std::size_t* previous_next = nullptr;
+
+        if constexpr (has_prev_link)
+        {
+            previous_next = &link_to(*it);
+        }
+        else
+        {
+            previous_next = find_previous_next_using_position(*it, index);
+        }
+
+        node_type nh{std::move(*it), get_allocator()};
+
+        if constexpr (has_tombstones)
+        {
+            bury_node(previous_next, it);
+            shrink_if_sparse();
+            settle(index);
+            return nh;
+        }
+
+        do_erase(previous_next, it);
+        shrink_if_sparse();
+
+        return nh;
+    }
+
+    auto extract(const key_type& key) -> node_type
+    {
+        const auto index = find_node_index(key);
+
+        if (index == node_end_index)
+        {
+            return node_type{};
+        }
+
+        return extract(node_position(index));
+    }
+
+    // Moves the nodes of source whose key is not in this map, leaving the others in source. The
+    // nodes are moved as a whole and linked in without rehashing their keys when they cache a hash
+    // computed by the same stateless hasher. Reserves once for all the nodes of source, and
+    // compacts source in a single pass.
+    template <class Hash2, class Pred2, class GrowthPolicy2>
+    void
+    merge(dense_hash_map<Key, T, Hash2, Pred2, Allocator, GrowthPolicy2, StoragePolicy>& source)
+    {
+        if (static_cast<const void*>(&source) == static_cast<const void*>(this) || source.empty())
+        {
+            return;
+        }
+
+        assert(get_allocator() == source.get_allocator() && "The allocators must be equal.");
+
+        source.drop_tombstones();
+
+        constexpr bool reuse_hashes =
+            has_cached_hash && std::is_same_v<Hash, Hash2> && std::is_empty_v<Hash>;
+
+        reserve(size() + source.size());
+
+        using flags_allocator_type = details::rebind_alloc<Allocator, unsigned char>;
+        std::vector<unsigned char, flags_allocator_type> moved(
+            source.size(), flags_allocator_type(get_allocator()));
+        difference_type position = 0;
+        auto erase_moved = [&](difference_type i, auto) {
+            return i < position && moved[static_cast<size_type>(i)] != 0u;
+        };
+
+#ifndef JG_NO_EXCEPTION
+        try
+        {
+#endif
+            for (auto& node : source.nodes())
+            {
+                const auto& key = node_key(node);
+                std::size_t hash = 0;
+
+                if constexpr (reuse_hashes)
+                {
+                    hash = node.hash;
+                }
+                else
+                {
+                    hash = hash_(key);
+                }
+
+                const auto index = is_linear() ? scan_nodes(key, hash) : find_node_index(key, hash);
+
+                if (index == node_end_index)
+                {
+                    adopt_node(std::move(node), hash);
+                    moved[static_cast<size_type>(position)] = 1u;
+                }
+
+                ++position;
+            }
+#ifndef JG_NO_EXCEPTION
+        }
+        catch (...)
+        {
+            source.compact_nodes(erase_moved);
+            source.relink_nodes();
+            throw;
+        }
+#endif
+
+        source.compact_nodes(erase_moved);
+        source.relink_nodes();
+        source.shrink_if_sparse();
+    }
+
+    template <class Hash2, class Pred2, class GrowthPolicy2>
+    void
+    merge(dense_hash_map<Key, T, Hash2, Pred2, Allocator, GrowthPolicy2, StoragePolicy>&& source)
+    {
+        merge(source);
+    }
+
     template <class M>
     constexpr auto insert_or_assign(const key_type& k, M&& obj) -> std::pair<iterator, bool>
     {
@@ -393,6 +837,19 @@ public:
         return result;
     }
 
+    template <class K, class M, class Useless = std::enable_if_t<is_heterogeneous_insert_key<K>, K>>
+    constexpr auto insert_or_assign(K&& k, M&& obj) -> std::pair<iterator, bool>
+    {
+        auto result = try_emplace(std::forward<K>(k), std::forward<M>(obj));
+
+        if (!result.second)
+        {
+            result.first->second = std::forward<M>(obj);
+        }
+
+        return result;
+    }
+
     template <class M>
     constexpr auto insert_or_assign(const_iterator /*hint*/, const key_type& k, M&& obj) -> iterator
     {
@@ -437,106 +894,257 @@ public:
     constexpr auto try_emplace(const_iterator /*hint*/, const key_type& key, Args&&... args)
         -> iterator
     {
-        return try_emplace(key, std::forward<Args>(args)...).iterator;
+        return try_emplace(key, std::forward<Args>(args)...).first;
     }
 
     template <class... Args>
     constexpr auto try_emplace(const_iterator /*hint*/, key_type&& key, Args&&... args) -> iterator
     {
-        return try_emplace(std::move(key), std::forward<Args>(args)...).iterator;
+        return try_emplace(std::move(key), std::forward<Args>(args)...).first;
     }
 
-    constexpr auto erase(const_iterator pos) -> iterator
+    // Heterogeneous try_emplace(): key_type is only constructed from key if a node is inserted.
+    template <
+        class K, class... Args, class Useless = std::enable_if_t<is_heterogeneous_insert_key<K>, K>>
+    constexpr auto try_emplace(K&& key, Args&&... args) -> std::pair<iterator, bool>
     {
-        const auto position = std::distance(cbegin(), pos);
-        const auto it = std::next(begin(), position);
-        const auto previous_next = find_previous_next_using_position(pos->first, position);
-        return do_erase(previous_next, it.sub_iterator()).first;
+        return do_emplace(
+            key, std::piecewise_construct, std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
     }
 
-    constexpr auto erase(const_iterator first, const_iterator last) -> iterator
+    template <
+        class K, class... Args, class Useless = std::enable_if_t<is_heterogeneous_insert_key<K>, K>>
+    constexpr auto try_emplace(const_iterator /*hint*/, K&& key, Args&&... args) -> iterator
     {
-        bool stop = first == last;
-        while (!stop)
-        {
-            --last;
-            stop = first == last; // if first == last, erase would invalidate both!
-            last = erase(last);
-        }
+        return try_emplace(std::forward<K>(key), std::forward<Args>(args)...).first;
+    }
 
-        const auto position = std::distance(cbegin(), last);
-        return std::next(begin(), position);
+    // Hashes key and probes for it once. If it is absent, inserts it with a mapped value built from
+    // args, otherwise calls visit(entry) on the entry found. Only an insertion can grow the map.
+    template <class Visit, class... Args>
+    constexpr auto try_emplace_or_visit(const key_type& key, Visit&& visit, Args&&... args)
+        -> std::pair<iterator, bool>
+    {
+        return do_emplace_or_visit(
+            key, std::forward<Visit>(visit), std::piecewise_construct, std::forward_as_tuple(key),
+            std::forward_as_tuple(std::forward<Args>(args)...));
     }
 
-    constexpr auto erase(const key_type& key) -> size_type
+    template <class Visit, class... Args>
+    constexpr auto try_emplace_or_visit(key_type&& key, Visit&& visit, Args&&... args)
+        -> std::pair<iterator, bool>
     {
-        // We have to find out the node we look for and the pointer to it.
-        const auto bindex = bucket_index(key);
+        return do_emplace_or_visit(
+            key, std::forward<Visit>(visit), std::piecewise_construct,
+            std::forward_as_tuple(std::move(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
 
-        std::size_t* previous_next = &buckets_[bindex];
+    template <
+        class K, class Visit, class... Args,
+        class Useless = std::enable_if_t<is_heterogeneous_insert_key<K>, K>>
+    constexpr auto try_emplace_or_visit(K&& key, Visit&& visit, Args&&... args)
+        -> std::pair<iterator, bool>
+    {
+        return do_emplace_or_visit(
+            key, std::forward<Visit>(visit), std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+    }
 
-        for (;;)
+    // Like try_emplace_or_visit(), the mapped value of a new entry being the result of make() and
+    // update(mapped) being called on the mapped value of an existing one. make() is only called
+    // when key is inserted.
+    template <class Make, class Update>
+    constexpr auto upsert(const key_type& key, Make&& make, Update&& update)
+        -> std::pair<iterator, bool>
+    {
+        return do_upsert(key, key, std::forward<Make>(make), std::forward<Update>(update));
+    }
+
+    template <class Make, class Update>
+    constexpr auto upsert(key_type&& key, Make&& make, Update&& update) -> std::pair<iterator, bool>
+    {
+        return do_upsert(
+            key, std::move(key), std::forward<Make>(make), std::forward<Update>(update));
+    }
+
+    template <
+        class K, class Make, class Update,
+        class Useless = std::enable_if_t<is_heterogeneous_insert_key<K>, K>>
+    constexpr auto upsert(K&& key, Make&& make, Update&& update) -> std::pair<iterator, bool>
+    {
+        return do_upsert(
+            key, std::forward<K>(key), std::forward<Make>(make), std::forward<Update>(update));
+    }
+
+    constexpr auto erase(const_iterator pos) -> iterator
+    {
+        const auto position = position_of(pos);
+        erase_at(position);
+        shrink_if_sparse();
+
+        if constexpr (has_tombstones)
         {
-            if (*previous_next == node_end_index)
-            {
-                return 0;
-            }
+            return settle(position + 1);
+        }
+        else
+        {
+            return node_iterator(position);
+        }
+    }
 
-            auto& node = nodes_[*previous_next];
+    constexpr auto erase(const_iterator first, const_iterator last) -> iterator
+    {
+        // Positions rather than iterators: a shrink would invalidate the latter.
+        const auto first_position = position_of(first);
+        auto last_position = position_of(last);
 
-            if (key_equal_(node.pair.pair().first, key))
+        if constexpr (has_tombstones)
+        {
+            for (auto position = first_position; position != last_position; ++position)
             {
-                break;
+                if (!nodes()[static_cast<size_type>(position)].is_tombstone())
+                {
+                    erase_at(position);
+                }
             }
 
-            previous_next = &node.next;
+            shrink_if_sparse();
+            return settle(last_position);
         }
 
-        do_erase(previous_next, std::next(nodes_.begin(), *previous_next));
+        // Nodes linked both ways are erased in O(1) without hashing: one by one is always cheaper.
+        if (!has_prev_link &&
+            static_cast<size_type>(last_position - first_position) * details::bulk_erase_ratio >=
+                size())
+        {
+            compact_nodes([&](difference_type position, auto) {
+                return position >= first_position && position < last_position;
+            });
+            relink_nodes();
+            shrink_if_sparse();
+            return node_iterator(first_position);
+        }
 
-        return 1;
+        while (last_position != first_position)
+        {
+            erase_at(--last_position);
+        }
+
+        shrink_if_sparse();
+        return node_iterator(first_position);
     }
 
-    constexpr void swap(dense_hash_map& other) noexcept(is_nothrow_swappable)
+    constexpr auto erase(const key_type& key) -> size_type { return erase_key(key); }
+
+    template <class K, class Useless = std::enable_if_t<is_heterogeneous_key<K>, K>>
+    constexpr auto erase(const K& key) -> size_type
     {
-        using std::swap;
-        swap(buckets_, other.buckets_);
-        swap(nodes_, other.nodes_);
-        swap(max_load_factor_, other.max_load_factor_);
-        swap(hash_, other.hash_);
-        swap(key_equal_, other.key_equal_);
+        return erase_key(key);
     }
 
-    constexpr auto at(const key_type& key) -> T&
+    // Erases every entry satisfying pred in a single pass: the remaining nodes are compacted,
+    // keeping their order, then the buckets are rebuilt once. Returns the number of erased entries.
+    template <class Predicate>
+    constexpr auto erase_if(Predicate pred) -> size_type
     {
-        const auto it = find(key);
+        drop_tombstones();
+        const auto old_size = size();
+        compact_nodes([&](difference_type, auto it) { return pred(*iterator{it, nodes().end()}); });
 
-        if (it == end())
+        if (size() != old_size)
         {
-#ifdef JG_NO_EXCEPTION
-            std::abort();
-#else
-            throw std::out_of_range("The specified key does not exists in this map.");
-#endif
+            relink_nodes();
+            shrink_if_sparse();
         }
 
-        return it->second;
+        return old_size - size();
     }
 
-    constexpr auto at(const key_type& key) const -> const T&
+    // Same as erase_if(pred), evaluating pred and rehashing the remaining keys in parallel.
+    // executor(n, f) must call f(i) once for every i in [0, n), possibly concurrently, and return
+    // once all the calls are done. pred and the hasher must be safe to call concurrently.
+    template <class Executor, class Predicate>
+    auto erase_if(Executor&& executor, Predicate pred) -> size_type
     {
-        const auto it = find(key);
+        drop_tombstones();
+        const auto old_size = size();
+        std::vector<unsigned char> erased(old_size);
 
-        if (it == end())
-        {
-#ifdef JG_NO_EXCEPTION
-            std::abort();
-#else
-            throw std::out_of_range("The specified key does not exists in this map.");
-#endif
-        }
+        for_each_chunk(executor, [&](size_type first, size_type last) {
+            auto it = std::next(nodes().begin(), static_cast<difference_type>(first));
 
-        return it->second;
+            for (auto i = first; i < last; ++i, ++it)
+            {
+                erased[i] = pred(*iterator{it, nodes().end()}) ? 1u : 0u;
+            }
+        });
+
+        compact_nodes([&](difference_type position, auto) { return erased[position] != 0u; });
+
+        if (size() == old_size)
+        {
+            return 0u;
+        }
+
+        if (!is_linear())
+        {
+            std::vector<size_type> bucket_indices(size());
+
+            for_each_chunk(executor, [&](size_type first, size_type last) {
+                auto it = std::next(nodes().begin(), static_cast<difference_type>(first));
+
+                for (auto i = first; i < last; ++i, ++it)
+                {
+                    bucket_indices[i] = compute_index(node_hash(*it), bucket_count());
+                }
+            });
+
+            std::fill(buckets().begin(), buckets().end(), node_end_index);
+            node_index_type index{0u};
+
+            for (auto& entry : nodes())
+            {
+                link_at_head(entry, index, bucket_indices[index]);
+                index++;
+            }
+        }
+
+        shrink_if_sparse();
+        return old_size - size();
+    }
+
+    constexpr void swap(dense_hash_map& other) noexcept(is_nothrow_swappable)
+    {
+        using std::swap;
+        swap(storage_, other.storage_);
+        swap(static_cast<tombstone_counter_type&>(*this),
+             static_cast<tombstone_counter_type&>(other));
+        handle_table_type::swap(other);
+        swap(max_load_factor_, other.max_load_factor_);
+        swap(min_load_factor_, other.min_load_factor_);
+        swap(hash_, other.hash_);
+        swap(key_equal_, other.key_equal_);
+    }
+
+    constexpr auto at(const key_type& key) -> T& { return do_at(*this, key); }
+
+    constexpr auto at(const key_type& key) const -> const T& { return do_at(*this, key); }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto at(const K& key) -> T&
+    {
+        return do_at(*this, key);
+    }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto at(const K& key) const -> const T&
+    {
+        return do_at(*this, key);
     }
 
     constexpr auto operator[](const key_type& key) -> T&
@@ -549,13 +1157,19 @@ public:
         return this->try_emplace(std::move(key)).first->second;
     }
 
+    template <class K, class Useless = std::enable_if_t<is_heterogeneous_insert_key<K>, K>>
+    constexpr auto operator[](K&& key) -> T&
+    {
+        return this->try_emplace(std::forward<K>(key)).first->second;
+    }
+
     constexpr auto count(const key_type& key) const -> size_type
     {
         return find(key) == end() ? 0u : 1u;
     }
 
     template <
-        class K, class Useless = std::enable_if_t<details::is_transparent_key_equal_v<Hash>, K>>
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
     constexpr auto count(const K& key) const -> size_type
     {
         return find(key) == end() ? 0u : 1u;
@@ -563,37 +1177,60 @@ public:
 
     constexpr auto find(const key_type& key) -> iterator
     {
-        return details::bucket_iterator_to_iterator(find_in_bucket(key, bucket_index(key)), nodes_);
+        return details::bucket_iterator_to_iterator(find_in_bucket(key), nodes());
     }
 
     constexpr auto find(const key_type& key) const -> const_iterator
     {
-        return details::bucket_iterator_to_iterator(find_in_bucket(key, bucket_index(key)), nodes_);
+        return details::bucket_iterator_to_iterator(find_in_bucket(key), nodes());
     }
 
     template <
-        class K, class Useless = std::enable_if_t<details::is_transparent_key_equal_v<Hash>, K>>
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
     constexpr auto find(const K& key) -> iterator
     {
-        return details::bucket_iterator_to_iterator(find_in_bucket(key, bucket_index(key)), nodes_);
+        return details::bucket_iterator_to_iterator(find_in_bucket(key), nodes());
     }
 
     template <
-        class K, class Useless = std::enable_if_t<details::is_transparent_key_equal_v<Hash>, K>>
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
     constexpr auto find(const K& key) const -> const_iterator
     {
-        return details::bucket_iterator_to_iterator(find_in_bucket(key, bucket_index(key)), nodes_);
+        return details::bucket_iterator_to_iterator(find_in_bucket(key), nodes());
     }
 
     constexpr auto contains(const key_type& key) const -> bool { return find(key) != end(); }
 
     template <
-        class K, class Useless = std::enable_if_t<details::is_transparent_key_equal_v<Hash>, K>>
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
     constexpr auto contains(const K& key) const -> bool
     {
         return find(key) != end();
     }
 
+    // A handle to the entry at pos, which get() resolves until that entry is erased, whatever
+    // happens to the other entries. Only for the maps with the handle_storage_policy.
+    constexpr auto handle_of(const_iterator pos) const noexcept -> handle_type
+    {
+        static_assert(has_handles, "Only the nodes of the handle_storage_policy have handles.");
+        return this->handle_at(pos.sub_iterator()->slot);
+    }
+
+    // The entry of handle, or end() if it was erased: two array loads, no hashing.
+    constexpr auto get(const handle_type& handle) noexcept -> iterator
+    {
+        static_assert(has_handles, "Only the nodes of the handle_storage_policy have handles.");
+        const auto index = this->node_of(handle);
+        return index == handle_table_type::npos ? end() : node_iterator(index);
+    }
+
+    constexpr auto get(const handle_type& handle) const noexcept -> const_iterator
+    {
+        static_assert(has_handles, "Only the nodes of the handle_storage_policy have handles.");
+        const auto index = this->node_of(handle);
+        return index == handle_table_type::npos ? end() : node_position(index);
+    }
+
     constexpr auto equal_range(const Key& key) -> std::pair<iterator, iterator>
     {
         const auto it = find(key);
@@ -619,7 +1256,7 @@ public:
     }
 
     template <
-        class K, class Useless = std::enable_if_t<details::is_transparent_key_equal_v<Hash>, K>>
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
     constexpr auto equal_range(const K& key) -> std::pair<iterator, iterator>
     {
         const auto it = find(key);
@@ -633,7 +1270,7 @@ public:
     }
 
     template <
-        class K, class Useless = std::enable_if_t<details::is_transparent_key_equal_v<Hash>, K>>
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
     constexpr auto equal_range(const K& key) const -> std::pair<const_iterator, const_iterator>
     {
         const auto it = find(key);
@@ -646,120 +1283,769 @@ public:
         return {it, std::next(it)};
     }
 
+    // Looks up the key of every element of [first, last), as given by key_of, and calls
+    // on_result(it, position) in order, position being end() for the absent keys. In large maps,
+    // the buckets and the heads of the chains are prefetched ahead of the keys being compared,
+    // which overlaps the cache misses of many lookups.
+    template <class ForwardIt, class KeyOf, class OnResult>
+    void find_batch(ForwardIt first, ForwardIt last, KeyOf key_of, OnResult on_result) const
+    {
+        if (is_linear() || size() < details::probe_prefetch_min_size)
+        {
+            for (; first != last; ++first)
+            {
+                const auto index = find_node_index(key_of(*first));
+                on_result(first, index == node_end_index ? cend() : node_position(index));
+            }
+
+            return;
+        }
+
+        // A software pipeline: the bucket of a key is prefetched distance keys ahead of reading it,
+        // and the head of its chain distance keys ahead of comparing it.
+        constexpr std::size_t distance = details::probe_batch_size;
+        constexpr std::size_t mask = 4 * distance - 1;
+        std::array<ForwardIt, mask + 1> its;
+        std::array<std::size_t, mask + 1> hashes;
+        std::array<node_index_type, mask + 1> indices;
+        std::size_t issued = 0;
+        std::size_t linked = 0;
+        std::size_t resolved = 0;
+
+        const auto issue = [&] {
+            const auto slot = issued++ & mask;
+            its[slot] = first;
+            hashes[slot] = hash_(key_of(*first));
+            indices[slot] = compute_index(hashes[slot], bucket_count());
+            details::prefetch(&buckets()[indices[slot]]);
+            ++first;
+        };
+
+        const auto link = [&] {
+            auto& index = indices[linked++ & mask];
+            index = buckets()[index];
+
+            if (index != node_end_index)
+            {
+                details::prefetch(&nodes()[index]);
+            }
+        };
+
+        const auto resolve = [&] {
+            const auto slot = resolved++ & mask;
+            const auto& key = key_of(*its[slot]);
+            auto index = indices[slot];
+
+            while (index != node_end_index && !node_matches(nodes()[index], key, hashes[slot]))
+            {
+                index = nodes()[index].next;
+            }
+
+            on_result(its[slot], index == node_end_index ? cend() : node_position(index));
+        };
+
+        while (first != last)
+        {
+            issue();
+
+            if (issued > distance)
+            {
+                link();
+            }
+
+            if (linked > distance)
+            {
+                resolve();
+            }
+        }
+
+        while (linked < issued)
+        {
+            link();
+        }
+
+        while (resolved < issued)
+        {
+            resolve();
+        }
+    }
+
     constexpr auto begin(size_type n) -> local_iterator
     {
-        return local_iterator{buckets_[n], nodes_};
+        assert(bucket_count() > 0u && "A map scanning its nodes linearly has no buckets.");
+        return local_iterator{buckets()[n], nodes()};
     }
 
     constexpr auto begin(size_type n) const -> const_local_iterator
     {
-        return const_local_iterator{buckets_[n], nodes_};
+        assert(bucket_count() > 0u && "A map scanning its nodes linearly has no buckets.");
+        return const_local_iterator{buckets()[n], nodes()};
     }
 
     constexpr auto cbegin(size_type n) const -> const_local_iterator
     {
-        return const_local_iterator{buckets_[n], nodes_};
+        assert(bucket_count() > 0u && "A map scanning its nodes linearly has no buckets.");
+        return const_local_iterator{buckets()[n], nodes()};
+    }
+
+    constexpr auto end(size_type /*n*/) -> local_iterator
+    {
+        assert(bucket_count() > 0u && "A map scanning its nodes linearly has no buckets.");
+        return local_iterator{nodes()};
+    }
+
+    constexpr auto end(size_type /*n*/) const -> const_local_iterator
+    {
+        assert(bucket_count() > 0u && "A map scanning its nodes linearly has no buckets.");
+        return const_local_iterator{nodes()};
+    }
+
+    constexpr auto cend(size_type /*n*/) const -> const_local_iterator
+    {
+        assert(bucket_count() > 0u && "A map scanning its nodes linearly has no buckets.");
+        return const_local_iterator{nodes()};
+    }
+
+    constexpr auto bucket_count() const -> size_type { return buckets().size(); }
+
+    constexpr auto max_bucket_count() const -> size_type { return buckets().max_size(); }
+
+    constexpr auto bucket_size(size_type n) const -> size_type
+    {
+        return static_cast<size_t>(std::distance(begin(n), end(n)));
+    }
+
+    constexpr auto bucket(const key_type& key) const -> size_type
+    {
+        assert(bucket_count() > 0u && "A map scanning its nodes linearly has no buckets.");
+        return bucket_index(key);
+    }
+
+    // Number of entries compared with key before finding it, 1 for the head of a chain, or 0 when
+    // the key is not in the map.
+    constexpr auto probe_depth(const key_type& key) const -> size_type
+    {
+        if (is_linear())
+        {
+            const auto index = find_node_index(key);
+            return index == node_end_index ? 0u : static_cast<size_type>(index + 1);
+        }
+
+        const auto hash = hash_(key);
+        size_type depth = 0;
+
+        for (auto index = buckets()[compute_index(hash, bucket_count())]; index != node_end_index;
+             index = nodes()[index].next)
+        {
+            ++depth;
+
+            if (node_matches(nodes()[index], key, hash))
+            {
+                return depth;
+            }
+        }
+
+        return 0u;
+    }
+
+    // 0 while the map scans its nodes linearly, without buckets.
+    constexpr auto load_factor() const -> float
+    {
+        if (is_linear())
+        {
+            return 0.0f;
+        }
+
+        return size() / static_cast<float>(bucket_count());
+    }
+
+    constexpr auto max_load_factor() const -> float { return max_load_factor_; }
+
+    constexpr void max_load_factor(float ml)
+    {
+        assert(ml > 0.0f && "The max load factor must be greater than 0.0f.");
+        assert(
+            min_load_factor_ <= ml / 4 &&
+            "The max load factor must be at least 4 times the min load factor.");
+        max_load_factor_ = ml;
+
+        if (!is_linear())
+        {
+            rehash(8);
+        }
+    }
+
+    constexpr auto min_load_factor() const -> float { return min_load_factor_; }
+
+    // Below this load factor, erasing shrinks the buckets and the nodes. The map shrinks to half
+    // its max load factor, leaving as much room to erase as to insert before the next rehash, which
+    // requires the min load factor to be at most a quarter of the max one. 0 disables shrinking.
+    constexpr void min_load_factor(float ml)
+    {
+        assert(ml >= 0.0f && "The min load factor must be positive.");
+        assert(
+            ml <= max_load_factor_ / 4 &&
+            "The min load factor must be at most a quarter of the max load factor.");
+        min_load_factor_ = ml;
+        shrink_if_sparse();
+    }
+
+    constexpr void rehash(size_type count)
+    {
+        if constexpr (linear_scan_capacity > 0)
+        {
+            if (count <= linear_scan_capacity && size() <= linear_scan_capacity)
+            {
+                buckets().clear();
+                return;
+            }
+        }
+
+        rebuild_buckets(count);
+    }
+
+    constexpr void reserve(std::size_t count)
+    {
+        if (is_linear() && count <= linear_scan_capacity)
+        {
+            nodes().reserve(count);
+            return;
+        }
+
+        rehash(std::ceil(count / max_load_factor()));
+        nodes().reserve(count);
+    }
+
+    constexpr auto hash_function() const -> hasher { return hash_; }
+
+    constexpr auto key_eq() const -> key_equal { return key_equal_; }
+
+private:
+    static constexpr auto default_bucket_count() -> size_type
+    {
+        return linear_scan_capacity > 0 ? 0u : minimum_capacity();
+    }
+
+    constexpr void erase_at(difference_type position)
+    {
+        const auto it = std::next(nodes().begin(), position);
+
+        if (is_linear())
+        {
+            do_erase_unchained(it);
+            return;
+        }
+
+        if constexpr (has_tombstones)
+        {
+            bury_node(find_previous_next_using_position(*it, position), it);
+        }
+        else if constexpr (has_prev_link)
+        {
+            do_erase(&link_to(*it), it);
+        }
+        else
+        {
+            do_erase(find_previous_next_using_position(*it, position), it);
+        }
+    }
+
+    constexpr void shrink_if_sparse()
+    {
+        if (bucket_count() > minimum_capacity() && size() < bucket_count() * min_load_factor_)
+        {
+            rehash(static_cast<size_type>(size() / (max_load_factor() / 2)));
+            nodes().shrink_to_fit();
+        }
+    }
+
+    // Whether the map has no buckets and looks up its entries with a linear scan of the nodes.
+    constexpr auto is_linear() const noexcept -> bool
+    {
+        return linear_scan_capacity > 0 && buckets().empty();
     }
 
-    constexpr auto end(size_type /*n*/) -> local_iterator { return local_iterator{nodes_}; }
+    constexpr void rebuild_buckets(size_type count)
+    {
+        count = std::max(minimum_capacity(), count);
+        count = std::max(count, static_cast<size_type>(size() / max_load_factor()));
+
+        count = compute_closest_capacity(count);
+
+        assert(count > 0 && "The computed rehash size must be greater than 0.");
+
+        if (count == buckets().size())
+        {
+            return;
+        }
+
+        buckets().resize(count);
+        relink_nodes();
+    }
+
+    // Rebuilds all the chains from scratch, for the current bucket count.
+    constexpr void relink_nodes()
+    {
+        if (is_linear())
+        {
+            return;
+        }
+
+        std::fill(buckets().begin(), buckets().end(), node_end_index);
+
+        node_index_type index{0u};
+
+        for (auto& entry : nodes())
+        {
+            if constexpr (has_tombstones)
+            {
+                if (entry.is_tombstone())
+                {
+                    index++;
+                    continue;
+                }
+            }
+
+            reinsert_entry(entry, index);
+            index++;
+        }
+    }
+
+    // Moves the nodes for which should_erase(position, it) is false to the front, keeping their
+    // order, and destroys the others. Tombstones are always dropped, without calling should_erase.
+    // Leaves the chains to rebuild. If should_erase throws, the nodes not visited yet are all kept
+    // and the chains are rebuilt.
+    template <class ShouldErase>
+    void compact_nodes(ShouldErase should_erase)
+    {
+        auto write = nodes().begin();
+        auto read = nodes().begin();
+        difference_type position = 0;
+
+#ifndef JG_NO_EXCEPTION
+        try
+        {
+#endif
+            for (; read != nodes().end(); ++read, ++position)
+            {
+                if (is_tombstone(*read))
+                {
+                    continue;
+                }
+
+                if (should_erase(position, read))
+                {
+                    release_handle(*read);
+                    continue;
+                }
+
+                if (write != read)
+                {
+                    *write = std::move(*read);
+                    track_move(write);
+                }
+
+                ++write;
+            }
+#ifndef JG_NO_EXCEPTION
+        }
+        catch (...)
+        {
+            for (; read != nodes().end(); ++read)
+            {
+                if (is_tombstone(*read))
+                {
+                    continue;
+                }
+
+                if (write != read)
+                {
+                    *write = std::move(*read);
+                    track_move(write);
+                }
+
+                ++write;
+            }
+
+            truncate_nodes(std::distance(nodes().begin(), write));
+            reset_tombstones();
+            relink_nodes();
+            throw;
+        }
+#endif
+
+        truncate_nodes(std::distance(nodes().begin(), write));
+        reset_tombstones();
+    }
+
+    // Compacts away the tombstones left by the erasures of an ordered map, then relinks the nodes.
+    constexpr void drop_tombstones()
+    {
+        if (tombstones() > 0u)
+        {
+            compact_nodes([](difference_type, auto) { return false; });
+            relink_nodes();
+        }
+    }
+
+    // After an erasure from an ordered map, given the position following the erased nodes: pops
+    // the trailing tombstones and compacts the nodes once the tombstones outnumber the entries.
+    // Returns the iterator to the first entry from position on, wherever the compaction moved it.
+    auto settle(difference_type position) -> iterator
+    {
+        while (!nodes().empty() && nodes().back().is_tombstone())
+        {
+            nodes().pop_back();
+            --this->tombstone_count;
+        }
+
+        position = std::min(position, static_cast<difference_type>(nodes().size()));
+
+        if (tombstones() > size())
+        {
+            const auto first = nodes().begin();
+            position = std::count_if(first, std::next(first, position), [](const auto& node) {
+                return !node.is_tombstone();
+            });
+            drop_tombstones();
+        }
+
+        return node_iterator(position);
+    }
+
+    // Unlinks the node of an ordered map from its chain and leaves it in place as a tombstone.
+    void bury_node(std::size_t* previous_next, typename nodes_container_type::iterator sub_it)
+    {
+        *previous_next = sub_it->next;
+        sub_it->bury();
+        ++this->tombstone_count;
+    }
+
+    constexpr auto tombstones() const noexcept -> size_type
+    {
+        if constexpr (has_tombstones)
+        {
+            return this->tombstone_count;
+        }
+        else
+        {
+            return 0u;
+        }
+    }
+
+    constexpr void reset_tombstones() noexcept
+    {
+        if constexpr (has_tombstones)
+        {
+            this->tombstone_count = 0u;
+        }
+    }
+
+    static constexpr auto is_tombstone(const storage_node_type& node) noexcept -> bool
+    {
+        if constexpr (has_tombstones)
+        {
+            return node.is_tombstone();
+        }
+        else
+        {
+            (void)node;
+            return false;
+        }
+    }
+
+    // Makes room for the handle of one more node, before the node is appended.
+    constexpr void reserve_handle()
+    {
+        if constexpr (has_handles)
+        {
+            this->prepare_slot();
+        }
+    }
+
+    // Gives a handle to the node just appended, after reserve_handle().
+    constexpr auto claim_handle(storage_node_type& node) noexcept -> storage_node_type&
+    {
+        if constexpr (has_handles)
+        {
+            node.slot = this->claim_slot(nodes().size() - 1);
+        }
+
+        return node;
+    }
+
+    // Points the handle of the node moved to it at its new index.
+    constexpr void track_move(typename nodes_container_type::iterator it) noexcept
+    {
+        if constexpr (has_handles)
+        {
+            this->move_slot(it->slot, static_cast<std::size_t>(std::distance(nodes().begin(), it)));
+        }
+        else
+        {
+            (void)it;
+        }
+    }
+
+    // Makes the handle of a node about to be destroyed stale.
+    constexpr void release_handle(const storage_node_type& node) noexcept
+    {
+        if constexpr (has_handles)
+        {
+            this->release_slot(node.slot);
+        }
+        else
+        {
+            (void)node;
+        }
+    }
+
+    constexpr void release_handles() noexcept
+    {
+        if constexpr (has_handles)
+        {
+            this->release_slots();
+        }
+    }
+
+    template <class Difference>
+    constexpr void truncate_nodes(Difference count)
+    {
+        while (nodes().size() > static_cast<nodes_size_type>(count))
+        {
+            nodes().pop_back();
+        }
+    }
+
+    // Splits [0, size()) into chunks of details::parallel_chunk_size and calls f(first, last) on
+    // each of them through the executor.
+    template <class Executor, class F>
+    void for_each_chunk(Executor& executor, F f) const
+    {
+        const size_type count = size();
+        const size_type chunk_count =
+            (count + details::parallel_chunk_size - 1) / details::parallel_chunk_size;
+
+        executor(chunk_count, [&](size_type chunk) {
+            const size_type first = chunk * details::parallel_chunk_size;
+            f(first, std::min(count, first + details::parallel_chunk_size));
+        });
+    }
+
+    constexpr auto nodes() noexcept -> nodes_container_type& { return storage_.nodes(); }
+
+    // The iterator to the node at index or, if it is a tombstone, to the next entry.
+    template <class Index>
+    constexpr auto node_iterator(Index index) -> iterator
+    {
+        auto it = std::next(nodes().begin(), static_cast<difference_type>(index));
+
+        while (is_tombstone_at(it))
+        {
+            ++it;
+        }
+
+        return iterator{it, nodes().end()};
+    }
+
+    constexpr auto node_position(node_index_type index) const -> const_iterator
+    {
+        auto it = std::next(nodes().begin(), static_cast<difference_type>(index));
+
+        while (is_tombstone_at(it))
+        {
+            ++it;
+        }
+
+        return const_iterator{it, nodes().end()};
+    }
+
+    template <class SubIterator>
+    constexpr auto is_tombstone_at(const SubIterator& it) const noexcept -> bool
+    {
+        return has_tombstones && it != nodes().end() && is_tombstone(*it);
+    }
+
+    // The index of the node pos points to.
+    constexpr auto position_of(const_iterator pos) const noexcept -> difference_type
+    {
+        return std::distance(nodes().begin(), pos.sub_iterator());
+    }
+
+    constexpr auto nodes() const noexcept -> const nodes_container_type&
+    {
+        return storage_.nodes();
+    }
+
+    constexpr auto buckets() noexcept -> buckets_container_type& { return storage_.buckets(); }
+
+    constexpr auto buckets() const noexcept -> const buckets_container_type&
+    {
+        return storage_.buckets();
+    }
+
+    template <class K>
+    constexpr auto bucket_index(const K& key) const -> size_type
+    {
+        return compute_index(hash_(key), buckets().size());
+    }
+
+    // Set nodes project to their key alone, map nodes to their key/value pair.
+    static constexpr auto node_key(const storage_node_type& node) -> const key_type&
+    {
+        if constexpr (details::is_set_v<T>)
+        {
+            return node.pair.const_key_pair();
+        }
+        else
+        {
+            return node.pair.const_key_pair().first;
+        }
+    }
+
+    constexpr auto node_hash(const storage_node_type& node) const -> std::size_t
+    {
+        if constexpr (has_cached_hash)
+        {
+            return node.hash;
+        }
+        else
+        {
+            return hash_(node_key(node));
+        }
+    }
+
+    template <class K>
+    constexpr auto node_matches(
+        const storage_node_type& node, const K& key, [[maybe_unused]] std::size_t hash) const
+        -> bool
+    {
+        if constexpr (has_cached_hash)
+        {
+            // Only dereference the pair when the hashes match.
+            if (node.hash != hash)
+            {
+                return false;
+            }
+        }
 
-    constexpr auto end(size_type /*n*/) const -> const_local_iterator
-    {
-        return const_local_iterator{nodes_};
+        return key_equal_(node_key(node), key);
     }
 
-    constexpr auto cend(size_type /*n*/) const -> const_local_iterator
+    template <class K>
+    constexpr auto find_node_index(const K& key) const -> node_index_type
     {
-        return const_local_iterator{nodes_};
-    }
+        if (is_linear())
+        {
+            [[maybe_unused]] std::size_t hash = 0;
 
-    constexpr auto bucket_count() const -> size_type { return buckets_.size(); }
+            if constexpr (has_cached_hash)
+            {
+                hash = hash_(key);
+            }
 
-    constexpr auto max_bucket_count() const -> size_type { return buckets_.max_size(); }
+            return scan_nodes(key, hash);
+        }
 
-    constexpr auto bucket_size(size_type n) const -> size_type
-    {
-        return static_cast<size_t>(std::distance(begin(n), end(n)));
+        return find_node_index(key, hash_(key));
     }
 
-    constexpr auto bucket(const key_type& key) const -> size_type { return bucket_index(key); }
-
-    constexpr auto load_factor() const -> float
+    template <class K>
+    constexpr auto scan_nodes(const K& key, std::size_t hash) const -> node_index_type
     {
-        return size() / static_cast<float>(bucket_count());
-    }
-
-    constexpr auto max_load_factor() const -> float { return max_load_factor_; }
+        for (node_index_type index = 0; index < nodes().size(); ++index)
+        {
+            if (node_matches(nodes()[index], key, hash))
+            {
+                return index;
+            }
+        }
 
-    constexpr void max_load_factor(float ml)
-    {
-        assert(ml > 0.0f && "The max load factor must be greater than 0.0f.");
-        max_load_factor_ = ml;
-        rehash(8);
+        return node_end_index;
     }
 
-    constexpr void rehash(size_type count)
+    template <class K>
+    constexpr auto find_node_index(const K& key, std::size_t hash) const -> node_index_type
     {
-        count = std::max(minimum_capacity(), count);
-        count = std::max(count, static_cast<size_type>(size() / max_load_factor()));
+        auto index = buckets()[compute_index(hash, bucket_count())];
 
-        count = compute_closest_capacity(count);
-
-        assert(count > 0 && "The computed rehash size must be greater than 0.");
-
-        if (count == buckets_.size())
+        while (index != node_end_index)
         {
-            return;
-        }
+            const auto& node = nodes()[index];
 
-        buckets_.resize(count);
+            if (node_matches(node, key, hash))
+            {
+                break;
+            }
 
-        std::fill(buckets_.begin(), buckets_.end(), node_end_index);
+            index = node.next;
+        }
 
-        node_index_type index{0u};
+        return index;
+    }
 
-        for (auto& entry : nodes_)
+    template <class K>
+    constexpr auto find_in_bucket(const K& key) -> local_iterator
+    {
+        if constexpr (move_to_front_on_hit)
         {
-            entry.next = node_end_index;
-            reinsert_entry(entry, index);
-            index++;
+            if (!is_linear())
+            {
+                return local_iterator{find_node_index_moving_to_front(key), nodes()};
+            }
         }
+
+        return local_iterator{find_node_index(key), nodes()};
     }
 
-    constexpr void reserve(std::size_t count)
+    template <class K>
+    constexpr auto find_node_index_moving_to_front(const K& key) -> node_index_type
     {
-        rehash(std::ceil(count / max_load_factor()));
-        nodes_.reserve(count);
-    }
+        const auto hash = hash_(key);
+        const auto bindex = compute_index(hash, bucket_count());
+        auto* previous_next = &buckets()[bindex];
 
-    constexpr auto hash_function() const -> hasher { return hash_; }
+        while (*previous_next != node_end_index)
+        {
+            const auto index = *previous_next;
+            auto& node = nodes()[index];
 
-    constexpr auto key_eq() const -> key_equal { return key_equal_; }
+            if (node_matches(node, key, hash))
+            {
+                if (previous_next != &buckets()[bindex])
+                {
+                    *previous_next = node.next;
+
+                    if constexpr (has_prev_link)
+                    {
+                        if (node.next != node_end_index)
+                        {
+                            nodes()[node.next].prev = node.prev;
+                        }
+                    }
+
+                    link_at_head(node, index, bindex);
+                }
+
+                return index;
+            }
 
-private:
-    template <class K>
-    constexpr auto bucket_index(const K& key) const -> size_type
-    {
-        return compute_index(hash_(key), buckets_.size());
+            previous_next = &node.next;
+        }
+
+        return node_end_index;
     }
 
     template <class K>
-    constexpr auto find_in_bucket(const K& key, std::size_t bucket_index) -> local_iterator
+    constexpr auto find_in_bucket(const K& key) const -> const_local_iterator
     {
-        auto b = begin(bucket_index);
-        auto e = end(0u);
-        auto it = std::find_if(b, e, [&key, this](auto& p) { return key_equal_(p.first, key); });
-        return it;
+        return const_local_iterator{find_node_index(key), nodes()};
     }
 
     template <class K>
-    constexpr auto find_in_bucket(const K& key, std::size_t bucket_index) const
-        -> const_local_iterator
+    constexpr auto find_in_bucket(const K& key, std::size_t hash) -> local_iterator
     {
-        auto b = begin(bucket_index);
-        auto e = end(0u);
-        auto it = std::find_if(b, e, [&key, this](auto& p) { return key_equal_(p.first, key); });
-        return it;
+        return local_iterator{find_node_index(key, hash), nodes()};
     }
 
     constexpr auto
@@ -769,56 +2055,138 @@ private:
         // Skip the node by pointing the previous "next" to the one sub_it currently point to.
         *previous_next = sub_it->next;
 
-        auto last = std::prev(nodes_.end());
+        if constexpr (has_prev_link)
+        {
+            if (sub_it->next != node_end_index)
+            {
+                nodes()[sub_it->next].prev = sub_it->prev;
+            }
+        }
+
+        auto last = std::prev(nodes().end());
 
         // No need to do anything if the node was at the end of the vector.
         if (sub_it == last)
         {
-            nodes_.pop_back();
+            release_handle(*sub_it);
+            nodes().pop_back();
             return {end(), true};
         }
 
         // Swap last node and the one we want to delete.
         using std::swap;
         swap(*sub_it, *last);
+        release_handle(*last);
+        track_move(sub_it);
 
         // Now sub_it points to the one we swapped with. We have to readjust sub_it.
-        previous_next =
-            find_previous_next_using_position(sub_it->pair.pair().first, nodes_.size() - 1);
-        *previous_next = std::distance(nodes_.begin(), sub_it);
+        const auto position = static_cast<node_index_type>(std::distance(nodes().begin(), sub_it));
+
+        if constexpr (has_prev_link)
+        {
+            link_to(*sub_it) = position;
+
+            if (sub_it->next != node_end_index)
+            {
+                nodes()[sub_it->next].prev = position;
+            }
+        }
+        else
+        {
+            previous_next = find_previous_next_using_position(*sub_it, nodes().size() - 1);
+            *previous_next = position;
+        }
 
         // Delete the last node forever and ever.
-        nodes_.pop_back();
+        nodes().pop_back();
+
+        return {iterator{sub_it, nodes().end()}, true};
+    }
+
+    // Erase without any chain to maintain: the last node simply takes the place of the erased one.
+    constexpr auto do_erase_unchained(typename nodes_container_type::iterator sub_it) -> iterator
+    {
+        auto last = std::prev(nodes().end());
+
+        if (sub_it == last)
+        {
+            release_handle(*sub_it);
+            nodes().pop_back();
+            return end();
+        }
+
+        using std::swap;
+        swap(*sub_it, *last);
+        release_handle(*last);
+        track_move(sub_it);
+        nodes().pop_back();
 
-        return {iterator{sub_it}, true};
+        return iterator{sub_it, nodes().end()};
     }
 
-    constexpr auto find_previous_next_using_position(const key_type& key, std::size_t position)
+    constexpr auto
+    find_previous_next_using_position(const storage_node_type& node, std::size_t position)
         -> std::size_t*
     {
-        const std::size_t bindex = bucket_index(key);
+        const std::size_t bindex = compute_index(node_hash(node), bucket_count());
 
-        auto previous_next = &buckets_[bindex];
+        auto previous_next = &buckets()[bindex];
         while (*previous_next != position)
         {
-            previous_next = &nodes_[*previous_next].next;
+            previous_next = &nodes()[*previous_next].next;
         }
 
         return previous_next;
     }
 
-    constexpr void reinsert_entry(node_type& entry, node_index_type index)
+    // The bucket slot or the "next" of the previous node, whichever links to the node.
+    constexpr auto link_to(const storage_node_type& node) -> node_index_type&
+    {
+        static_assert(has_prev_link, "Only nodes with a prev link know what links to them.");
+
+        if (details::is_bucket_link<Key, T>(node.prev))
+        {
+            return buckets()[node.prev & ~details::bucket_link_flag<Key, T>];
+        }
+
+        return nodes()[node.prev].next;
+    }
+
+    constexpr void link_at_head(storage_node_type& entry, node_index_type index, size_type bindex)
+    {
+        entry.next = std::exchange(buckets()[bindex], index);
+
+        if constexpr (has_prev_link)
+        {
+            entry.prev = bindex | details::bucket_link_flag<Key, T>;
+
+            if (entry.next != node_end_index)
+            {
+                nodes()[entry.next].prev = index;
+            }
+        }
+    }
+
+    constexpr void reinsert_entry(storage_node_type& entry, node_index_type index)
     {
-        const auto bindex = bucket_index(entry.pair.const_key_pair().first);
-        auto old_index = std::exchange(buckets_[bindex], index);
-        entry.next = old_index;
+        link_at_head(entry, index, compute_index(node_hash(entry), bucket_count()));
     }
 
     constexpr void check_for_rehash()
     {
+        if (is_linear())
+        {
+            if (size() + 1 > linear_scan_capacity)
+            {
+                rebuild_buckets(static_cast<size_type>((size() + 1) / max_load_factor()));
+            }
+
+            return;
+        }
+
         if (size() + 1 > bucket_count() * max_load_factor())
         {
-            rehash(bucket_count() * 2);
+            rehash(details::grow_bucket_count<GrowthPolicy>(bucket_count()));
         }
     }
 
@@ -827,10 +2195,16 @@ private:
         return do_emplace(key_type{});
     }
 
+    // Keys that do not have to be turned into a key_type to be hashed and compared: the key is then
+    // only built, in place, if a node is appended.
+    template <class K>
+    static constexpr bool is_probing_key =
+        std::is_same_v<std::decay_t<K>, key_type> || is_heterogeneous_insert_key<K>;
+
     template <class Key2, class T2>
     constexpr auto dispatch_emplace(Key2&& key, T2&& t) -> std::pair<iterator, bool>
     {
-        if constexpr (std::is_same_v<std::decay_t<Key2>, key_type>)
+        if constexpr (is_probing_key<Key2>)
         {
             return do_emplace(key, std::forward<Key2>(key), std::forward<T2>(t));
         }
@@ -846,7 +2220,7 @@ private:
     template <class Pair>
     constexpr auto dispatch_emplace(Pair&& p) -> std::pair<iterator, bool>
     {
-        if constexpr (std::is_same_v<std::decay_t<decltype(p.first)>, key_type>)
+        if constexpr (is_probing_key<decltype((std::forward<Pair>(p).first))>)
         {
             return do_emplace(p.first, std::forward<Pair>(p));
         }
@@ -857,47 +2231,277 @@ private:
         }
     }
 
+    // The mapped value is always built in place. So is the key when it can be probed with as is,
+    // otherwise it is built once to be hashed, then moved in the node.
     template <class... Args1, class... Args2>
     constexpr auto dispatch_emplace(
         std::piecewise_construct_t, std::tuple<Args1...> first_args,
         std::tuple<Args2...> second_args) -> std::pair<iterator, bool>
     {
-        std::pair<Key, T> p{std::piecewise_construct, std::move(first_args),
-                            std::move(second_args)};
-        return dispatch_emplace(std::move(p));
+        if constexpr (sizeof...(Args1) == 1 && (is_probing_key<Args1> && ...))
+        {
+            const auto& key = std::get<0>(first_args);
+            return do_emplace(
+                key, std::piecewise_construct, std::move(first_args), std::move(second_args));
+        }
+        else
+        {
+            auto new_key = std::make_from_tuple<key_type>(std::move(first_args));
+            return do_emplace(
+                new_key, std::piecewise_construct, std::forward_as_tuple(std::move(new_key)),
+                std::move(second_args));
+        }
     }
 
-    template <class... Args>
-    constexpr auto do_emplace(const key_type& key, Args&&... args) -> std::pair<iterator, bool>
+    template <class K>
+    constexpr auto erase_key(const K& key) -> size_type
+    {
+        if (is_linear())
+        {
+            const auto index = find_node_index(key);
+
+            if (index == node_end_index)
+            {
+                return 0;
+            }
+
+            do_erase_unchained(std::next(nodes().begin(), index));
+            shrink_if_sparse();
+            return 1;
+        }
+
+        // We have to find out the node we look for and the pointer to it.
+        const auto hash = hash_(key);
+
+        std::size_t* previous_next = &buckets()[compute_index(hash, bucket_count())];
+
+        for (;;)
+        {
+            if (*previous_next == node_end_index)
+            {
+                return 0;
+            }
+
+            auto& node = nodes()[*previous_next];
+
+            if (node_matches(node, key, hash))
+            {
+                break;
+            }
+
+            previous_next = &node.next;
+        }
+
+        if constexpr (has_tombstones)
+        {
+            const auto position = static_cast<difference_type>(*previous_next);
+            bury_node(previous_next, std::next(nodes().begin(), position));
+            shrink_if_sparse();
+            settle(position + 1);
+            return 1;
+        }
+
+        do_erase(previous_next, std::next(nodes().begin(), *previous_next));
+        shrink_if_sparse();
+
+        return 1;
+    }
+
+    template <class Self, class K>
+    static constexpr auto do_at(Self& self, const K& key) -> decltype(auto)
+    {
+        const auto it = self.find(key);
+
+        if (it == self.end())
+        {
+#ifdef JG_NO_EXCEPTION
+            std::abort();
+#else
+            throw std::out_of_range("The specified key does not exists in this map.");
+#endif
+        }
+
+        return (it->second);
+    }
+
+    template <class K, class... Args>
+    constexpr auto do_emplace(const K& key, Args&&... args) -> std::pair<iterator, bool>
+    {
+        const auto [index, hash] = probe_for_insert(key);
+
+        if (index != node_end_index)
+        {
+            return std::pair{node_iterator(index), false};
+        }
+
+        return std::pair{append_node(key, hash, std::forward<Args>(args)...), true};
+    }
+
+    template <class K, class Visit, class... Args>
+    constexpr auto do_emplace_or_visit(const K& key, Visit&& visit, Args&&... args)
+        -> std::pair<iterator, bool>
+    {
+        const auto [index, hash] = probe_for_insert(key);
+
+        if (index != node_end_index)
+        {
+            const auto it = node_iterator(index);
+            std::invoke(std::forward<Visit>(visit), *it);
+            return std::pair{it, false};
+        }
+
+        return std::pair{append_node(key, hash, std::forward<Args>(args)...), true};
+    }
+
+    template <class K, class KeyArg, class Make, class Update>
+    constexpr auto do_upsert(const K& key, KeyArg&& key_arg, Make&& make, Update&& update)
+        -> std::pair<iterator, bool>
+    {
+        const auto [index, hash] = probe_for_insert(key);
+
+        if (index != node_end_index)
+        {
+            const auto it = node_iterator(index);
+            std::invoke(std::forward<Update>(update), it->second);
+            return std::pair{it, false};
+        }
+
+        return std::pair{
+            append_node(
+                key, hash, std::piecewise_construct,
+                std::forward_as_tuple(std::forward<KeyArg>(key_arg)),
+                std::forward_as_tuple(std::invoke(std::forward<Make>(make)))),
+            true};
+    }
+
+    // The index of the node holding key, or node_end_index, along with the hash of key. A linear
+    // map whose nodes do not cache their hash does not need it and leaves it at 0.
+    template <class K>
+    constexpr auto probe_for_insert(const K& key) const -> std::pair<node_index_type, std::size_t>
+    {
+        if (is_linear())
+        {
+            std::size_t hash = 0;
+
+            if constexpr (has_cached_hash)
+            {
+                hash = hash_(key);
+            }
+
+            return {scan_nodes(key, hash), hash};
+        }
+
+        const auto hash = hash_(key);
+        return {find_node_index(key, hash), hash};
+    }
+
+    // Appends and links a node for key, which probe_for_insert() just reported absent with the
+    // given hash. The map only grows here, once the insertion is certain.
+    template <class K, class... Args>
+    constexpr auto append_node([[maybe_unused]] const K& key, std::size_t hash, Args&&... args)
+        -> iterator
     {
+        const bool was_linear = is_linear();
         check_for_rehash();
 
-        const auto bindex = bucket_index(key);
-        auto local_it = find_in_bucket(key, bindex);
+        if constexpr (!has_cached_hash)
+        {
+            if (was_linear && !is_linear())
+            {
+                hash = hash_(key);
+            }
+        }
+
+        auto& node = emplace_node(node_end_index, std::forward<Args>(args)...);
+
+        if constexpr (has_cached_hash)
+        {
+            node.hash = hash;
+        }
+
+        if (!is_linear())
+        {
+            link_at_head(node, nodes().size() - 1, compute_index(hash, bucket_count()));
+        }
+
+        return std::prev(end());
+    }
+
+    template <class... Args>
+    constexpr auto emplace_node(node_index_type next, Args&&... args) -> storage_node_type&
+    {
+        reserve_handle();
+
+        if constexpr (details::has_node_growth_v<GrowthPolicy>)
+        {
+            if constexpr (details::is_out_of_line_node_v<storage_node_type>)
+            {
+                // The arguments can only refer to pairs, which stay in place.
+                if (nodes().size() == nodes().capacity())
+                {
+                    nodes().reserve(GrowthPolicy::grow_node_capacity(nodes().capacity()));
+                }
+            }
+            else if (nodes().size() == nodes().capacity())
+            {
+                // The arguments may refer to a node: build the new one before reallocating.
+                storage_node_type node(next, std::forward<Args>(args)...);
+                nodes().reserve(GrowthPolicy::grow_node_capacity(nodes().capacity()));
+                return claim_handle(nodes().emplace_back(std::move(node)));
+            }
+        }
+
+        return claim_handle(nodes().emplace_back(next, std::forward<Args>(args)...));
+    }
+
+    // Appends a node moved from a node handle or another map and links it, hash being the hash of
+    // its key. Expects the key to be absent and room for one more entry.
+    auto adopt_node(storage_node_type&& node, std::size_t hash) -> storage_node_type&
+    {
+        reserve_handle();
+
+        if constexpr (details::has_node_growth_v<GrowthPolicy>)
+        {
+            if (nodes().size() == nodes().capacity())
+            {
+                nodes().reserve(GrowthPolicy::grow_node_capacity(nodes().capacity()));
+            }
+        }
 
-        if (local_it != end(0u))
+        auto& new_node = claim_handle(nodes().emplace_back(std::move(node)));
+
+        if constexpr (has_cached_hash)
         {
-            return std::pair{details::bucket_iterator_to_iterator(local_it, nodes_), false};
+            new_node.hash = hash;
         }
 
-        nodes_.emplace_back(buckets_[bindex], std::forward<Args>(args)...);
-        buckets_[bindex] = nodes_.size() - 1;
+        if (is_linear())
+        {
+            new_node.next = node_end_index;
+        }
+        else
+        {
+            link_at_head(new_node, nodes().size() - 1, compute_index(hash, bucket_count()));
+        }
 
-        return std::pair{std::prev(end()), true};
+        return new_node;
     }
 
     hasher hash_;
     key_equal key_equal_;
 
-    buckets_container_type buckets_;
-    nodes_container_type nodes_;
-    float max_load_factor_ = details::default_max_load_factor;
+    storage_type storage_;
+    float max_load_factor_ = details::policy_max_load_factor<GrowthPolicy>();
+    float min_load_factor_ = 0.0f;
 };
 
-template <class Key, class T, class Hash, class KeyEqual, class Allocator>
+template <
+    class Key, class T, class Hash, class KeyEqual, class Allocator, class GrowthPolicy,
+    class StoragePolicy>
 constexpr auto operator==(
-    const dense_hash_map<Key, T, Hash, KeyEqual, Allocator>& lhs,
-    const dense_hash_map<Key, T, Hash, KeyEqual, Allocator>& rhs) -> bool
+    const dense_hash_map<Key, T, Hash, KeyEqual, Allocator, GrowthPolicy, StoragePolicy>& lhs,
+    const dense_hash_map<Key, T, Hash, KeyEqual, Allocator, GrowthPolicy, StoragePolicy>& rhs)
+    -> bool
 {
     if (lhs.size() != rhs.size())
     {
@@ -917,10 +2521,13 @@ constexpr auto operator==(
     return true;
 }
 
-template <class Key, class T, class Hash, class KeyEqual, class Allocator>
+template <
+    class Key, class T, class Hash, class KeyEqual, class Allocator, class GrowthPolicy,
+    class StoragePolicy>
 constexpr auto operator!=(
-    const dense_hash_map<Key, T, Hash, KeyEqual, Allocator>& lhs,
-    const dense_hash_map<Key, T, Hash, KeyEqual, Allocator>& rhs) -> bool
+    const dense_hash_map<Key, T, Hash, KeyEqual, Allocator, GrowthPolicy, StoragePolicy>& lhs,
+    const dense_hash_map<Key, T, Hash, KeyEqual, Allocator, GrowthPolicy, StoragePolicy>& rhs)
+    -> bool
 {
     return !(lhs == rhs);
 }
@@ -999,41 +2606,37 @@ namespace pmr
 {
     template <
         class Key, class T, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>,
-        class GrowthPolicy = details::power_of_two_growth_policy>
+        class GrowthPolicy = details::power_of_two_growth_policy,
+        class StoragePolicy = details::vector_storage_policy>
     using dense_hash_map = dense_hash_map<
-        Key, T, Hash, Pred, std::pmr::polymorphic_allocator<std::pair<const Key, T>>, GrowthPolicy>;
+        Key, T, Hash, Pred, std::pmr::polymorphic_allocator<std::pair<const Key, T>>, GrowthPolicy,
+        StoragePolicy>;
 } // namespace pmr
 
 } // namespace jg
 
 namespace std
 {
-template <class Key, class T, class Hash, class Pred, class Allocator, class GrowthPolicy>
+template <
+    class Key, class T, class Hash, class Pred, class Allocator, class GrowthPolicy,
+    class StoragePolicy>
 constexpr void swap(
-    jg::dense_hash_map<Key, T, Hash, Pred, Allocator, GrowthPolicy>& lhs,
-    jg::dense_hash_map<Key, T, Hash, Pred, Allocator, GrowthPolicy>&
+    jg::dense_hash_map<Key, T, Hash, Pred, Allocator, GrowthPolicy, StoragePolicy>& lhs,
+    jg::dense_hash_map<Key, T, Hash, Pred, Allocator, GrowthPolicy, StoragePolicy>&
         rhs) noexcept(noexcept(lhs.swap(rhs)))
 {
     lhs.swap(rhs);
 }
 
-template <class Key, class T, class Hash, class KeyEqual, class Alloc, class Pred>
-constexpr void erase_if(jg::dense_hash_map<Key, T, Hash, KeyEqual, Alloc>& c, Pred pred)
+template <
+    class Key, class T, class Hash, class KeyEqual, class Alloc, class GrowthPolicy,
+    class StoragePolicy, class Pred>
+constexpr auto erase_if(
+    jg::dense_hash_map<Key, T, Hash, KeyEqual, Alloc, GrowthPolicy, StoragePolicy>& c, Pred pred)
+    -> typename jg::dense_hash_map<
+        Key, T, Hash, KeyEqual, Alloc, GrowthPolicy, StoragePolicy>::size_type
 {
-    auto rit = std::make_reverse_iterator(c.end());
-    auto rend = std::make_reverse_iterator(c.begin());
-
-    while (rit != rend)
-    {
-        if (pred(*rit))
-        {
-            rit = std::make_reverse_iterator(c.erase(std::prev(rit.base())));
-        }
-        else
-        {
-            ++rit;
-        }
-    }
+    return c.erase_if(std::move(pred));
 }
 
 } // namespace std
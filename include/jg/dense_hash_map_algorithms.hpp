@@ -0,0 +1,214 @@
+#ifndef JG_DENSE_HASH_MAP_ALGORITHMS_HPP
+#define JG_DENSE_HASH_MAP_ALGORITHMS_HPP
+
+#include "dense_hash_map.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// Bulk set algebra over dense_hash_maps. Each kernel walks the dense nodes of one side and looks
+// the keys up in the other one with find_batch(). The overloads taking an executor split the walk
+// in chunks: executor(n, f) must call f(i) once for every i in [0, n), possibly concurrently, and
+// return once all the calls are done. The results are the same, in the same order, as without it.
+namespace jg
+{
+
+// Output of probe(): the position of the probe key and the entry of the build map it matched.
+template <class Map>
+using probe_result = std::pair<std::size_t, const typename Map::value_type*>;
+
+namespace details
+{
+    struct key_of_entry
+    {
+        template <class Pair>
+        constexpr auto operator()(const Pair& pair) const noexcept -> const auto&
+        {
+            return pair.first;
+        }
+    };
+
+    struct key_of_key
+    {
+        template <class Key>
+        constexpr auto operator()(const Key& key) const noexcept -> const Key&
+        {
+            return key;
+        }
+    };
+
+    // Runs collect(first, last, chunk_out) on chunks of [0, count) through the executor, each chunk
+    // writing to its own buffer, then moves the buffers to out in order.
+    template <class Result, class Executor, class Collect, class OutputIt>
+    auto parallel_collect(Executor& executor, std::size_t count, Collect collect, OutputIt out)
+        -> OutputIt
+    {
+        const std::size_t chunk_count = (count + parallel_chunk_size - 1) / parallel_chunk_size;
+        std::vector<std::vector<Result>> results(chunk_count);
+
+        executor(chunk_count, [&](std::size_t chunk) {
+            const std::size_t first = chunk * parallel_chunk_size;
+            collect(
+                first, std::min(count, first + parallel_chunk_size),
+                std::back_inserter(results[chunk]));
+        });
+
+        for (auto& result : results)
+        {
+            out = std::move(result.begin(), result.end(), out);
+        }
+
+        return out;
+    }
+
+    template <class Map, class ForwardIt, class OutputIt>
+    auto probe_range(
+        const Map& build, ForwardIt first, ForwardIt last, std::size_t position, OutputIt out)
+        -> OutputIt
+    {
+        build.find_batch(first, last, key_of_key{}, [&](auto, auto found) {
+            if (found != build.end())
+            {
+                *out++ = probe_result<Map>{position, &*found};
+            }
+
+            ++position;
+        });
+
+        return out;
+    }
+} // namespace details
+
+// Writes the keys present in both maps to out, in the order of the smaller map, which is walked
+// while the larger one is probed.
+template <class Map1, class Map2, class OutputIt>
+auto intersect_keys(const Map1& lhs, const Map2& rhs, OutputIt out) -> OutputIt
+{
+    if (rhs.size() < lhs.size())
+    {
+        return intersect_keys(rhs, lhs, out);
+    }
+
+    rhs.find_batch(lhs.begin(), lhs.end(), details::key_of_entry{}, [&](auto it, auto found) {
+        if (found != rhs.end())
+        {
+            *out++ = it->first;
+        }
+    });
+
+    return out;
+}
+
+template <class Executor, class Map1, class Map2, class OutputIt>
+auto intersect_keys(Executor&& executor, const Map1& lhs, const Map2& rhs, OutputIt out)
+    -> OutputIt
+{
+    if (rhs.size() < lhs.size())
+    {
+        return intersect_keys(executor, rhs, lhs, out);
+    }
+
+    return details::parallel_collect<typename Map1::key_type>(
+        executor, lhs.size(),
+        [&](std::size_t first, std::size_t last, auto chunk_out) {
+            rhs.find_batch(
+                std::next(lhs.begin(), static_cast<std::ptrdiff_t>(first)),
+                std::next(lhs.begin(), static_cast<std::ptrdiff_t>(last)), details::key_of_entry{},
+                [&](auto it, auto found) {
+                    if (found != rhs.end())
+                    {
+                        *chunk_out++ = it->first;
+                    }
+                });
+        },
+        out);
+}
+
+// Writes the keys of lhs that are not in rhs to out.
+template <class Map1, class Map2, class OutputIt>
+auto difference(const Map1& lhs, const Map2& rhs, OutputIt out) -> OutputIt
+{
+    rhs.find_batch(lhs.begin(), lhs.end(), details::key_of_entry{}, [&](auto it, auto found) {
+        if (found == rhs.end())
+        {
+            *out++ = it->first;
+        }
+    });
+
+    return out;
+}
+
+template <class Executor, class Map1, class Map2, class OutputIt>
+auto difference(Executor&& executor, const Map1& lhs, const Map2& rhs, OutputIt out) -> OutputIt
+{
+    return details::parallel_collect<typename Map1::key_type>(
+        executor, lhs.size(),
+        [&](std::size_t first, std::size_t last, auto chunk_out) {
+            rhs.find_batch(
+                std::next(lhs.begin(), static_cast<std::ptrdiff_t>(first)),
+                std::next(lhs.begin(), static_cast<std::ptrdiff_t>(last)), details::key_of_entry{},
+                [&](auto it, auto found) {
+                    if (found == rhs.end())
+                    {
+                        *chunk_out++ = it->first;
+                    }
+                });
+        },
+        out);
+}
+
+// Copies the entries of source whose key is not in dest into dest, growing dest once. Returns the
+// number of inserted entries.
+template <class Map1, class Map2>
+auto union_into(Map1& dest, const Map2& source) -> typename Map1::size_type
+{
+    std::vector<typename Map2::const_iterator> missing;
+
+    dest.find_batch(
+        source.begin(), source.end(), details::key_of_entry{}, [&](auto it, auto found) {
+            if (found == dest.cend())
+            {
+                missing.push_back(it);
+            }
+        });
+
+    dest.reserve(dest.size() + missing.size());
+
+    for (const auto& it : missing)
+    {
+        dest.try_emplace(it->first, it->second);
+    }
+
+    return missing.size();
+}
+
+// Hash join: writes a probe_result to out for each key of probe_keys found in build, in the order
+// of probe_keys.
+template <class Map, class KeyRange, class OutputIt>
+auto probe(const Map& build, const KeyRange& probe_keys, OutputIt out) -> OutputIt
+{
+    return details::probe_range(build, std::begin(probe_keys), std::end(probe_keys), 0u, out);
+}
+
+template <class Executor, class Map, class KeyRange, class OutputIt>
+auto probe(Executor&& executor, const Map& build, const KeyRange& probe_keys, OutputIt out)
+    -> OutputIt
+{
+    const auto first_key = std::begin(probe_keys);
+
+    return details::parallel_collect<probe_result<Map>>(
+        executor, static_cast<std::size_t>(std::distance(first_key, std::end(probe_keys))),
+        [&](std::size_t first, std::size_t last, auto chunk_out) {
+            details::probe_range(
+                build, std::next(first_key, static_cast<std::ptrdiff_t>(first)),
+                std::next(first_key, static_cast<std::ptrdiff_t>(last)), first, chunk_out);
+        },
+        out);
+}
+
+} // namespace jg
+
+#endif // JG_DENSE_HASH_MAP_ALGORITHMS_HPP
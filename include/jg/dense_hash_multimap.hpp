@@ -0,0 +1,736 @@
+#ifndef JG_DENSE_HASH_MULTIMAP_HPP
+#define JG_DENSE_HASH_MULTIMAP_HPP
+
+#include "dense_hash_map.hpp"
+#include "details/doubly_linked_storage_policy.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jg
+{
+
+namespace details
+{
+    // The nodes sharing a key in a dense_hash_multimap: the ends of their chain and its length.
+    template <class Index, Index EndIndex>
+    struct multimap_group
+    {
+        Index head = EndIndex;
+        Index tail = EndIndex;
+        Index count = 0;
+    };
+} // namespace details
+
+// A hash multimap with the layout of a dense_hash_map: all the entries are stored contiguously in
+// a single vector of nodes, and an erased entry is replaced by the last one. The entries sharing a
+// key are chained to each other, in insertion order, and a dense_hash_map from each distinct key
+// to the ends of its chain finds them. equal_range() walks that chain alone, count() is O(1), and
+// no key needs a heap allocation of its own to hold its values.
+//
+// Whenever the nodes are reallocated, and on shrink_to_fit(), they are regrouped by key: the
+// entries of a key are then adjacent until new ones are appended, which changes the iteration
+// order. equal_range() returns local iterators, which walk the chain of a key, rather than
+// iterators: the entries sharing a key are not guaranteed to be contiguous.
+template <
+    class Key, class T, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>,
+    class Allocator = std::allocator<std::pair<const Key, T>>,
+    class GrowthPolicy = details::power_of_two_growth_policy>
+class dense_hash_multimap
+{
+private:
+    using storage_node_type = details::doubly_linked_node<Key, T>;
+    using nodes_container_type =
+        std::vector<storage_node_type, details::rebind_alloc<Allocator, storage_node_type>>;
+    using node_index_type = details::node_index_t<Key, T>;
+
+    static inline constexpr node_index_type node_end_index = details::node_end_index<Key, T>;
+
+    using group_type = details::multimap_group<node_index_type, node_end_index>;
+    using groups_type = dense_hash_map<
+        Key, group_type, Hash, Pred,
+        details::rebind_alloc<Allocator, std::pair<const Key, group_type>>, GrowthPolicy>;
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = typename nodes_container_type::size_type;
+    using difference_type = typename nodes_container_type::difference_type;
+    using hasher = Hash;
+    using key_equal = typename groups_type::key_equal;
+    using allocator_type = Allocator;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = typename std::allocator_traits<allocator_type>::pointer;
+    using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+    using iterator = details::dense_hash_map_iterator<Key, T, nodes_container_type, false, true>;
+    using const_iterator =
+        details::dense_hash_map_iterator<Key, T, nodes_container_type, true, true>;
+    using local_iterator = details::bucket_iterator<Key, T, nodes_container_type, false, true>;
+    using const_local_iterator = details::bucket_iterator<Key, T, nodes_container_type, true, true>;
+
+    constexpr dense_hash_multimap() = default;
+
+    constexpr explicit dense_hash_multimap(
+        size_type bucket_count, const Hash& hash = Hash(), const key_equal& equal = key_equal(),
+        const allocator_type& alloc = allocator_type())
+        : nodes_(typename nodes_container_type::allocator_type(alloc))
+        , groups_(bucket_count, hash, equal, typename groups_type::allocator_type(alloc))
+    {}
+
+    constexpr dense_hash_multimap(size_type bucket_count, const allocator_type& alloc)
+        : dense_hash_multimap(bucket_count, hasher(), key_equal(), alloc)
+    {}
+
+    constexpr explicit dense_hash_multimap(const allocator_type& alloc)
+        : dense_hash_multimap(default_bucket_count(), hasher(), key_equal(), alloc)
+    {}
+
+    template <class InputIt>
+    constexpr dense_hash_multimap(
+        InputIt first, InputIt last, size_type bucket_count = default_bucket_count(),
+        const Hash& hash = Hash(), const key_equal& equal = key_equal(),
+        const allocator_type& alloc = allocator_type())
+        : dense_hash_multimap(bucket_count, hash, equal, alloc)
+    {
+        insert(first, last);
+    }
+
+    constexpr dense_hash_multimap(
+        std::initializer_list<value_type> init, size_type bucket_count = default_bucket_count(),
+        const hasher& hash = hasher(), const key_equal& equal = key_equal(),
+        const allocator_type& alloc = allocator_type())
+        : dense_hash_multimap(init.begin(), init.end(), bucket_count, hash, equal, alloc)
+    {}
+
+    constexpr dense_hash_multimap(const dense_hash_multimap& other) = default;
+
+    constexpr dense_hash_multimap(const dense_hash_multimap& other, const allocator_type& alloc)
+        : nodes_(other.nodes_, typename nodes_container_type::allocator_type(alloc))
+        , groups_(other.groups_, typename groups_type::allocator_type(alloc))
+    {}
+
+    constexpr dense_hash_multimap(dense_hash_multimap&& other) noexcept(
+        std::is_nothrow_move_constructible_v<nodes_container_type>&&
+            std::is_nothrow_move_constructible_v<groups_type>) = default;
+
+    ~dense_hash_multimap() = default;
+
+    constexpr auto operator=(const dense_hash_multimap& other) -> dense_hash_multimap& = default;
+    constexpr auto operator=(dense_hash_multimap&& other) noexcept(
+        std::is_nothrow_move_assignable_v<nodes_container_type>&&
+            std::is_nothrow_move_assignable_v<groups_type>) -> dense_hash_multimap& = default;
+
+    constexpr auto operator=(std::initializer_list<value_type> ilist) -> dense_hash_multimap&
+    {
+        clear();
+        insert(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    constexpr auto get_allocator() const -> allocator_type
+    {
+        return allocator_type(nodes_.get_allocator());
+    }
+
+    constexpr auto begin() noexcept -> iterator { return iterator{nodes_.begin()}; }
+
+    constexpr auto begin() const noexcept -> const_iterator
+    {
+        return const_iterator{nodes_.begin()};
+    }
+
+    constexpr auto cbegin() const noexcept -> const_iterator { return begin(); }
+
+    constexpr auto end() noexcept -> iterator { return iterator{nodes_.end()}; }
+
+    constexpr auto end() const noexcept -> const_iterator { return const_iterator{nodes_.end()}; }
+
+    constexpr auto cend() const noexcept -> const_iterator { return end(); }
+
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return nodes_.empty(); }
+
+    constexpr auto size() const noexcept -> size_type { return nodes_.size(); }
+
+    // The number of distinct keys.
+    constexpr auto key_count() const noexcept -> size_type { return groups_.size(); }
+
+    constexpr auto max_size() const noexcept -> size_type
+    {
+        return std::min<size_type>(nodes_.max_size(), node_end_index - 1);
+    }
+
+    constexpr void clear() noexcept
+    {
+        nodes_.clear();
+        groups_.clear();
+    }
+
+    // Inserts a new entry, after the entries with the same key. Always succeeds.
+    template <class... Args>
+    auto emplace(Args&&... args) -> iterator
+    {
+        if (nodes_.size() == nodes_.capacity())
+        {
+            // The arguments may refer to an entry: build the new one before regrouping them.
+            storage_node_type node(node_end_index, std::forward<Args>(args)...);
+            regroup(grown_capacity(nodes_.size() + 1));
+            nodes_.emplace_back(std::move(node));
+        }
+        else
+        {
+            nodes_.emplace_back(node_end_index, std::forward<Args>(args)...);
+        }
+
+#ifndef JG_NO_EXCEPTION
+        try
+        {
+#endif
+            auto& group = groups_.try_emplace(node_key(nodes_.back())).first->second;
+            link_back(group, nodes_.size() - 1);
+#ifndef JG_NO_EXCEPTION
+        }
+        catch (...)
+        {
+            nodes_.pop_back();
+            throw;
+        }
+#endif
+
+        return std::prev(end());
+    }
+
+    template <class... Args>
+    auto emplace_hint(const_iterator /*hint*/, Args&&... args) -> iterator
+    {
+        return emplace(std::forward<Args>(args)...);
+    }
+
+    auto insert(const value_type& value) -> iterator { return emplace(value); }
+
+    auto insert(value_type&& value) -> iterator { return emplace(std::move(value)); }
+
+    template <class P, std::enable_if_t<std::is_constructible_v<value_type, P&&>, int> = 0>
+    auto insert(P&& value) -> iterator
+    {
+        return emplace(std::forward<P>(value));
+    }
+
+    auto insert(const_iterator /*hint*/, const value_type& value) -> iterator
+    {
+        return emplace(value);
+    }
+
+    auto insert(const_iterator /*hint*/, value_type&& value) -> iterator
+    {
+        return emplace(std::move(value));
+    }
+
+    template <class InputIt>
+    void insert(InputIt first, InputIt last)
+    {
+        if constexpr (std::is_base_of_v<
+                          std::forward_iterator_tag,
+                          typename std::iterator_traits<InputIt>::iterator_category>)
+        {
+            reserve_nodes(nodes_.size() + static_cast<size_type>(std::distance(first, last)));
+        }
+
+        for (; first != last; ++first)
+        {
+            emplace(*first);
+        }
+    }
+
+    void insert(std::initializer_list<value_type> ilist) { insert(ilist.begin(), ilist.end()); }
+
+    // Inserts key -> value for every value of [first, last), looking key up once. The new entries
+    // are contiguous: they span from the returned iterator to end().
+    template <class InputIt>
+    auto insert_many(const key_type& key, InputIt first, InputIt last) -> iterator
+    {
+        if (first == last)
+        {
+            return end();
+        }
+
+        // Use the key of the group: key may be the key of an entry that a regroup moves.
+        auto& [group_key, group] = *groups_.try_emplace(key).first;
+
+#ifndef JG_NO_EXCEPTION
+        try
+        {
+#endif
+            if constexpr (std::is_base_of_v<
+                              std::forward_iterator_tag,
+                              typename std::iterator_traits<InputIt>::iterator_category>)
+            {
+                reserve_nodes(nodes_.size() + static_cast<size_type>(std::distance(first, last)));
+            }
+
+            const auto first_position = static_cast<difference_type>(nodes_.size());
+
+            for (; first != last; ++first)
+            {
+                if (nodes_.size() == nodes_.capacity())
+                {
+                    regroup(grown_capacity(nodes_.size() + 1));
+                }
+
+                nodes_.emplace_back(node_end_index, group_key, *first);
+                link_back(group, nodes_.size() - 1);
+            }
+
+            return std::next(begin(), first_position);
+#ifndef JG_NO_EXCEPTION
+        }
+        catch (...)
+        {
+            if (group.count == 0)
+            {
+                groups_.erase(group_key);
+            }
+
+            throw;
+        }
+#endif
+    }
+
+    template <class Range>
+    auto insert_many(const key_type& key, const Range& values) -> iterator
+    {
+        return insert_many(key, std::begin(values), std::end(values));
+    }
+
+    auto insert_many(const key_type& key, std::initializer_list<mapped_type> values) -> iterator
+    {
+        return insert_many(key, values.begin(), values.end());
+    }
+
+    // Erases the entry at pos, which the last entry replaces.
+    constexpr auto erase(const_iterator pos) -> iterator
+    {
+        const auto position = std::distance(cbegin(), pos);
+        erase_at(static_cast<node_index_type>(position));
+        return std::next(begin(), position);
+    }
+
+    constexpr auto erase(const_iterator first, const_iterator last) -> iterator
+    {
+        const auto first_position = std::distance(cbegin(), first);
+        auto last_position = std::distance(cbegin(), last);
+
+        // From the back, so that only entries past the range move into the erased ones.
+        while (last_position != first_position)
+        {
+            erase_at(static_cast<node_index_type>(--last_position));
+        }
+
+        return std::next(begin(), first_position);
+    }
+
+    // Erases all the entries of key and returns their number.
+    constexpr auto erase(const key_type& key) -> size_type
+    {
+        const auto it = groups_.find(key);
+
+        if (it == groups_.end())
+        {
+            return 0u;
+        }
+
+        auto& group = it->second;
+        const size_type count = group.count;
+
+        while (group.count > 0)
+        {
+            erase_node(group.head, group);
+        }
+
+        groups_.erase(it);
+        return count;
+    }
+
+    // Erases every entry satisfying pred. Returns the number of erased entries.
+    template <class Predicate>
+    constexpr auto erase_if(Predicate pred) -> size_type
+    {
+        const auto old_size = size();
+
+        // From the back, so that the last entry moved into an erased one was already visited.
+        for (auto position = old_size; position > 0; --position)
+        {
+            if (pred(nodes_[position - 1].pair.const_key_pair()))
+            {
+                erase_at(static_cast<node_index_type>(position - 1));
+            }
+        }
+
+        return old_size - size();
+    }
+
+    constexpr void swap(dense_hash_multimap& other) noexcept(
+        std::is_nothrow_swappable_v<nodes_container_type>&&
+            std::is_nothrow_swappable_v<groups_type>)
+    {
+        using std::swap;
+        swap(nodes_, other.nodes_);
+        swap(groups_, other.groups_);
+    }
+
+    constexpr auto count(const key_type& key) const -> size_type { return count_of(key); }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto count(const K& key) const -> size_type
+    {
+        return count_of(key);
+    }
+
+    // The first entry inserted with key, if any.
+    constexpr auto find(const key_type& key) -> iterator { return position_of(*this, key); }
+
+    constexpr auto find(const key_type& key) const -> const_iterator
+    {
+        return position_of(*this, key);
+    }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto find(const K& key) -> iterator
+    {
+        return position_of(*this, key);
+    }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto find(const K& key) const -> const_iterator
+    {
+        return position_of(*this, key);
+    }
+
+    constexpr auto contains(const key_type& key) const -> bool { return groups_.contains(key); }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto contains(const K& key) const -> bool
+    {
+        return groups_.contains(key);
+    }
+
+    // The entries of key, in insertion order, unless an erasure moved one of them.
+    constexpr auto equal_range(const key_type& key) -> std::pair<local_iterator, local_iterator>
+    {
+        return range_of<local_iterator>(*this, key);
+    }
+
+    constexpr auto equal_range(const key_type& key) const
+        -> std::pair<const_local_iterator, const_local_iterator>
+    {
+        return range_of<const_local_iterator>(*this, key);
+    }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto equal_range(const K& key) -> std::pair<local_iterator, local_iterator>
+    {
+        return range_of<local_iterator>(*this, key);
+    }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto equal_range(const K& key) const
+        -> std::pair<const_local_iterator, const_local_iterator>
+    {
+        return range_of<const_local_iterator>(*this, key);
+    }
+
+    // The buckets hold the distinct keys.
+    constexpr auto bucket_count() const -> size_type { return groups_.bucket_count(); }
+
+    constexpr auto load_factor() const -> float { return groups_.load_factor(); }
+
+    constexpr auto max_load_factor() const -> float { return groups_.max_load_factor(); }
+
+    constexpr void max_load_factor(float ml) { groups_.max_load_factor(ml); }
+
+    constexpr void rehash(size_type count) { groups_.rehash(count); }
+
+    // Makes room for count entries, with as many distinct keys.
+    constexpr void reserve(size_type count)
+    {
+        reserve_nodes(count);
+        groups_.reserve(count);
+    }
+
+    // Also regroups the entries by key.
+    constexpr void shrink_to_fit()
+    {
+        regroup(nodes_.size());
+        groups_.shrink_to_fit();
+    }
+
+    constexpr auto hash_function() const -> hasher { return groups_.hash_function(); }
+
+    constexpr auto key_eq() const -> key_equal { return groups_.key_eq(); }
+
+private:
+    static constexpr auto default_bucket_count() -> size_type
+    {
+        return GrowthPolicy::minimum_capacity();
+    }
+
+    static constexpr auto node_key(const storage_node_type& node) -> const key_type&
+    {
+        return node.pair.const_key_pair().first;
+    }
+
+    template <class K>
+    constexpr auto count_of(const K& key) const -> size_type
+    {
+        const auto it = groups_.find(key);
+        return it == groups_.end() ? 0u : it->second.count;
+    }
+
+    template <class Self, class K>
+    static constexpr auto position_of(Self& self, const K& key)
+    {
+        const auto it = self.groups_.find(key);
+
+        if (it == self.groups_.end())
+        {
+            return self.end();
+        }
+
+        return std::next(self.begin(), static_cast<difference_type>(it->second.head));
+    }
+
+    template <class LocalIt, class Self, class K>
+    static constexpr auto range_of(Self& self, const K& key) -> std::pair<LocalIt, LocalIt>
+    {
+        const auto it = self.groups_.find(key);
+        const auto head = it == self.groups_.end() ? node_end_index : it->second.head;
+
+        return {LocalIt{head, self.nodes_}, LocalIt{self.nodes_}};
+    }
+
+    constexpr auto grown_capacity(size_type count) const -> size_type
+    {
+        if constexpr (details::has_node_growth_v<GrowthPolicy>)
+        {
+            return std::max(count, GrowthPolicy::grow_node_capacity(nodes_.capacity()));
+        }
+        else
+        {
+            return std::max(count, nodes_.capacity() * 2);
+        }
+    }
+
+    constexpr void reserve_nodes(size_type count)
+    {
+        if (count > nodes_.capacity())
+        {
+            regroup(count);
+        }
+    }
+
+    // Moves the nodes to a new buffer of the given capacity, group after group, so that the nodes
+    // sharing a key end up contiguous and equal_range() walks them in order. Growing moves all the
+    // nodes anyway: they are regrouped for the cost of the random reads. Nodes that could throw
+    // while being moved are moved in place instead, not to leave the groups half relinked.
+    constexpr void regroup(size_type capacity)
+    {
+        if constexpr (!std::is_nothrow_move_constructible_v<storage_node_type>)
+        {
+            nodes_.reserve(capacity);
+        }
+        else
+        {
+            nodes_container_type regrouped(nodes_.get_allocator());
+            regrouped.reserve(capacity);
+
+            for (auto& [key, group] : groups_)
+            {
+                // insert_many() may regroup with the group it appends to still empty.
+                if (group.count == 0)
+                {
+                    continue;
+                }
+
+                auto index = std::exchange(group.head, regrouped.size());
+                node_index_type previous = node_end_index;
+
+                while (index != node_end_index)
+                {
+                    auto& node = regrouped.emplace_back(std::move(nodes_[index]));
+                    index = node.next;
+                    node.next = node_end_index;
+                    node.prev = previous;
+
+                    if (previous != node_end_index)
+                    {
+                        regrouped[previous].next = regrouped.size() - 1;
+                    }
+
+                    previous = regrouped.size() - 1;
+                }
+
+                group.tail = previous;
+            }
+
+            nodes_.swap(regrouped);
+        }
+    }
+
+    // Chains the node at index after the other nodes of group.
+    constexpr void link_back(group_type& group, node_index_type index)
+    {
+        auto& node = nodes_[index];
+        node.next = node_end_index;
+        node.prev = group.tail;
+
+        if (group.tail == node_end_index)
+        {
+            group.head = index;
+        }
+        else
+        {
+            nodes_[group.tail].next = index;
+        }
+
+        group.tail = index;
+        ++group.count;
+    }
+
+    constexpr void unlink(group_type& group, const storage_node_type& node)
+    {
+        (node.prev == node_end_index ? group.head : nodes_[node.prev].next) = node.next;
+        (node.next == node_end_index ? group.tail : nodes_[node.next].prev) = node.prev;
+        --group.count;
+    }
+
+    constexpr void erase_at(node_index_type index)
+    {
+        const auto it = groups_.find(node_key(nodes_[index]));
+        erase_node(index, it->second);
+
+        if (it->second.count == 0)
+        {
+            groups_.erase(it);
+        }
+    }
+
+    // Unlinks the node at index from its group, then moves the last node in its place. Only a last
+    // node heading or ending its chain needs its key looked up to be relinked.
+    constexpr void erase_node(node_index_type index, group_type& group)
+    {
+        unlink(group, nodes_[index]);
+
+        const auto last = static_cast<node_index_type>(nodes_.size() - 1);
+
+        if (index != last)
+        {
+            const auto& node = nodes_[last];
+            group_type* last_group = nullptr;
+
+            if (node.prev == node_end_index || node.next == node_end_index)
+            {
+                last_group = &groups_.find(node_key(node))->second;
+            }
+
+            (node.prev == node_end_index ? last_group->head : nodes_[node.prev].next) = index;
+            (node.next == node_end_index ? last_group->tail : nodes_[node.next].prev) = index;
+
+            nodes_[index] = std::move(nodes_[last]);
+        }
+
+        nodes_.pop_back();
+    }
+
+    nodes_container_type nodes_;
+    groups_type groups_;
+};
+
+// Equal when both hold the same entries, whatever their order.
+template <class Key, class T, class Hash, class KeyEqual, class Allocator, class GrowthPolicy>
+auto operator==(
+    const dense_hash_multimap<Key, T, Hash, KeyEqual, Allocator, GrowthPolicy>& lhs,
+    const dense_hash_multimap<Key, T, Hash, KeyEqual, Allocator, GrowthPolicy>& rhs) -> bool
+{
+    if (lhs.size() != rhs.size() || lhs.key_count() != rhs.key_count())
+    {
+        return false;
+    }
+
+    for (const auto& item : lhs)
+    {
+        const auto [first, last] = lhs.equal_range(item.first);
+
+        // Compare each key once, from the head of its chain.
+        if (&*first != &item)
+        {
+            continue;
+        }
+
+        const auto [other_first, other_last] = rhs.equal_range(item.first);
+
+        if (!std::is_permutation(first, last, other_first, other_last))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <class Key, class T, class Hash, class KeyEqual, class Allocator, class GrowthPolicy>
+auto operator!=(
+    const dense_hash_multimap<Key, T, Hash, KeyEqual, Allocator, GrowthPolicy>& lhs,
+    const dense_hash_multimap<Key, T, Hash, KeyEqual, Allocator, GrowthPolicy>& rhs) -> bool
+{
+    return !(lhs == rhs);
+}
+
+namespace pmr
+{
+    template <
+        class Key, class T, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>,
+        class GrowthPolicy = details::power_of_two_growth_policy>
+    using dense_hash_multimap = dense_hash_multimap<
+        Key, T, Hash, Pred, std::pmr::polymorphic_allocator<std::pair<const Key, T>>,
+        GrowthPolicy>;
+} // namespace pmr
+
+} // namespace jg
+
+namespace std
+{
+template <class Key, class T, class Hash, class Pred, class Allocator, class GrowthPolicy>
+constexpr void swap(
+    jg::dense_hash_multimap<Key, T, Hash, Pred, Allocator, GrowthPolicy>& lhs,
+    jg::dense_hash_multimap<Key, T, Hash, Pred, Allocator, GrowthPolicy>&
+        rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+    lhs.swap(rhs);
+}
+
+template <
+    class Key, class T, class Hash, class KeyEqual, class Alloc, class GrowthPolicy, class Pred>
+constexpr auto erase_if(
+    jg::dense_hash_multimap<Key, T, Hash, KeyEqual, Alloc, GrowthPolicy>& c, Pred pred) ->
+    typename jg::dense_hash_multimap<Key, T, Hash, KeyEqual, Alloc, GrowthPolicy>::size_type
+{
+    return c.erase_if(std::move(pred));
+}
+
+} // namespace std
+
+#endif // JG_DENSE_HASH_MULTIMAP_HPP
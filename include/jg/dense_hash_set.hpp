@@ -0,0 +1,528 @@
+#ifndef JG_DENSE_HASH_SET_HPP
+#define JG_DENSE_HASH_SET_HPP
+
+#include "dense_hash_map.hpp"
+#include "details/set_node.hpp"
+
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+namespace jg
+{
+
+// A set of keys with the layout of a dense_hash_map: the keys are stored contiguously, in
+// insertion order until erasures move the last key in the place of erased ones, and chained
+// through buckets of indices. It is a dense_hash_map whose nodes only hold the key and its link,
+// so that all the bucket and chain machinery is shared and no node pays for a mapped value.
+// The iterators are random access over the contiguous keys.
+template <
+    class Key, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>,
+    class Allocator = std::allocator<Key>,
+    class GrowthPolicy = details::power_of_two_growth_policy,
+    class StoragePolicy = details::vector_storage_policy>
+class dense_hash_set
+{
+private:
+    template <class, class, class, class, class, class>
+    friend class dense_hash_set;
+
+    using map_type = dense_hash_map<
+        Key, details::no_mapped_value, Hash, Pred,
+        details::rebind_alloc<Allocator, std::pair<const Key, details::no_mapped_value>>,
+        GrowthPolicy, details::set_storage_policy<StoragePolicy>>;
+    using map_allocator_type = typename map_type::allocator_type;
+
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using size_type = typename map_type::size_type;
+    using difference_type = typename map_type::difference_type;
+    using hasher = Hash;
+    using key_equal = typename map_type::key_equal;
+    using allocator_type = Allocator;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = typename std::allocator_traits<allocator_type>::pointer;
+    using const_pointer = typename std::allocator_traits<allocator_type>::const_pointer;
+    using iterator = typename map_type::const_iterator;
+    using const_iterator = typename map_type::const_iterator;
+    using local_iterator = typename map_type::const_local_iterator;
+    using const_local_iterator = typename map_type::const_local_iterator;
+    using node_type = typename map_type::node_type;
+    using insert_return_type = details::insert_return_type<iterator, node_type>;
+
+private:
+    template <class K>
+    static constexpr bool is_heterogeneous_insert_key =
+        details::is_transparent_lookup_v<Hash, Pred> &&
+        details::is_heterogeneous_key_v<K, Key, iterator, const_iterator> &&
+        std::is_constructible_v<Key, K&&>;
+
+    // Arguments the key can be probed with before being built in place.
+    template <class... Args>
+    static constexpr bool is_probing_key =
+        sizeof...(Args) == 1 &&
+        ((std::is_same_v<std::decay_t<Args>, key_type> || is_heterogeneous_insert_key<Args>)&&...);
+
+public:
+    constexpr dense_hash_set() = default;
+
+    constexpr explicit dense_hash_set(
+        size_type bucket_count, const Hash& hash = Hash(), const key_equal& equal = key_equal(),
+        const allocator_type& alloc = allocator_type())
+        : map_(bucket_count, hash, equal, map_allocator_type(alloc))
+    {}
+
+    constexpr dense_hash_set(size_type bucket_count, const allocator_type& alloc)
+        : map_(bucket_count, map_allocator_type(alloc))
+    {}
+
+    constexpr dense_hash_set(
+        size_type bucket_count, const hasher& hash, const allocator_type& alloc)
+        : map_(bucket_count, hash, map_allocator_type(alloc))
+    {}
+
+    constexpr explicit dense_hash_set(const allocator_type& alloc)
+        : map_(map_allocator_type(alloc))
+    {}
+
+    template <class InputIt>
+    constexpr dense_hash_set(
+        InputIt first, InputIt last, size_type bucket_count = default_bucket_count(),
+        const Hash& hash = Hash(), const key_equal& equal = key_equal(),
+        const allocator_type& alloc = allocator_type())
+        : dense_hash_set(bucket_count, hash, equal, alloc)
+    {
+        insert(first, last);
+    }
+
+    template <class InputIt>
+    constexpr dense_hash_set(
+        InputIt first, InputIt last, size_type bucket_count, const allocator_type& alloc)
+        : dense_hash_set(first, last, bucket_count, hasher(), key_equal(), alloc)
+    {}
+
+    template <class InputIt>
+    constexpr dense_hash_set(
+        InputIt first, InputIt last, size_type bucket_count, const hasher& hash,
+        const allocator_type& alloc)
+        : dense_hash_set(first, last, bucket_count, hash, key_equal(), alloc)
+    {}
+
+    constexpr dense_hash_set(const dense_hash_set& other) = default;
+
+    constexpr dense_hash_set(const dense_hash_set& other, const allocator_type& alloc)
+        : map_(other.map_, map_allocator_type(alloc))
+    {}
+
+    constexpr dense_hash_set(dense_hash_set&& other) noexcept(
+        std::is_nothrow_move_constructible_v<map_type>) = default;
+
+    constexpr dense_hash_set(dense_hash_set&& other, const allocator_type& alloc)
+        : map_(std::move(other.map_), map_allocator_type(alloc))
+    {}
+
+    constexpr dense_hash_set(
+        std::initializer_list<value_type> init, size_type bucket_count = default_bucket_count(),
+        const hasher& hash = hasher(), const key_equal& equal = key_equal(),
+        const allocator_type& alloc = allocator_type())
+        : dense_hash_set(init.begin(), init.end(), bucket_count, hash, equal, alloc)
+    {}
+
+    constexpr dense_hash_set(
+        std::initializer_list<value_type> init, size_type bucket_count, const allocator_type& alloc)
+        : dense_hash_set(init, bucket_count, hasher(), key_equal(), alloc)
+    {}
+
+    constexpr dense_hash_set(
+        std::initializer_list<value_type> init, size_type bucket_count, const hasher& hash,
+        const allocator_type& alloc)
+        : dense_hash_set(init, bucket_count, hash, key_equal(), alloc)
+    {}
+
+    // 2 missing constructors from https://cplusplus.github.io/LWG/issue2713
+    template <class InputIterator>
+    dense_hash_set(InputIterator first, InputIterator last, const allocator_type& alloc)
+        : dense_hash_set(first, last, default_bucket_count(), hasher(), key_equal(), alloc)
+    {}
+
+    dense_hash_set(std::initializer_list<value_type> init, const allocator_type& alloc)
+        : dense_hash_set(init, default_bucket_count(), hasher(), key_equal(), alloc)
+    {}
+
+    ~dense_hash_set() = default;
+
+    constexpr auto operator=(const dense_hash_set& other) -> dense_hash_set& = default;
+    constexpr auto operator=(dense_hash_set&& other) noexcept(
+        std::is_nothrow_move_assignable_v<map_type>) -> dense_hash_set& = default;
+
+    constexpr auto operator=(std::initializer_list<value_type> ilist) -> dense_hash_set&
+    {
+        clear();
+        insert(ilist.begin(), ilist.end());
+        return *this;
+    }
+
+    constexpr auto get_allocator() const -> allocator_type
+    {
+        return allocator_type(map_.get_allocator());
+    }
+
+    constexpr auto begin() const noexcept -> const_iterator { return map_.begin(); }
+
+    constexpr auto cbegin() const noexcept -> const_iterator { return map_.cbegin(); }
+
+    constexpr auto end() const noexcept -> const_iterator { return map_.end(); }
+
+    constexpr auto cend() const noexcept -> const_iterator { return map_.cend(); }
+
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return map_.empty(); }
+
+    constexpr auto size() const noexcept -> size_type { return map_.size(); }
+
+    constexpr auto max_size() const noexcept -> size_type { return map_.max_size(); }
+
+    constexpr void clear() noexcept { map_.clear(); }
+
+    constexpr void clear(keep_capacity_t tag) noexcept { map_.clear(tag); }
+
+    constexpr void shrink_to_fit() { map_.shrink_to_fit(); }
+
+    constexpr auto insert(const value_type& value) -> std::pair<iterator, bool>
+    {
+        return map_.try_emplace(value);
+    }
+
+    constexpr auto insert(value_type&& value) -> std::pair<iterator, bool>
+    {
+        return map_.try_emplace(std::move(value));
+    }
+
+    // Heterogeneous insert(): the key is only built from key if it is inserted.
+    template <class K, class Useless = std::enable_if_t<is_heterogeneous_insert_key<K>, K>>
+    constexpr auto insert(K&& key) -> std::pair<iterator, bool>
+    {
+        return map_.try_emplace(std::forward<K>(key));
+    }
+
+    constexpr auto insert(const_iterator /*hint*/, const value_type& value) -> iterator
+    {
+        return insert(value).first;
+    }
+
+    constexpr auto insert(const_iterator /*hint*/, value_type&& value) -> iterator
+    {
+        return insert(std::move(value)).first;
+    }
+
+    template <class K, class Useless = std::enable_if_t<is_heterogeneous_insert_key<K>, K>>
+    constexpr auto insert(const_iterator /*hint*/, K&& key) -> iterator
+    {
+        return insert(std::forward<K>(key)).first;
+    }
+
+    template <class InputIt>
+    constexpr void insert(InputIt first, InputIt last)
+    {
+        for (; first != last; ++first)
+        {
+            emplace(*first);
+        }
+    }
+
+    constexpr void insert(std::initializer_list<value_type> ilist)
+    {
+        insert(ilist.begin(), ilist.end());
+    }
+
+    auto insert(node_type&& nh) -> insert_return_type
+    {
+        auto result = map_.insert(std::move(nh));
+        return {result.position, result.inserted, std::move(result.node)};
+    }
+
+    auto insert(const_iterator /*hint*/, node_type&& nh) -> iterator
+    {
+        return insert(std::move(nh)).position;
+    }
+
+    // Keys that can be probed with are only built, in place, if they are inserted. Other arguments
+    // build a key first, which is moved in place.
+    template <class... Args>
+    auto emplace(Args&&... args) -> std::pair<iterator, bool>
+    {
+        if constexpr (is_probing_key<Args...>)
+        {
+            return map_.try_emplace(std::forward<Args>(args)...);
+        }
+        else
+        {
+            return map_.try_emplace(key_type(std::forward<Args>(args)...));
+        }
+    }
+
+    template <class... Args>
+    auto emplace_hint(const_iterator /*hint*/, Args&&... args) -> iterator
+    {
+        return emplace(std::forward<Args>(args)...).first;
+    }
+
+    auto extract(const_iterator position) -> node_type { return map_.extract(position); }
+
+    auto extract(const key_type& key) -> node_type { return map_.extract(key); }
+
+    template <class Hash2, class Pred2, class GrowthPolicy2>
+    void merge(dense_hash_set<Key, Hash2, Pred2, Allocator, GrowthPolicy2, StoragePolicy>& source)
+    {
+        map_.merge(source.map_);
+    }
+
+    template <class Hash2, class Pred2, class GrowthPolicy2>
+    void merge(dense_hash_set<Key, Hash2, Pred2, Allocator, GrowthPolicy2, StoragePolicy>&& source)
+    {
+        map_.merge(source.map_);
+    }
+
+    constexpr auto erase(const_iterator pos) -> iterator { return map_.erase(pos); }
+
+    constexpr auto erase(const_iterator first, const_iterator last) -> iterator
+    {
+        return map_.erase(first, last);
+    }
+
+    constexpr auto erase(const key_type& key) -> size_type { return map_.erase(key); }
+
+    template <
+        class K, class Useless = std::enable_if_t<
+                     details::is_transparent_lookup_v<Hash, Pred> &&
+                         details::is_heterogeneous_key_v<K, Key, iterator, const_iterator>,
+                     K>>
+    constexpr auto erase(const K& key) -> size_type
+    {
+        return map_.erase(key);
+    }
+
+    // Erases every key satisfying pred in a single pass, see dense_hash_map::erase_if().
+    template <class Predicate>
+    constexpr auto erase_if(Predicate pred) -> size_type
+    {
+        return map_.erase_if(std::move(pred));
+    }
+
+    template <class Executor, class Predicate>
+    auto erase_if(Executor&& executor, Predicate pred) -> size_type
+    {
+        return map_.erase_if(std::forward<Executor>(executor), std::move(pred));
+    }
+
+    constexpr void swap(dense_hash_set& other) noexcept(std::is_nothrow_swappable_v<map_type>)
+    {
+        map_.swap(other.map_);
+    }
+
+    constexpr auto count(const key_type& key) const -> size_type { return map_.count(key); }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto count(const K& key) const -> size_type
+    {
+        return map_.count(key);
+    }
+
+    constexpr auto find(const key_type& key) const -> const_iterator { return map_.find(key); }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto find(const K& key) const -> const_iterator
+    {
+        return map_.find(key);
+    }
+
+    constexpr auto contains(const key_type& key) const -> bool { return map_.contains(key); }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto contains(const K& key) const -> bool
+    {
+        return map_.contains(key);
+    }
+
+    constexpr auto equal_range(const key_type& key) const
+        -> std::pair<const_iterator, const_iterator>
+    {
+        return map_.equal_range(key);
+    }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto equal_range(const K& key) const -> std::pair<const_iterator, const_iterator>
+    {
+        return map_.equal_range(key);
+    }
+
+    // See dense_hash_map::find_batch().
+    template <class ForwardIt, class KeyOf, class OnResult>
+    void find_batch(ForwardIt first, ForwardIt last, KeyOf key_of, OnResult on_result) const
+    {
+        map_.find_batch(first, last, std::move(key_of), std::move(on_result));
+    }
+
+    constexpr auto begin(size_type n) const -> const_local_iterator { return map_.begin(n); }
+
+    constexpr auto cbegin(size_type n) const -> const_local_iterator { return map_.cbegin(n); }
+
+    constexpr auto end(size_type n) const -> const_local_iterator { return map_.end(n); }
+
+    constexpr auto cend(size_type n) const -> const_local_iterator { return map_.cend(n); }
+
+    constexpr auto bucket_count() const -> size_type { return map_.bucket_count(); }
+
+    constexpr auto max_bucket_count() const -> size_type { return map_.max_bucket_count(); }
+
+    constexpr auto bucket_size(size_type n) const -> size_type { return map_.bucket_size(n); }
+
+    constexpr auto bucket(const key_type& key) const -> size_type { return map_.bucket(key); }
+
+    constexpr auto probe_depth(const key_type& key) const -> size_type
+    {
+        return map_.probe_depth(key);
+    }
+
+    constexpr auto load_factor() const -> float { return map_.load_factor(); }
+
+    constexpr auto max_load_factor() const -> float { return map_.max_load_factor(); }
+
+    constexpr void max_load_factor(float ml) { map_.max_load_factor(ml); }
+
+    constexpr auto min_load_factor() const -> float { return map_.min_load_factor(); }
+
+    constexpr void min_load_factor(float ml) { map_.min_load_factor(ml); }
+
+    constexpr void rehash(size_type count) { map_.rehash(count); }
+
+    constexpr void reserve(std::size_t count) { map_.reserve(count); }
+
+    constexpr auto hash_function() const -> hasher { return map_.hash_function(); }
+
+    constexpr auto key_eq() const -> key_equal { return map_.key_eq(); }
+
+private:
+    static constexpr auto default_bucket_count() -> size_type
+    {
+        return details::linear_scan_capacity<details::set_storage_policy<StoragePolicy>>() > 0
+                   ? 0u
+                   : GrowthPolicy::minimum_capacity();
+    }
+
+    map_type map_;
+};
+
+template <
+    class Key, class Hash, class KeyEqual, class Allocator, class GrowthPolicy,
+    class StoragePolicy>
+constexpr auto operator==(
+    const dense_hash_set<Key, Hash, KeyEqual, Allocator, GrowthPolicy, StoragePolicy>& lhs,
+    const dense_hash_set<Key, Hash, KeyEqual, Allocator, GrowthPolicy, StoragePolicy>& rhs)
+    -> bool
+{
+    if (lhs.size() != rhs.size())
+    {
+        return false;
+    }
+
+    for (const auto& key : lhs)
+    {
+        if (!rhs.contains(key))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <
+    class Key, class Hash, class KeyEqual, class Allocator, class GrowthPolicy,
+    class StoragePolicy>
+constexpr auto operator!=(
+    const dense_hash_set<Key, Hash, KeyEqual, Allocator, GrowthPolicy, StoragePolicy>& lhs,
+    const dense_hash_set<Key, Hash, KeyEqual, Allocator, GrowthPolicy, StoragePolicy>& rhs)
+    -> bool
+{
+    return !(lhs == rhs);
+}
+
+template <
+    class InputIt, class Hash = std::hash<typename std::iterator_traits<InputIt>::value_type>,
+    class Pred = std::equal_to<typename std::iterator_traits<InputIt>::value_type>,
+    class Alloc = std::allocator<typename std::iterator_traits<InputIt>::value_type>,
+    class = details::require_input_iterator<InputIt>,
+    class = details::require_not_allocator_and_integral<Hash>,
+    class = details::require_not_allocator<Pred>, class = details::require_allocator<Alloc>>
+dense_hash_set(
+    InputIt, InputIt, std::size_t = 8, Hash = Hash(), Pred = Pred(), Alloc = Alloc())
+    ->dense_hash_set<typename std::iterator_traits<InputIt>::value_type, Hash, Pred, Alloc>;
+
+template <
+    class Key, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>,
+    class Alloc = std::allocator<Key>, class = details::require_not_allocator_and_integral<Hash>,
+    class = details::require_not_allocator<Pred>, class = details::require_allocator<Alloc>>
+dense_hash_set(
+    std::initializer_list<Key>, std::size_t = 8, Hash = Hash(), Pred = Pred(), Alloc = Alloc())
+    ->dense_hash_set<Key, Hash, Pred, Alloc>;
+
+template <
+    class InputIt, class Alloc, class = details::require_input_iterator<InputIt>,
+    class = details::require_allocator<Alloc>>
+dense_hash_set(InputIt, InputIt, std::size_t, Alloc)
+    ->dense_hash_set<
+        typename std::iterator_traits<InputIt>::value_type,
+        std::hash<typename std::iterator_traits<InputIt>::value_type>,
+        std::equal_to<typename std::iterator_traits<InputIt>::value_type>, Alloc>;
+
+template <class Key, class Alloc, class = details::require_allocator<Alloc>>
+dense_hash_set(std::initializer_list<Key>, std::size_t, Alloc)
+    ->dense_hash_set<Key, std::hash<Key>, std::equal_to<Key>, Alloc>;
+
+namespace pmr
+{
+    template <
+        class Key, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>,
+        class GrowthPolicy = details::power_of_two_growth_policy,
+        class StoragePolicy = details::vector_storage_policy>
+    using dense_hash_set = dense_hash_set<
+        Key, Hash, Pred, std::pmr::polymorphic_allocator<Key>, GrowthPolicy, StoragePolicy>;
+} // namespace pmr
+
+} // namespace jg
+
+namespace std
+{
+template <
+    class Key, class Hash, class Pred, class Allocator, class GrowthPolicy, class StoragePolicy>
+constexpr void swap(
+    jg::dense_hash_set<Key, Hash, Pred, Allocator, GrowthPolicy, StoragePolicy>& lhs,
+    jg::dense_hash_set<Key, Hash, Pred, Allocator, GrowthPolicy, StoragePolicy>&
+        rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+    lhs.swap(rhs);
+}
+
+template <
+    class Key, class Hash, class KeyEqual, class Alloc, class GrowthPolicy, class StoragePolicy,
+    class Pred>
+constexpr auto erase_if(
+    jg::dense_hash_set<Key, Hash, KeyEqual, Alloc, GrowthPolicy, StoragePolicy>& c, Pred pred) ->
+    typename jg::dense_hash_set<Key, Hash, KeyEqual, Alloc, GrowthPolicy, StoragePolicy>::size_type
+{
+    return c.erase_if(std::move(pred));
+}
+
+} // namespace std
+
+#endif // JG_DENSE_HASH_SET_HPP
@@ -0,0 +1,399 @@
+#ifndef JG_DENSE_INDEX_HPP
+#define JG_DENSE_INDEX_HPP
+
+#include "dense_hash_map.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jg
+{
+
+namespace details
+{
+    // The key extractor of make_dense_index(): the projection of the row of a container.
+    template <class Container, class Projection>
+    struct container_key_extractor
+    {
+        constexpr auto operator()(std::size_t row) const -> decltype(auto)
+        {
+            return std::invoke(projection, (*rows)[row]);
+        }
+
+        const Container* rows;
+        Projection projection;
+    };
+} // namespace details
+
+// A hash index over rows stored elsewhere, such as the columns of a table. It chains the rows in
+// buckets_ the way dense_hash_map chains its nodes, but its nodes are the row numbers themselves:
+// the index only holds the bucket heads and the next link of every row, and reads the key of a row
+// through key_of(row) whenever it needs it, instead of holding a copy of the keys.
+//
+// build() indexes the rows already there in one pass, optionally hashing them in parallel, and
+// append() indexes the rows added since. Several rows may have the same key. The index does not
+// know when the rows change: a row whose key changes must be indexed again with build().
+template <
+    class Key, class KeyExtractor, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>,
+    class Allocator = std::allocator<std::size_t>,
+    class GrowthPolicy = details::power_of_two_growth_policy>
+class dense_index
+{
+private:
+    using rows_container_type =
+        std::vector<std::size_t, details::rebind_alloc<Allocator, std::size_t>>;
+
+public:
+    using key_type = Key;
+    using key_extractor = KeyExtractor;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = typename details::key_equal<Hash, Pred, Key>::type;
+    using allocator_type = Allocator;
+
+    // The row returned by find() for a missing key.
+    static constexpr size_type npos = std::numeric_limits<size_type>::max();
+
+    explicit dense_index(
+        KeyExtractor key_of, const Hash& hash = Hash(), const key_equal& equal = key_equal(),
+        const allocator_type& alloc = allocator_type())
+        : buckets_(typename rows_container_type::allocator_type(alloc))
+        , next_(typename rows_container_type::allocator_type(alloc))
+        , key_of_(std::move(key_of))
+        , hash_(hash)
+        , equal_(equal)
+    {
+        buckets_.assign(GrowthPolicy::compute_closest_capacity(default_bucket_count()), npos);
+    }
+
+    dense_index(KeyExtractor key_of, const allocator_type& alloc)
+        : dense_index(std::move(key_of), Hash(), key_equal(), alloc)
+    {}
+
+    constexpr auto get_allocator() const -> allocator_type
+    {
+        return allocator_type(next_.get_allocator());
+    }
+
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return next_.empty(); }
+
+    // The number of rows indexed: the rows [0, size()).
+    constexpr auto size() const noexcept -> size_type { return next_.size(); }
+
+    constexpr auto max_size() const noexcept -> size_type
+    {
+        return std::min(next_.max_size(), static_cast<size_type>(npos - 1));
+    }
+
+    // Indexes the rows [0, row_count), in place of the rows indexed so far.
+    void build(size_type row_count)
+    {
+        prepare_build(row_count);
+        hash_rows(0u, row_count);
+        link_rows();
+    }
+
+    // Same as build(row_count), reading and hashing the keys in parallel, by chunks of
+    // details::parallel_chunk_size rows. executor(n, f) must call f(i) once for every i in [0, n),
+    // possibly concurrently, and return once all the calls are done. key_of and the hasher must be
+    // safe to call concurrently.
+    template <class Executor>
+    void build(size_type row_count, Executor&& executor)
+    {
+        prepare_build(row_count);
+
+        const size_type chunk_count =
+            (row_count + details::parallel_chunk_size - 1) / details::parallel_chunk_size;
+
+        executor(chunk_count, [&](size_type chunk) {
+            const size_type first = chunk * details::parallel_chunk_size;
+            hash_rows(first, std::min(row_count, first + details::parallel_chunk_size));
+        });
+
+        link_rows();
+    }
+
+    // Indexes the row_count rows following the indexed ones, once they are added to the storage.
+    void append(size_type row_count = 1u)
+    {
+        const auto first = size();
+        next_.resize(first + row_count);
+
+        if (size() > bucket_count() * max_load_factor())
+        {
+            rebuild_buckets(details::grow_bucket_count<GrowthPolicy>(bucket_count()));
+            return;
+        }
+
+        for (auto row = first; row < size(); ++row)
+        {
+            link(row, bucket_of(key_of_(row)));
+        }
+    }
+
+    // Forgets all the rows, keeping the buckets.
+    void clear() noexcept
+    {
+        next_.clear();
+        std::fill(buckets_.begin(), buckets_.end(), npos);
+    }
+
+    // A row whose key is key, or npos if there is none. With several of them, which one is
+    // unspecified.
+    auto find(const key_type& key) const -> size_type { return do_find(key); }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    auto find(const K& key) const -> size_type
+    {
+        return do_find(key);
+    }
+
+    auto contains(const key_type& key) const -> bool { return find(key) != npos; }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    auto contains(const K& key) const -> bool
+    {
+        return find(key) != npos;
+    }
+
+    // The number of rows whose key is key.
+    auto count(const key_type& key) const -> size_type { return do_count(key); }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    auto count(const K& key) const -> size_type
+    {
+        return do_count(key);
+    }
+
+    // Calls f(row) on every row whose key is key, in no particular order.
+    template <class F>
+    void for_each_row(const key_type& key, F f) const
+    {
+        do_for_each_row(key, f);
+    }
+
+    template <
+        class K, class F,
+        class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    void for_each_row(const K& key, F f) const
+    {
+        do_for_each_row(key, f);
+    }
+
+    void swap(dense_index& other) noexcept(
+        std::allocator_traits<Allocator>::is_always_equal::value&&
+            std::is_nothrow_swappable_v<KeyExtractor>&& std::is_nothrow_swappable_v<Hash>&&
+                std::is_nothrow_swappable_v<key_equal>)
+    {
+        using std::swap;
+        swap(buckets_, other.buckets_);
+        swap(next_, other.next_);
+        swap(key_of_, other.key_of_);
+        swap(hash_, other.hash_);
+        swap(equal_, other.equal_);
+        swap(max_load_factor_, other.max_load_factor_);
+    }
+
+    constexpr auto bucket_count() const noexcept -> size_type { return buckets_.size(); }
+
+    constexpr auto load_factor() const -> float
+    {
+        return size() / static_cast<float>(bucket_count());
+    }
+
+    constexpr auto max_load_factor() const -> float { return max_load_factor_; }
+
+    void max_load_factor(float ml)
+    {
+        assert(ml > 0.0f && "The max load factor must be greater than 0.0f.");
+        max_load_factor_ = ml;
+        rehash(8);
+    }
+
+    void rehash(size_type count) { rebuild_buckets(count); }
+
+    void reserve(size_type count)
+    {
+        rehash(static_cast<size_type>(std::ceil(count / max_load_factor())));
+        next_.reserve(count);
+    }
+
+    constexpr auto hash_function() const -> hasher { return hash_; }
+
+    constexpr auto key_eq() const -> key_equal { return equal_; }
+
+private:
+    static constexpr auto default_bucket_count() -> size_type
+    {
+        return GrowthPolicy::minimum_capacity();
+    }
+
+    template <class K>
+    auto bucket_of(const K& key) const -> size_type
+    {
+        return GrowthPolicy::compute_index(hash_(key), bucket_count());
+    }
+
+    template <class K>
+    auto do_find(const K& key) const -> size_type
+    {
+        if (buckets_.empty())
+        {
+            return npos;
+        }
+
+        for (auto row = buckets_[bucket_of(key)]; row != npos; row = next_[row])
+        {
+            if (equal_(key_of_(row), key))
+            {
+                return row;
+            }
+        }
+
+        return npos;
+    }
+
+    template <class K>
+    auto do_count(const K& key) const -> size_type
+    {
+        size_type count = 0;
+        do_for_each_row(key, [&count](size_type /*row*/) { ++count; });
+        return count;
+    }
+
+    template <class K, class F>
+    void do_for_each_row(const K& key, F&& f) const
+    {
+        if (buckets_.empty())
+        {
+            return;
+        }
+
+        for (auto row = buckets_[bucket_of(key)]; row != npos; row = next_[row])
+        {
+            if (equal_(key_of_(row), key))
+            {
+                f(row);
+            }
+        }
+    }
+
+    constexpr void link(size_type row, size_type bucket) noexcept
+    {
+        next_[row] = std::exchange(buckets_[bucket], row);
+    }
+
+    // Sizes the buckets for row_count rows, without linking them.
+    void prepare_build(size_type row_count)
+    {
+        next_.resize(row_count);
+        const auto count = fitting_bucket_count(bucket_count());
+
+        if (count != bucket_count())
+        {
+            buckets_.resize(count);
+        }
+    }
+
+    // The closest bucket count to count that holds the rows under the max load factor.
+    auto fitting_bucket_count(size_type count) const -> size_type
+    {
+        count = std::max(default_bucket_count(), count);
+        count = std::max(count, static_cast<size_type>(size() / max_load_factor()));
+        return GrowthPolicy::compute_closest_capacity(count);
+    }
+
+    // Stores the bucket of each row of [first, last) in its next link, for link_rows().
+    void hash_rows(size_type first, size_type last)
+    {
+        for (auto row = first; row < last; ++row)
+        {
+            next_[row] = bucket_of(key_of_(row));
+        }
+    }
+
+    // Rebuilds the chains from the buckets left in the next links by hash_rows(). Linking the rows
+    // from the last one down chains them in increasing order.
+    void link_rows() noexcept
+    {
+        std::fill(buckets_.begin(), buckets_.end(), npos);
+
+        for (auto row = size(); row > 0; --row)
+        {
+            link(row - 1, next_[row - 1]);
+        }
+    }
+
+    void rebuild_buckets(size_type count)
+    {
+        count = fitting_bucket_count(count);
+
+        if (count == bucket_count())
+        {
+            return;
+        }
+
+        buckets_.resize(count);
+        hash_rows(0u, size());
+        link_rows();
+    }
+
+    rows_container_type buckets_;
+    rows_container_type next_;
+    KeyExtractor key_of_;
+    Hash hash_;
+    key_equal equal_;
+    float max_load_factor_ = details::policy_max_load_factor<GrowthPolicy>();
+};
+
+// An index of the rows of a random-access container, by the key projection(row) gives them,
+// built over the rows already there. The index reads the rows through a pointer to the container,
+// which must outlive it; call append() as rows are added to the container.
+template <class Container, class Projection>
+auto make_dense_index(const Container& rows, Projection projection)
+{
+    using extractor_type = details::container_key_extractor<Container, Projection>;
+    using key_type = std::decay_t<
+        std::invoke_result_t<const Projection&, const typename Container::value_type&>>;
+
+    dense_index<key_type, extractor_type> index(extractor_type{&rows, std::move(projection)});
+    index.build(rows.size());
+    return index;
+}
+
+namespace pmr
+{
+    template <
+        class Key, class KeyExtractor, class Hash = std::hash<Key>,
+        class Pred = std::equal_to<Key>, class GrowthPolicy = details::power_of_two_growth_policy>
+    using dense_index = dense_index<
+        Key, KeyExtractor, Hash, Pred, std::pmr::polymorphic_allocator<std::size_t>, GrowthPolicy>;
+} // namespace pmr
+
+} // namespace jg
+
+namespace std
+{
+template <
+    class Key, class KeyExtractor, class Hash, class Pred, class Allocator, class GrowthPolicy>
+void swap(
+    jg::dense_index<Key, KeyExtractor, Hash, Pred, Allocator, GrowthPolicy>& lhs,
+    jg::dense_index<Key, KeyExtractor, Hash, Pred, Allocator, GrowthPolicy>& rhs) noexcept(
+        noexcept(lhs.swap(rhs)))
+{
+    lhs.swap(rhs);
+}
+} // namespace std
+
+#endif // JG_DENSE_INDEX_HPP
@@ -0,0 +1,351 @@
+#ifndef JG_DENSE_LRU_CACHE_HPP
+#define JG_DENSE_LRU_CACHE_HPP
+
+#include "dense_hash_map.hpp"
+
+#include <cassert>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace jg
+{
+
+namespace details
+{
+    // The mapped value of a dense_lru_cache entry, along with the node indices of its neighbours
+    // in recency order. Passes the allocator of the cache on to the value.
+    template <class T, class Index>
+    struct lru_entry
+    {
+        template <class... Args>
+        constexpr lru_entry(Index newer, Index older, Args&&... args)
+            : value(std::forward<Args>(args)...), newer(newer), older(older)
+        {}
+
+        template <class Allocator, class... Args>
+        constexpr lru_entry(
+            std::allocator_arg_t, const Allocator& alloc, Index newer, Index older, Args&&... args)
+            : value(make_using_allocator<T>(alloc, std::forward<Args>(args)...))
+            , newer(newer)
+            , older(older)
+        {}
+
+        template <class Allocator>
+        constexpr lru_entry(std::allocator_arg_t, const Allocator& alloc, const lru_entry& other)
+            : value(make_using_allocator<T>(alloc, other.value))
+            , newer(other.newer)
+            , older(other.older)
+        {}
+
+        template <class Allocator>
+        constexpr lru_entry(std::allocator_arg_t, const Allocator& alloc, lru_entry&& other)
+            : value(make_using_allocator<T>(alloc, std::move(other.value)))
+            , newer(other.newer)
+            , older(other.older)
+        {}
+
+        constexpr lru_entry(const lru_entry& other) = default;
+        constexpr lru_entry(lru_entry&& other) = default;
+        constexpr auto operator=(const lru_entry& other) -> lru_entry& = default;
+        constexpr auto operator=(lru_entry&& other) -> lru_entry& = default;
+
+        T value;
+        Index newer;
+        Index older;
+    };
+} // namespace details
+
+// A cache holding at most capacity() entries, evicting the least recently used one to make room
+// for a new one. The recency list is threaded through the nodes of a dense_hash_map as the indices
+// of the previous and next entries, so the whole cache lives in the node and bucket arrays: no
+// allocation per entry, and no pointer to chase but the ones of the hash chains. Both arrays are
+// sized for the capacity up front. An evicted entry is replaced by the last node, whose neighbours
+// are relinked in O(1).
+template <
+    class Key, class T, class Hash = std::hash<Key>, class Pred = std::equal_to<Key>,
+    class Allocator = std::allocator<std::pair<const Key, T>>,
+    class GrowthPolicy = details::power_of_two_growth_policy>
+class dense_lru_cache
+{
+private:
+    using index_type = std::size_t;
+    using entry_type = details::lru_entry<T, index_type>;
+    using map_type = dense_hash_map<
+        Key, entry_type, Hash, Pred,
+        details::rebind_alloc<Allocator, std::pair<const Key, entry_type>>, GrowthPolicy>;
+
+    static inline constexpr index_type end_index = std::numeric_limits<index_type>::max();
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using size_type = typename map_type::size_type;
+    using hasher = Hash;
+    using key_equal = typename map_type::key_equal;
+    using allocator_type = Allocator;
+
+    constexpr explicit dense_lru_cache(
+        size_type capacity, const Hash& hash = Hash(), const key_equal& equal = key_equal(),
+        const allocator_type& alloc = allocator_type())
+        : map_(0u, hash, equal, typename map_type::allocator_type(alloc)), capacity_(capacity)
+    {
+        assert(capacity > 0 && "The capacity of a cache must be greater than 0.");
+
+        // A put() inserts before it evicts.
+        map_.reserve(capacity + 1);
+    }
+
+    constexpr dense_lru_cache(size_type capacity, const allocator_type& alloc)
+        : dense_lru_cache(capacity, hasher(), key_equal(), alloc)
+    {}
+
+    constexpr dense_lru_cache(const dense_lru_cache& other) = default;
+
+    constexpr dense_lru_cache(dense_lru_cache&& other) noexcept(
+        std::is_nothrow_move_constructible_v<map_type>)
+        : map_(std::move(other.map_))
+        , capacity_(other.capacity_)
+        , most_recent_(std::exchange(other.most_recent_, end_index))
+        , least_recent_(std::exchange(other.least_recent_, end_index))
+    {}
+
+    ~dense_lru_cache() = default;
+
+    constexpr auto operator=(const dense_lru_cache& other) -> dense_lru_cache& = default;
+
+    constexpr auto operator=(dense_lru_cache&& other) noexcept(
+        std::is_nothrow_move_assignable_v<map_type>) -> dense_lru_cache&
+    {
+        map_ = std::move(other.map_);
+        capacity_ = other.capacity_;
+        most_recent_ = std::exchange(other.most_recent_, end_index);
+        least_recent_ = std::exchange(other.least_recent_, end_index);
+        return *this;
+    }
+
+    constexpr auto get_allocator() const -> allocator_type
+    {
+        return allocator_type(map_.get_allocator());
+    }
+
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return map_.empty(); }
+
+    constexpr auto size() const noexcept -> size_type { return map_.size(); }
+
+    constexpr auto capacity() const noexcept -> size_type { return capacity_; }
+
+    // Empties the cache, keeping the memory sized for its capacity.
+    constexpr void clear() noexcept
+    {
+        map_.clear(keep_capacity);
+        most_recent_ = end_index;
+        least_recent_ = end_index;
+    }
+
+    // The value of key, made the most recently used, or nullptr if key is not cached.
+    constexpr auto get(const key_type& key) -> T* { return do_get(key); }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto get(const K& key) -> T*
+    {
+        return do_get(key);
+    }
+
+    // The value of key, or nullptr if key is not cached. Leaves the recency order as it is.
+    constexpr auto peek(const key_type& key) const -> const T* { return do_peek(key); }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto peek(const K& key) const -> const T*
+    {
+        return do_peek(key);
+    }
+
+    constexpr auto contains(const key_type& key) const -> bool { return map_.contains(key); }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto contains(const K& key) const -> bool
+    {
+        return map_.contains(key);
+    }
+
+    // Looks up the key of every element of [first, last) in order, as get() would, and calls
+    // on_result(it, value) with the value found, or nullptr. The lookups are batched through
+    // dense_hash_map::find_batch(), which overlaps their cache misses in a large cache.
+    template <class ForwardIt, class OnResult>
+    void get_many(ForwardIt first, ForwardIt last, OnResult on_result)
+    {
+        map_.find_batch(
+            first, last, [](const auto& key) -> const auto& { return key; },
+            [&](ForwardIt it, typename map_type::const_iterator position) {
+                if (position == map_.cend())
+                {
+                    on_result(it, static_cast<T*>(nullptr));
+                    return;
+                }
+
+                const auto index = static_cast<index_type>(position - map_.cbegin());
+                promote(index);
+                on_result(it, &entry(index).value);
+            });
+    }
+
+    // Gives key the value, inserting it if it is not cached, and makes it the most recently used.
+    // Inserting into a full cache evicts the least recently used entry.
+    template <class K, class M>
+    auto put(K&& key, M&& value) -> T&
+    {
+        auto [it, inserted] =
+            map_.try_emplace(std::forward<K>(key), end_index, end_index, std::forward<M>(value));
+        auto index = static_cast<index_type>(it - map_.begin());
+
+        if (!inserted)
+        {
+            it->second.value = std::forward<M>(value);
+            promote(index);
+            return it->second.value;
+        }
+
+        link_front(index);
+
+        if (size() > capacity_)
+        {
+            index = erase_index(least_recent_, index);
+        }
+
+        return entry(index).value;
+    }
+
+    constexpr auto erase(const key_type& key) -> size_type { return do_erase(key); }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto erase(const K& key) -> size_type
+    {
+        return do_erase(key);
+    }
+
+    // The least recently used entry, the next one to be evicted. The cache must not be empty.
+    constexpr auto least_recent() const -> std::pair<const Key&, const T&>
+    {
+        assert(!empty() && "An empty cache has no least recently used entry.");
+        const auto& pair = *std::next(map_.begin(), static_cast<difference_type>(least_recent_));
+        return {pair.first, pair.second.value};
+    }
+
+    constexpr auto hash_function() const -> hasher { return map_.hash_function(); }
+
+    constexpr auto key_eq() const -> key_equal { return map_.key_eq(); }
+
+private:
+    using difference_type = typename map_type::difference_type;
+
+    constexpr auto entry(index_type index) -> entry_type&
+    {
+        return std::next(map_.begin(), static_cast<difference_type>(index))->second;
+    }
+
+    template <class K>
+    constexpr auto do_get(const K& key) -> T*
+    {
+        const auto it = map_.find(key);
+
+        if (it == map_.end())
+        {
+            return nullptr;
+        }
+
+        promote(static_cast<index_type>(it - map_.begin()));
+        return &it->second.value;
+    }
+
+    template <class K>
+    constexpr auto do_peek(const K& key) const -> const T*
+    {
+        const auto it = map_.find(key);
+        return it == map_.end() ? nullptr : &it->second.value;
+    }
+
+    template <class K>
+    constexpr auto do_erase(const K& key) -> size_type
+    {
+        const auto it = map_.find(key);
+
+        if (it == map_.end())
+        {
+            return 0u;
+        }
+
+        erase_index(static_cast<index_type>(it - map_.begin()), end_index);
+        return 1u;
+    }
+
+    constexpr void promote(index_type index)
+    {
+        if (index != most_recent_)
+        {
+            unlink(index);
+            link_front(index);
+        }
+    }
+
+    constexpr void unlink(index_type index)
+    {
+        const auto& e = entry(index);
+        (e.newer == end_index ? most_recent_ : entry(e.newer).older) = e.older;
+        (e.older == end_index ? least_recent_ : entry(e.older).newer) = e.newer;
+    }
+
+    constexpr void link_front(index_type index)
+    {
+        auto& e = entry(index);
+        e.newer = end_index;
+        e.older = most_recent_;
+        (most_recent_ == end_index ? least_recent_ : entry(most_recent_).newer) = index;
+        most_recent_ = index;
+    }
+
+    // Erases the entry at index, the last node of the map taking its place. Returns where the node
+    // at tracked is afterwards.
+    constexpr auto erase_index(index_type index, index_type tracked) -> index_type
+    {
+        const auto last = static_cast<index_type>(size() - 1);
+        unlink(index);
+        map_.erase(std::next(map_.begin(), static_cast<difference_type>(index)));
+
+        if (index == last)
+        {
+            return tracked;
+        }
+
+        // The last node moved to index: its neighbours still refer to last.
+        const auto& moved = entry(index);
+        (moved.newer == end_index ? most_recent_ : entry(moved.newer).older) = index;
+        (moved.older == end_index ? least_recent_ : entry(moved.older).newer) = index;
+
+        return tracked == last ? index : tracked;
+    }
+
+    map_type map_;
+    size_type capacity_;
+    index_type most_recent_ = end_index;
+    index_type least_recent_ = end_index;
+};
+
+} // namespace jg
+
+namespace std
+{
+template <class T, class Index, class Allocator>
+struct uses_allocator<jg::details::lru_entry<T, Index>, Allocator> : uses_allocator<T, Allocator>
+{
+};
+} // namespace std
+
+#endif // JG_DENSE_LRU_CACHE_HPP
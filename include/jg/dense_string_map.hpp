@@ -0,0 +1,375 @@
+#ifndef JG_DENSE_STRING_MAP_HPP
+#define JG_DENSE_STRING_MAP_HPP
+
+#include "dense_hash_map.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace jg
+{
+
+namespace details
+{
+    // What a dense_string_map looks its keys up with: the text of the key, its hash, and the bytes
+    // of the arena the stored keys point into.
+    struct string_arena_probe
+    {
+        std::string_view text;
+        std::size_t hash;
+        const char* arena;
+    };
+
+    // A probe for a key to insert, which appends the text to the arena when the key is built.
+    template <class Arena>
+    struct string_arena_insertion : string_arena_probe
+    {
+        Arena* target;
+    };
+
+    // The key of a dense_string_map node: the hash of the text, and its offset and length in the
+    // arena packed in a single word. The position is mutable as compacting the arena moves the
+    // text without changing the key.
+    class string_arena_key
+    {
+    public:
+        static constexpr std::size_t length_bits = 24;
+        static constexpr std::uint64_t max_length = (std::uint64_t{1} << length_bits) - 1;
+        static constexpr std::uint64_t max_offset = (std::uint64_t{1} << (64 - length_bits)) - 1;
+
+        template <class Arena>
+        explicit string_arena_key(const string_arena_insertion<Arena>& insertion)
+            : hash_(insertion.hash)
+        {
+            auto& arena = *insertion.target;
+            const auto offset = arena.size();
+
+            if (insertion.text.size() > max_length || offset > max_offset)
+            {
+#ifdef JG_NO_EXCEPTION
+                std::abort();
+#else
+                throw std::length_error("The key or the arena of a dense_string_map is too long.");
+#endif
+            }
+
+            arena.insert(arena.end(), insertion.text.begin(), insertion.text.end());
+            position_ = pack(offset, insertion.text.size());
+        }
+
+        constexpr auto hash() const noexcept -> std::size_t { return hash_; }
+
+        constexpr auto offset() const noexcept -> std::size_t
+        {
+            return static_cast<std::size_t>(position_ >> length_bits);
+        }
+
+        constexpr auto length() const noexcept -> std::size_t
+        {
+            return static_cast<std::size_t>(position_ & max_length);
+        }
+
+        constexpr auto text(const char* arena) const noexcept -> std::string_view
+        {
+            return {arena + offset(), length()};
+        }
+
+        // Points the key at a copy of its text, at offset in the arena.
+        constexpr void move_to(std::size_t offset) const noexcept
+        {
+            position_ = pack(offset, length());
+        }
+
+    private:
+        static constexpr auto pack(std::size_t offset, std::size_t length) noexcept
+            -> std::uint64_t
+        {
+            return (static_cast<std::uint64_t>(offset) << length_bits) | length;
+        }
+
+        std::size_t hash_;
+        mutable std::uint64_t position_ = 0;
+    };
+
+    // Hashes the keys of a dense_string_map with the hash they were stored with.
+    struct string_arena_hash
+    {
+        using is_transparent = void;
+
+        constexpr auto operator()(const string_arena_key& key) const noexcept -> std::size_t
+        {
+            return key.hash();
+        }
+
+        constexpr auto operator()(const string_arena_probe& probe) const noexcept -> std::size_t
+        {
+            return probe.hash;
+        }
+    };
+
+    // Compares a stored key to a probe by hash, length, then bytes. The stored keys are distinct:
+    // two of them are equal when they are the same text of the arena.
+    struct string_arena_equal
+    {
+        using is_transparent = void;
+
+        constexpr auto operator()(const string_arena_key& lhs, const string_arena_key& rhs) const
+            noexcept -> bool
+        {
+            return lhs.offset() == rhs.offset() && lhs.length() == rhs.length();
+        }
+
+        auto operator()(const string_arena_key& key, const string_arena_probe& probe) const noexcept
+            -> bool
+        {
+            return key.hash() == probe.hash && key.length() == probe.text.size() &&
+                   (key.length() == 0u ||
+                    std::memcmp(probe.arena + key.offset(), probe.text.data(), key.length()) == 0);
+        }
+    };
+} // namespace details
+
+// A hash map from strings to T that keeps the bytes of all its keys in a single append-only arena:
+// the nodes of the underlying dense_hash_map only hold the hash of their key, and its offset and
+// length packed in a word, instead of a std::string and, past the small string buffer, a heap
+// allocation of its own. Loading n keys thus costs O(log n) allocations, for the nodes, the
+// buckets and the arena alike.
+//
+// The keys are taken and given back as std::string_view, which stay valid until the next insertion
+// or erasure. The text of an erased key stays in the arena until the garbage outweighs the live
+// keys, then the arena is compacted in one pass over the nodes; shrink_to_fit() compacts it too.
+template <
+    class T, class Hash = std::hash<std::string_view>,
+    class Allocator = std::allocator<std::pair<const std::string_view, T>>,
+    class GrowthPolicy = details::power_of_two_growth_policy>
+class dense_string_map
+{
+private:
+    using arena_type = std::vector<char, details::rebind_alloc<Allocator, char>>;
+    using key_type_ = details::string_arena_key;
+    using map_type = dense_hash_map<
+        key_type_, T, details::string_arena_hash, details::string_arena_equal,
+        details::rebind_alloc<Allocator, std::pair<const key_type_, T>>, GrowthPolicy>;
+    using insertion_type = details::string_arena_insertion<arena_type>;
+
+public:
+    using key_type = std::string_view;
+    using mapped_type = T;
+    using size_type = typename map_type::size_type;
+    using hasher = Hash;
+    using allocator_type = Allocator;
+
+    constexpr dense_string_map() : dense_string_map(Hash()) {}
+
+    constexpr explicit dense_string_map(
+        const Hash& hash, const allocator_type& alloc = allocator_type())
+        : map_(typename map_type::allocator_type(alloc))
+        , arena_(typename arena_type::allocator_type(alloc))
+        , hash_(hash)
+    {}
+
+    constexpr explicit dense_string_map(const allocator_type& alloc)
+        : dense_string_map(Hash(), alloc)
+    {}
+
+    constexpr auto get_allocator() const -> allocator_type
+    {
+        return allocator_type(map_.get_allocator());
+    }
+
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return map_.empty(); }
+
+    constexpr auto size() const noexcept -> size_type { return map_.size(); }
+
+    // The bytes of the arena, the text of the erased keys not compacted yet included.
+    constexpr auto arena_size() const noexcept -> size_type { return arena_.size(); }
+
+    // The bytes of the text of the keys.
+    constexpr auto key_bytes() const noexcept -> size_type { return key_bytes_; }
+
+    // Makes room for count keys of key_bytes bytes in all.
+    void reserve(size_type count, size_type key_bytes = 0u)
+    {
+        map_.reserve(count);
+        arena_.reserve(arena_.size() + key_bytes);
+    }
+
+    void clear() noexcept
+    {
+        map_.clear();
+        arena_.clear();
+        key_bytes_ = 0u;
+    }
+
+    // Compacts the arena and gives back the unused memory.
+    void shrink_to_fit()
+    {
+        compact();
+        map_.shrink_to_fit();
+        arena_.shrink_to_fit();
+    }
+
+    // Inserts key with a value built from args, unless it is there. The text of key is only copied
+    // to the arena when it is inserted.
+    template <class... Args>
+    auto try_emplace(std::string_view key, Args&&... args) -> std::pair<T&, bool>
+    {
+        const auto [it, inserted] = map_.try_emplace(insertion(key), std::forward<Args>(args)...);
+
+        if (inserted)
+        {
+            key_bytes_ += key.size();
+        }
+
+        return {it->second, inserted};
+    }
+
+    template <class M>
+    auto insert_or_assign(std::string_view key, M&& value) -> std::pair<T&, bool>
+    {
+        auto result = try_emplace(key, std::forward<M>(value));
+
+        if (!result.second)
+        {
+            result.first = std::forward<M>(value);
+        }
+
+        return result;
+    }
+
+    auto operator[](std::string_view key) -> T& { return try_emplace(key).first; }
+
+    // The value of key, or nullptr if key is not there.
+    auto find(std::string_view key) -> T*
+    {
+        const auto it = map_.find(probe(key));
+        return it == map_.end() ? nullptr : &it->second;
+    }
+
+    auto find(std::string_view key) const -> const T*
+    {
+        const auto it = map_.find(probe(key));
+        return it == map_.end() ? nullptr : &it->second;
+    }
+
+    auto at(std::string_view key) -> T& { return *checked(find(key)); }
+
+    auto at(std::string_view key) const -> const T& { return *checked(find(key)); }
+
+    auto contains(std::string_view key) const -> bool { return find(key) != nullptr; }
+
+    auto erase(std::string_view key) -> size_type
+    {
+        const auto it = map_.find(probe(key));
+
+        if (it == map_.end())
+        {
+            return 0u;
+        }
+
+        map_.erase(it);
+        key_bytes_ -= key.size();
+
+        if (arena_.size() - key_bytes_ > key_bytes_)
+        {
+            compact();
+        }
+
+        return 1u;
+    }
+
+    // Calls f(key, value) on every entry.
+    template <class F>
+    void for_each(F f)
+    {
+        for (auto& [key, value] : map_)
+        {
+            f(key.text(arena_.data()), value);
+        }
+    }
+
+    template <class F>
+    void for_each(F f) const
+    {
+        for (const auto& [key, value] : map_)
+        {
+            f(key.text(arena_.data()), value);
+        }
+    }
+
+    constexpr auto hash_function() const -> hasher { return hash_; }
+
+private:
+    auto probe(std::string_view key) const -> details::string_arena_probe
+    {
+        return {key, hash_(key), arena_.data()};
+    }
+
+    auto insertion(std::string_view key) -> insertion_type
+    {
+        return {probe(key), &arena_};
+    }
+
+    template <class Pointer>
+    static auto checked(Pointer value) -> Pointer
+    {
+        if (value == nullptr)
+        {
+#ifdef JG_NO_EXCEPTION
+            std::abort();
+#else
+            throw std::out_of_range("The specified key does not exists in this map.");
+#endif
+        }
+
+        return value;
+    }
+
+    // Copies the text of the keys to a new arena, in the order of the nodes.
+    void compact()
+    {
+        if (arena_.size() == key_bytes_)
+        {
+            return;
+        }
+
+        arena_type compacted(arena_.get_allocator());
+        compacted.reserve(key_bytes_);
+
+        for (const auto& [key, value] : map_)
+        {
+            const auto text = key.text(arena_.data());
+            key.move_to(compacted.size());
+            compacted.insert(compacted.end(), text.begin(), text.end());
+        }
+
+        arena_.swap(compacted);
+    }
+
+    map_type map_;
+    arena_type arena_;
+    size_type key_bytes_ = 0u;
+    Hash hash_;
+};
+
+namespace pmr
+{
+    template <
+        class T, class Hash = std::hash<std::string_view>,
+        class GrowthPolicy = details::power_of_two_growth_policy>
+    using dense_string_map = dense_string_map<
+        T, Hash, std::pmr::polymorphic_allocator<std::pair<const std::string_view, T>>,
+        GrowthPolicy>;
+} // namespace pmr
+
+} // namespace jg
+
+#endif // JG_DENSE_STRING_MAP_HPP
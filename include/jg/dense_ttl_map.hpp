@@ -0,0 +1,349 @@
+#ifndef JG_DENSE_TTL_MAP_HPP
+#define JG_DENSE_TTL_MAP_HPP
+
+#include "dense_hash_map.hpp"
+#include "details/timing_wheel.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jg
+{
+
+namespace details
+{
+    // The mapped value of a dense_ttl_map entry, along with its deadline and its location in the
+    // timing wheel. Passes the allocator of the map on to the value.
+    template <class T, class TimePoint>
+    struct ttl_entry
+    {
+        template <class... Args>
+        constexpr ttl_entry(TimePoint deadline, Args&&... args)
+            : value(std::forward<Args>(args)...), deadline(deadline)
+        {}
+
+        template <class Allocator, class... Args>
+        constexpr ttl_entry(
+            std::allocator_arg_t, const Allocator& alloc, TimePoint deadline, Args&&... args)
+            : value(make_using_allocator<T>(alloc, std::forward<Args>(args)...)), deadline(deadline)
+        {}
+
+        template <class Allocator>
+        constexpr ttl_entry(std::allocator_arg_t, const Allocator& alloc, const ttl_entry& other)
+            : value(make_using_allocator<T>(alloc, other.value))
+            , deadline(other.deadline)
+            , location(other.location)
+        {}
+
+        template <class Allocator>
+        constexpr ttl_entry(std::allocator_arg_t, const Allocator& alloc, ttl_entry&& other)
+            : value(make_using_allocator<T>(alloc, std::move(other.value)))
+            , deadline(other.deadline)
+            , location(other.location)
+        {}
+
+        constexpr ttl_entry(const ttl_entry& other) = default;
+        constexpr ttl_entry(ttl_entry&& other) = default;
+        constexpr auto operator=(const ttl_entry& other) -> ttl_entry& = default;
+        constexpr auto operator=(ttl_entry&& other) -> ttl_entry& = default;
+
+        T value;
+        TimePoint deadline;
+        wheel_location location;
+    };
+} // namespace details
+
+// A hash map whose entries expire at a deadline. The deadlines are stored next to the values in
+// the nodes of a dense_hash_map, whose indices are bucketed by deadline in a hierarchical
+// details::timing_wheel. expire(now) turns the wheel to now to find the due entries without
+// looking at the others. When they are at least one out of details::bulk_erase_ratio, it erases
+// them all in a single erase_if() pass, which compacts the nodes and rebuilds the buckets once,
+// rather than hashing the key and walking the chain of each of them.
+//
+// An entry past its deadline is reported missing by the lookups until expire() reaps it, but still
+// counts in size(). The time is given by the caller, as Clock::time_point values. The wheel turns
+// in ticks of the resolution of the map, but the deadlines are compared exactly.
+template <
+    class Key, class T, class Clock = std::chrono::steady_clock, class Hash = std::hash<Key>,
+    class Pred = std::equal_to<Key>, class Allocator = std::allocator<std::pair<const Key, T>>,
+    class GrowthPolicy = details::power_of_two_growth_policy>
+class dense_ttl_map
+{
+public:
+    using clock = Clock;
+    using time_point = typename Clock::time_point;
+    using duration = typename Clock::duration;
+
+private:
+    using entry_type = details::ttl_entry<T, time_point>;
+    using map_type = dense_hash_map<
+        Key, entry_type, Hash, Pred,
+        details::rebind_alloc<Allocator, std::pair<const Key, entry_type>>, GrowthPolicy>;
+    using wheel_type = details::timing_wheel<Allocator>;
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using size_type = typename map_type::size_type;
+    using hasher = Hash;
+    using key_equal = typename map_type::key_equal;
+    using allocator_type = Allocator;
+
+    dense_ttl_map() : dense_ttl_map(std::chrono::milliseconds(1)) {}
+
+    explicit dense_ttl_map(
+        duration resolution, const Hash& hash = Hash(), const key_equal& equal = key_equal(),
+        const allocator_type& alloc = allocator_type())
+        : map_(0u, hash, equal, typename map_type::allocator_type(alloc))
+        , wheel_(alloc)
+        , resolution_(resolution)
+    {
+        assert(resolution > duration::zero() && "The resolution must be positive.");
+    }
+
+    explicit dense_ttl_map(const allocator_type& alloc)
+        : dense_ttl_map(std::chrono::milliseconds(1), hasher(), key_equal(), alloc)
+    {}
+
+    constexpr auto get_allocator() const -> allocator_type
+    {
+        return allocator_type(map_.get_allocator());
+    }
+
+    [[nodiscard]] constexpr auto empty() const noexcept -> bool { return map_.empty(); }
+
+    // The number of entries, counting the expired ones expire() has not reaped yet.
+    constexpr auto size() const noexcept -> size_type { return map_.size(); }
+
+    constexpr auto resolution() const noexcept -> duration { return resolution_; }
+
+    void reserve(size_type count) { map_.reserve(count); }
+
+    void clear() noexcept
+    {
+        map_.clear();
+        wheel_.clear();
+    }
+
+    // Gives key the value and the deadline, inserting it if it is not there.
+    template <class K, class M>
+    auto put(K&& key, M&& value, time_point deadline) -> T&
+    {
+        auto [it, inserted] =
+            map_.try_emplace(std::forward<K>(key), deadline, std::forward<M>(value));
+        const auto node = index_of(it);
+
+        if (!inserted)
+        {
+            it->second.value = std::forward<M>(value);
+            it->second.deadline = deadline;
+            wheel_.erase(node, location_of());
+        }
+
+        wheel_.insert(node, ticks(deadline), location_of());
+        return it->second.value;
+    }
+
+    // The value of key, or nullptr if key is not there or expired at now.
+    constexpr auto get(const key_type& key, time_point now) -> T* { return do_get(map_, key, now); }
+
+    constexpr auto get(const key_type& key, time_point now) const -> const T*
+    {
+        return do_get(map_, key, now);
+    }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto get(const K& key, time_point now) -> T*
+    {
+        return do_get(map_, key, now);
+    }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto get(const K& key, time_point now) const -> const T*
+    {
+        return do_get(map_, key, now);
+    }
+
+    constexpr auto contains(const key_type& key, time_point now) const -> bool
+    {
+        return get(key, now) != nullptr;
+    }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    constexpr auto contains(const K& key, time_point now) const -> bool
+    {
+        return get(key, now) != nullptr;
+    }
+
+    // Moves the deadline of key, if it has not expired at now. Returns its value, or nullptr.
+    auto refresh(const key_type& key, time_point now, time_point deadline) -> T*
+    {
+        const auto it = map_.find(key);
+
+        if (it == map_.end() || it->second.deadline <= now)
+        {
+            return nullptr;
+        }
+
+        const auto node = index_of(it);
+        it->second.deadline = deadline;
+        wheel_.erase(node, location_of());
+        wheel_.insert(node, ticks(deadline), location_of());
+        return &it->second.value;
+    }
+
+    // Erases key, expired or not.
+    auto erase(const key_type& key) -> size_type { return do_erase(key); }
+
+    template <
+        class K, class Useless = std::enable_if_t<details::is_transparent_lookup_v<Hash, Pred>, K>>
+    auto erase(const K& key) -> size_type
+    {
+        return do_erase(key);
+    }
+
+    // Erases all the entries expired at now, and returns how many.
+    auto expire(time_point now) -> size_type
+    {
+        std::vector<std::size_t, details::rebind_alloc<Allocator, std::size_t>> due(
+            get_allocator());
+
+        wheel_.advance(
+            ticks(now), location_of(),
+            [&](std::size_t node) { return entry(node).deadline <= now; },
+            [&](std::size_t node) { due.push_back(node); });
+
+        if (due.empty())
+        {
+            return 0u;
+        }
+
+        if (due.size() * details::bulk_erase_ratio >= size())
+        {
+            for (auto node : due)
+            {
+                entry(node).location = details::wheel_location{};
+            }
+
+            map_.erase_if([](const auto& pair) {
+                return pair.second.location.slot == details::wheel_location{}.slot;
+            });
+
+            // The remaining nodes moved to the front.
+            std::size_t node = 0;
+
+            for (const auto& pair : map_)
+            {
+                wheel_.relocate(node++, pair.second.location);
+            }
+
+            return due.size();
+        }
+
+        // From the last node down, so that the last node moving into the hole of an erased one is
+        // never one still to erase.
+        std::sort(due.begin(), due.end(), std::greater<>());
+
+        for (auto node : due)
+        {
+            erase_node(node);
+        }
+
+        return due.size();
+    }
+
+    constexpr auto hash_function() const -> hasher { return map_.hash_function(); }
+
+    constexpr auto key_eq() const -> key_equal { return map_.key_eq(); }
+
+private:
+    // The tick of time in the wheel: the number of periods of the resolution since the epoch.
+    constexpr auto ticks(time_point time) const noexcept -> std::uint64_t
+    {
+        const auto since_epoch = time.time_since_epoch();
+        return since_epoch <= duration::zero()
+                   ? 0u
+                   : static_cast<std::uint64_t>(since_epoch / resolution_);
+    }
+
+    template <class Iterator>
+    constexpr auto index_of(const Iterator& it) -> std::size_t
+    {
+        return static_cast<std::size_t>(it - map_.begin());
+    }
+
+    constexpr auto entry(std::size_t node) -> entry_type&
+    {
+        return std::next(map_.begin(), static_cast<typename map_type::difference_type>(node))
+            ->second;
+    }
+
+    constexpr auto location_of()
+    {
+        return [this](std::size_t node) -> details::wheel_location& {
+            return entry(node).location;
+        };
+    }
+
+    template <class Map, class K>
+    static constexpr auto do_get(Map& map, const K& key, time_point now)
+    {
+        const auto it = map.find(key);
+        return it == map.end() || it->second.deadline <= now ? nullptr : &it->second.value;
+    }
+
+    template <class K>
+    auto do_erase(const K& key) -> size_type
+    {
+        const auto it = map_.find(key);
+
+        if (it == map_.end())
+        {
+            return 0u;
+        }
+
+        const auto node = index_of(it);
+        wheel_.erase(node, location_of());
+        erase_node(node);
+        return 1u;
+    }
+
+    // Erases the node, already out of the wheel. The last node takes its place.
+    void erase_node(std::size_t node)
+    {
+        const auto last = size() - 1;
+        map_.erase(std::next(map_.begin(), static_cast<typename map_type::difference_type>(node)));
+
+        if (node != last)
+        {
+            wheel_.relocate(node, entry(node).location);
+        }
+    }
+
+    map_type map_;
+    wheel_type wheel_;
+    duration resolution_;
+};
+
+} // namespace jg
+
+namespace std
+{
+template <class T, class TimePoint, class Allocator>
+struct uses_allocator<jg::details::ttl_entry<T, TimePoint>, Allocator>
+    : uses_allocator<T, Allocator>
+{
+};
+} // namespace std
+
+#endif // JG_DENSE_TTL_MAP_HPP
@@ -14,7 +14,7 @@ class bucket_iterator
 {
     using nodes_container_type = std::conditional_t<isConst, const Container, Container>;
     using node_index_type = node_index_t<Key, T>;
-    using projected_type = std::pair<std::conditional_t<projectToConstKey, const Key, Key>, T>;
+    using projected_type = projected_t<typename Container::value_type, projectToConstKey>;
 
 public:
     using iterator_category = std::forward_iterator_tag;
@@ -9,11 +9,41 @@
 namespace jg::details
 {
 
+// Where the nodes end, for the iterators that have to skip tombstones without running past it.
+template <class SubIterator, bool skipsTombstones>
+class sub_iterator_end
+{
+public:
+    constexpr sub_iterator_end() = default;
+    constexpr explicit sub_iterator_end(const SubIterator& /*end*/) noexcept {}
+};
+
+template <class SubIterator>
+class sub_iterator_end<SubIterator, true>
+{
+public:
+    constexpr sub_iterator_end() = default;
+    constexpr explicit sub_iterator_end(const SubIterator& end) noexcept : end_(end) {}
+
+    constexpr auto sub_end() const noexcept -> const SubIterator& { return end_; }
+
+private:
+    SubIterator end_;
+};
+
+// Iterates over the nodes of a map, in order. With nodes that can be tombstones, the tombstones
+// are skipped and the iterator is only bidirectional: the random access operators would count them.
 template <class Key, class T, class Container, bool isConst, bool projectToConstKey>
 class dense_hash_map_iterator
+    : private sub_iterator_end<
+          std::conditional_t<
+              isConst, typename Container::const_iterator, typename Container::iterator>,
+          has_tombstones_v<typename Container::value_type>>
 {
     friend dense_hash_map_iterator<Key, T, Container, true, projectToConstKey>;
 
+    static constexpr bool skips_tombstones = has_tombstones_v<typename Container::value_type>;
+
 public:
     using entries_container_type = Container;
     using sub_iterator_type = typename std::conditional<
@@ -21,9 +51,11 @@ public:
         typename entries_container_type::iterator>::type;
     using sub_iterator_type_traits = std::iterator_traits<sub_iterator_type>;
     using projected_type =
-        std::pair<typename std::conditional<projectToConstKey, const Key, Key>::type, T>;
+        projected_t<typename entries_container_type::value_type, projectToConstKey>;
 
-    using iterator_category = typename sub_iterator_type_traits::iterator_category;
+    using iterator_category = std::conditional_t<
+        skips_tombstones, std::bidirectional_iterator_tag,
+        typename sub_iterator_type_traits::iterator_category>;
     using value_type = std::conditional_t<isConst, const projected_type, projected_type>;
     using difference_type = typename sub_iterator_type_traits::difference_type;
     using reference = value_type&;
@@ -31,10 +63,16 @@ public:
 
     constexpr dense_hash_map_iterator() noexcept : sub_iterator_(sub_iterator_type{}) {}
 
+    template <bool DepSkips = skips_tombstones, std::enable_if_t<!DepSkips, int> = 0>
     explicit constexpr dense_hash_map_iterator(sub_iterator_type it) noexcept
         : sub_iterator_(std::move(it))
     {}
 
+    // it must point to a live node, or to end.
+    constexpr dense_hash_map_iterator(sub_iterator_type it, const sub_iterator_type& end) noexcept
+        : end_base(end), sub_iterator_(std::move(it))
+    {}
+
     constexpr dense_hash_map_iterator(const dense_hash_map_iterator& other) noexcept = default;
     constexpr dense_hash_map_iterator(dense_hash_map_iterator&& other) noexcept = default;
 
@@ -46,7 +84,7 @@ public:
     template <bool DepIsConst = isConst, std::enable_if_t<DepIsConst, int> = 0>
     constexpr dense_hash_map_iterator(
         const dense_hash_map_iterator<Key, T, Container, false, projectToConstKey>& other) noexcept
-        : sub_iterator_(other.sub_iterator_)
+        : end_base(other.const_sub_end()), sub_iterator_(other.sub_iterator_)
     {}
 
     constexpr auto operator*() const noexcept -> reference
@@ -76,56 +114,105 @@ public:
     constexpr auto operator++() noexcept -> dense_hash_map_iterator&
     {
         ++sub_iterator_;
+
+        if constexpr (skips_tombstones)
+        {
+            while (sub_iterator_ != this->sub_end() && sub_iterator_->is_tombstone())
+            {
+                ++sub_iterator_;
+            }
+        }
+
         return *this;
     }
 
-    constexpr auto operator++(int) noexcept -> dense_hash_map_iterator { return {sub_iterator_++}; }
+    constexpr auto operator++(int) noexcept -> dense_hash_map_iterator
+    {
+        auto old = *this;
+        ++(*this);
+        return old;
+    }
 
+    // Unless the iterator is begin(), a live node precedes it.
     constexpr auto operator--() noexcept -> dense_hash_map_iterator&
     {
         --sub_iterator_;
+
+        if constexpr (skips_tombstones)
+        {
+            while (sub_iterator_->is_tombstone())
+            {
+                --sub_iterator_;
+            }
+        }
+
         return *this;
     }
 
-    constexpr auto operator--(int) noexcept -> dense_hash_map_iterator { return {sub_iterator_--}; }
+    constexpr auto operator--(int) noexcept -> dense_hash_map_iterator
+    {
+        auto old = *this;
+        --(*this);
+        return old;
+    }
 
     constexpr auto operator[](difference_type index) const noexcept -> reference
     {
+        static_assert(!skips_tombstones, "Iterators skipping tombstones are not random access.");
+
         if constexpr (projectToConstKey)
         {
-            return sub_iterator_[index]->pair.const_key_pair();
+            return sub_iterator_[index].pair.const_key_pair();
         }
         else
         {
-            return sub_iterator_[index]->pair.pair();
+            return sub_iterator_[index].pair.pair();
         }
     }
 
     constexpr auto operator+=(difference_type n) noexcept -> dense_hash_map_iterator&
     {
+        static_assert(!skips_tombstones, "Iterators skipping tombstones are not random access.");
         sub_iterator_ += n;
         return *this;
     }
 
     constexpr auto operator+(difference_type n) const noexcept -> dense_hash_map_iterator
     {
-        return {sub_iterator_ + n};
+        static_assert(!skips_tombstones, "Iterators skipping tombstones are not random access.");
+        return dense_hash_map_iterator{sub_iterator_ + n};
     }
 
     constexpr auto operator-=(difference_type n) noexcept -> dense_hash_map_iterator&
     {
+        static_assert(!skips_tombstones, "Iterators skipping tombstones are not random access.");
         sub_iterator_ -= n;
         return *this;
     }
 
     constexpr auto operator-(difference_type n) const noexcept -> dense_hash_map_iterator
     {
-        return {sub_iterator_ - n};
+        static_assert(!skips_tombstones, "Iterators skipping tombstones are not random access.");
+        return dense_hash_map_iterator{sub_iterator_ - n};
     }
 
     constexpr auto sub_iterator() const -> const sub_iterator_type& { return sub_iterator_; }
 
 private:
+    using end_base = sub_iterator_end<sub_iterator_type, skips_tombstones>;
+
+    constexpr auto const_sub_end() const noexcept
+    {
+        if constexpr (skips_tombstones)
+        {
+            return typename entries_container_type::const_iterator{this->sub_end()};
+        }
+        else
+        {
+            return typename entries_container_type::const_iterator{};
+        }
+    }
+
     sub_iterator_type sub_iterator_;
 };
 
@@ -189,6 +276,9 @@ constexpr auto operator-(
     const dense_hash_map_iterator<Key, T, Container, isConst2, projectToConstKey>& rhs) noexcept ->
     typename dense_hash_map_iterator<Key, T, Container, isConst, projectToConstKey>::difference_type
 {
+    static_assert(
+        !has_tombstones_v<typename Container::value_type>,
+        "Iterators skipping tombstones are not random access.");
     return lhs.sub_iterator() - rhs.sub_iterator();
 }
 
@@ -199,7 +289,11 @@ constexpr auto operator+(
     const dense_hash_map_iterator<Key, T, Container, isConst, projectToConstKey>& it) noexcept
     -> dense_hash_map_iterator<Key, T, Container, isConst, projectToConstKey>
 {
-    return {n + it.sub_iterator()};
+    static_assert(
+        !has_tombstones_v<typename Container::value_type>,
+        "Iterators skipping tombstones are not random access.");
+    return dense_hash_map_iterator<Key, T, Container, isConst, projectToConstKey>{
+        n + it.sub_iterator()};
 }
 
 } // namespace jg::details
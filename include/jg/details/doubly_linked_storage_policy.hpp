@@ -0,0 +1,82 @@
+#ifndef JG_DOUBLY_LINKED_STORAGE_POLICY_HPP
+#define JG_DOUBLY_LINKED_STORAGE_POLICY_HPP
+
+#include "node.hpp"
+#include "vector_storage_policy.hpp"
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace jg::details
+{
+
+// Tag of a prev link referring to a bucket rather than to a node: set on the node heading a chain.
+template <class Key, class T>
+constexpr node_index_t<Key, T> bucket_link_flag = ~(node_end_index<Key, T> >> 1);
+
+template <class Key, class T>
+constexpr auto is_bucket_link(node_index_t<Key, T> link) -> bool
+{
+    return (link & bucket_link_flag<Key, T>) != 0;
+}
+
+// Node of the doubly_linked_storage_policy: prev is the index of the previous node of the chain,
+// or the bucket index tagged with bucket_link_flag for the head of a chain.
+template <class Key, class T, class Pair = std::pair<Key, T>>
+struct doubly_linked_node : disable_copy_constructor<Pair>,
+                            disable_copy_assignment<Pair>,
+                            disable_move_constructor<Pair>,
+                            disable_move_assignment<Pair>
+{
+    template <class... Args>
+    constexpr doubly_linked_node(node_index_t<Key, T> next, Args&&... args)
+        : next(next), pair(std::forward<Args>(args)...)
+    {}
+
+    template <class Allocator, class... Args>
+    constexpr doubly_linked_node(
+        std::allocator_arg_t, const Allocator& alloc, node_index_t<Key, T> next, Args&&... args)
+        : next(next), pair(std::allocator_arg, alloc, std::forward<Args>(args)...)
+    {}
+
+    template <class Allocator>
+    constexpr doubly_linked_node(
+        std::allocator_arg_t, const Allocator& alloc, const doubly_linked_node& other)
+        : next(other.next), prev(other.prev), pair(std::allocator_arg, alloc, other.pair.pair())
+    {}
+
+    template <class Allocator>
+    constexpr doubly_linked_node(
+        std::allocator_arg_t, const Allocator& alloc, doubly_linked_node&& other)
+        : next(other.next)
+        , prev(other.prev)
+        , pair(std::allocator_arg, alloc, std::move(other.pair.pair()))
+    {}
+
+    node_index_t<Key, T> next = node_end_index<Key, T>;
+    node_index_t<Key, T> prev = node_end_index<Key, T>;
+    key_value_pair_t<Key, T> pair;
+};
+
+// Each node also links back to its predecessor, or to its bucket: erasing by iterator unlinks the
+// node and relinks the last node moved into its place without walking any chain or rehashing any
+// key, at the cost of one more index per node.
+template <class Base = vector_storage_policy>
+struct doubly_linked_storage_policy : Base
+{
+    template <class Key, class T, class Allocator>
+    using node = doubly_linked_node<Key, T>;
+};
+
+} // namespace jg::details
+
+namespace std
+{
+template <class Key, class T, class Allocator>
+struct uses_allocator<jg::details::doubly_linked_node<Key, T>, Allocator> : true_type
+{
+};
+} // namespace std
+
+#endif // JG_DOUBLY_LINKED_STORAGE_POLICY_HPP
@@ -0,0 +1,236 @@
+#ifndef JG_HANDLE_STORAGE_POLICY_HPP
+#define JG_HANDLE_STORAGE_POLICY_HPP
+
+#include "node.hpp"
+#include "type_traits.hpp"
+#include "vector_storage_policy.hpp"
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jg::details
+{
+
+// A handle to an entry of a map with the handle_storage_policy: the slot of the entry in the
+// handle table and the generation of that slot when the handle was taken.
+struct entry_handle
+{
+    std::size_t slot = std::numeric_limits<std::size_t>::max();
+    std::size_t generation = 0;
+
+    friend constexpr auto operator==(const entry_handle& lhs, const entry_handle& rhs) -> bool
+    {
+        return lhs.slot == rhs.slot && lhs.generation == rhs.generation;
+    }
+
+    friend constexpr auto operator!=(const entry_handle& lhs, const entry_handle& rhs) -> bool
+    {
+        return !(lhs == rhs);
+    }
+};
+
+// Node of the handle_storage_policy: slot is the index of the node in the handle table.
+template <class Key, class T, class Pair = std::pair<Key, T>>
+struct handle_node : disable_copy_constructor<Pair>,
+                     disable_copy_assignment<Pair>,
+                     disable_move_constructor<Pair>,
+                     disable_move_assignment<Pair>
+{
+    template <class... Args>
+    constexpr handle_node(node_index_t<Key, T> next, Args&&... args)
+        : next(next), pair(std::forward<Args>(args)...)
+    {}
+
+    template <class Allocator, class... Args>
+    constexpr handle_node(
+        std::allocator_arg_t, const Allocator& alloc, node_index_t<Key, T> next, Args&&... args)
+        : next(next), pair(std::allocator_arg, alloc, std::forward<Args>(args)...)
+    {}
+
+    template <class Allocator>
+    constexpr handle_node(std::allocator_arg_t, const Allocator& alloc, const handle_node& other)
+        : next(other.next), slot(other.slot), pair(std::allocator_arg, alloc, other.pair.pair())
+    {}
+
+    template <class Allocator>
+    constexpr handle_node(std::allocator_arg_t, const Allocator& alloc, handle_node&& other)
+        : next(other.next)
+        , slot(other.slot)
+        , pair(std::allocator_arg, alloc, std::move(other.pair.pair()))
+    {}
+
+    node_index_t<Key, T> next = node_end_index<Key, T>;
+    std::size_t slot = 0;
+    key_value_pair_t<Key, T> pair;
+};
+
+template <class Node>
+using detect_handle_slot = decltype(std::declval<Node&>().slot);
+
+// Whether the nodes know their slot in a handle table, see handle_storage_policy.
+template <class Node>
+inline constexpr bool has_handle_slot_v = is_detected<detect_handle_slot, Node>::value;
+
+// The slots of the handles of a map: the index of the node of each slot and its generation, bumped
+// when the entry is erased so that the handles taken before go stale. The free slots are chained
+// through their node index, and reused most recently freed first.
+template <class Allocator, bool = true>
+class handle_table
+{
+    struct slot_type
+    {
+        std::size_t node;
+        std::size_t generation;
+    };
+
+    using slots_container_type =
+        std::vector<slot_type, typename std::allocator_traits<Allocator>::template rebind_alloc<
+                                   slot_type>>;
+
+public:
+    static inline constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+    constexpr handle_table() = default;
+
+    constexpr explicit handle_table(const Allocator& alloc)
+        : slots_(typename slots_container_type::allocator_type(alloc))
+    {}
+
+    constexpr handle_table(const handle_table&) = default;
+
+    constexpr handle_table(const handle_table& other, const Allocator& alloc)
+        : slots_(other.slots_, typename slots_container_type::allocator_type(alloc))
+        , free_head_(other.free_head_)
+    {}
+
+    constexpr handle_table(handle_table&& other) noexcept
+        : slots_(std::move(other.slots_)), free_head_(std::exchange(other.free_head_, npos))
+    {}
+
+    constexpr handle_table(handle_table&& other, const Allocator& alloc)
+        : slots_(std::move(other.slots_), typename slots_container_type::allocator_type(alloc))
+        , free_head_(std::exchange(other.free_head_, npos))
+    {}
+
+    constexpr auto operator=(const handle_table&) -> handle_table& = default;
+
+    constexpr auto operator=(handle_table&& other) noexcept(
+        std::is_nothrow_move_assignable_v<slots_container_type>) -> handle_table&
+    {
+        slots_ = std::move(other.slots_);
+        free_head_ = std::exchange(other.free_head_, npos);
+        return *this;
+    }
+
+    constexpr void swap(handle_table& other) noexcept(
+        std::is_nothrow_swappable_v<slots_container_type>)
+    {
+        using std::swap;
+        swap(slots_, other.slots_);
+        swap(free_head_, other.free_head_);
+    }
+
+    // Makes sure a slot is free, so that the next claim_slot() cannot throw.
+    constexpr void prepare_slot()
+    {
+        if (free_head_ == npos)
+        {
+            slots_.push_back({npos, 0});
+            free_head_ = slots_.size() - 1;
+        }
+    }
+
+    // Gives a free slot to the node at index, after prepare_slot().
+    constexpr auto claim_slot(std::size_t index) noexcept -> std::size_t
+    {
+        const auto slot = free_head_;
+        free_head_ = slots_[slot].node;
+        slots_[slot].node = index;
+        return slot;
+    }
+
+    constexpr void move_slot(std::size_t slot, std::size_t index) noexcept
+    {
+        slots_[slot].node = index;
+    }
+
+    constexpr void release_slot(std::size_t slot) noexcept
+    {
+        ++slots_[slot].generation;
+        slots_[slot].node = std::exchange(free_head_, slot);
+    }
+
+    // Releases all the slots.
+    constexpr void release_slots() noexcept
+    {
+        free_head_ = npos;
+
+        for (auto slot = slots_.size(); slot > 0; --slot)
+        {
+            ++slots_[slot - 1].generation;
+            slots_[slot - 1].node = std::exchange(free_head_, slot - 1);
+        }
+    }
+
+    constexpr auto handle_at(std::size_t slot) const noexcept -> entry_handle
+    {
+        return {slot, slots_[slot].generation};
+    }
+
+    // The index of the node of handle, or npos if the handle is stale.
+    constexpr auto node_of(const entry_handle& handle) const noexcept -> std::size_t
+    {
+        if (handle.slot >= slots_.size() || slots_[handle.slot].generation != handle.generation)
+        {
+            return npos;
+        }
+
+        return slots_[handle.slot].node;
+    }
+
+private:
+    slots_container_type slots_;
+    std::size_t free_head_ = npos;
+};
+
+// The maps whose nodes have no slot keep no handle table.
+template <class Allocator>
+class handle_table<Allocator, false>
+{
+public:
+    constexpr handle_table() = default;
+
+    constexpr explicit handle_table(const Allocator& /*alloc*/) {}
+
+    constexpr handle_table(const handle_table& /*other*/, const Allocator& /*alloc*/) {}
+
+    constexpr void swap(handle_table& /*other*/) noexcept {}
+};
+
+// Each node also records its slot in a table of handles, which the map keeps pointing at the node
+// through every move: a handle taken with handle_of() keeps resolving to its entry through
+// insertions, rehashes and the erasure of other entries, in two array loads and without hashing,
+// and tells when its entry was erased. Costs one more index per node and two per entry in the
+// table.
+template <class Base = vector_storage_policy>
+struct handle_storage_policy : Base
+{
+    template <class Key, class T, class Allocator>
+    using node = handle_node<Key, T>;
+};
+
+} // namespace jg::details
+
+namespace std
+{
+template <class Key, class T, class Allocator>
+struct uses_allocator<jg::details::handle_node<Key, T>, Allocator> : true_type
+{
+};
+} // namespace std
+
+#endif // JG_HANDLE_STORAGE_POLICY_HPP
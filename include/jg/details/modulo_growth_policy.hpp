@@ -0,0 +1,55 @@
+#ifndef JG_MODULO_GROWTH_POLICY_HPP
+#define JG_MODULO_GROWTH_POLICY_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+namespace jg::details
+{
+
+// Buckets of any count, indexed by a modulo: slower than the mask of power_of_two_growth_policy but
+// lets buckets_ grow by BucketsNum / BucketsDen and nodes_ by NodesNum / NodesDen, both of which
+// can be smaller than 2.
+template <
+    std::size_t BucketsNum, std::size_t BucketsDen, std::size_t NodesNum = BucketsNum,
+    std::size_t NodesDen = BucketsDen>
+struct modulo_growth_policy
+{
+    static_assert(BucketsNum > BucketsDen && NodesNum > NodesDen, "Growth factors must be > 1.");
+
+    static constexpr auto compute_index(std::size_t hash, std::size_t capacity) -> std::size_t
+    {
+        return hash % capacity;
+    }
+
+    static constexpr auto compute_closest_capacity(std::size_t min_capacity) -> std::size_t
+    {
+        return std::max<std::size_t>(min_capacity, 1u);
+    }
+
+    static constexpr auto minimum_capacity() -> std::size_t { return 8u; }
+
+    static constexpr auto grow_bucket_count(std::size_t bucket_count) -> std::size_t
+    {
+        return std::max(bucket_count + 1, bucket_count * BucketsNum / BucketsDen);
+    }
+
+    // Next capacity of nodes_ when it is full, instead of the container's own growth.
+    static constexpr auto grow_node_capacity(std::size_t capacity) -> std::size_t
+    {
+        return std::max({capacity + 1, minimum_capacity(), capacity * NodesNum / NodesDen});
+    }
+
+    static constexpr float default_max_load_factor = 0.875f;
+};
+
+// Memory-lean preset: buckets grow by 1.5x, nodes by 1.25x, and there is about one bucket per
+// entry.
+struct lean_growth_policy : modulo_growth_policy<3, 2, 5, 4>
+{
+    static constexpr float default_max_load_factor = 1.0f;
+};
+
+} // namespace jg::details
+
+#endif // JG_MODULO_GROWTH_POLICY_HPP
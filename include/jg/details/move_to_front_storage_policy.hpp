@@ -0,0 +1,22 @@
+#ifndef JG_MOVE_TO_FRONT_STORAGE_POLICY_HPP
+#define JG_MOVE_TO_FRONT_STORAGE_POLICY_HPP
+
+#include "vector_storage_policy.hpp"
+
+namespace jg::details
+{
+
+// Self-organizing chains for skewed lookups: a node found by find() or at() on a non-const map is
+// moved to the front of its chain, so that the hottest keys end up being probed first. Only the
+// links change: iterators and references stay valid, but walking a bucket with local iterators
+// while looking keys up may skip or revisit entries. Lookups through a const map leave the chains
+// untouched.
+template <class Base = vector_storage_policy>
+struct move_to_front_storage_policy : Base
+{
+    static constexpr bool move_to_front_on_hit = true;
+};
+
+} // namespace jg::details
+
+#endif // JG_MOVE_TO_FRONT_STORAGE_POLICY_HPP
@@ -1,6 +1,8 @@
 #ifndef JG_NODE_HPP
 #define JG_NODE_HPP
 
+#include "type_traits.hpp"
+
 #include <limits>
 #include <memory>
 #include <type_traits>
@@ -13,6 +15,14 @@ namespace jg::details
 template <class Key, class T, class Pair = std::pair<Key, T>>
 struct node;
 
+// Mapped type of the dense_hash_map underlying a dense_hash_set, whose nodes only hold a key.
+struct no_mapped_value
+{
+};
+
+template <class T>
+inline constexpr bool is_set_v = std::is_same_v<T, no_mapped_value>;
+
 template <class Key, class T>
 using node_index_t = typename std::vector<node<Key, T>>::size_type;
 
@@ -230,6 +240,40 @@ struct node : disable_copy_constructor<Pair>,
     key_value_pair_t<Key, T> pair;
 };
 
+// What the iterators over a container of nodes point to: the key/value pair of the nodes, with a
+// const key when projectToConstKey is set, or the key alone for set nodes.
+template <class Node, bool projectToConstKey>
+using projected_t = std::remove_reference_t<std::conditional_t<
+    projectToConstKey, decltype(std::declval<Node&>().pair.const_key_pair()),
+    decltype(std::declval<Node&>().pair.pair())>>;
+
+template <class Node>
+using detect_tombstone = decltype(std::declval<const Node&>().is_tombstone());
+
+// Whether erased nodes can stay in place as tombstones, see ordered_storage_policy.
+template <class Node>
+inline constexpr bool has_tombstones_v = is_detected<detect_tombstone, Node>::value;
+
+// Uses-allocator construction of a T, see [allocator.uses.construction], for the mapped types that
+// pass the allocator of their container on to a member.
+template <class T, class Allocator, class... Args>
+constexpr auto make_using_allocator(const Allocator& alloc, Args&&... args) -> T
+{
+    if constexpr (!std::uses_allocator_v<T, Allocator>)
+    {
+        return T(std::forward<Args>(args)...);
+    }
+    else if constexpr (std::is_constructible_v<
+                           T, std::allocator_arg_t, const Allocator&, Args&&...>)
+    {
+        return T(std::allocator_arg, alloc, std::forward<Args>(args)...);
+    }
+    else
+    {
+        return T(std::forward<Args>(args)..., alloc);
+    }
+}
+
 } // namespace jg::details
 
 namespace std
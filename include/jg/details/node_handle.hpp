@@ -0,0 +1,167 @@
+#ifndef JG_NODE_HANDLE_HPP
+#define JG_NODE_HANDLE_HPP
+
+#include "node.hpp"
+
+#include <cassert>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace jg
+{
+template <
+    class Key, class T, class Hash, class Pred, class Allocator, class GrowthPolicy,
+    class StoragePolicy>
+class dense_hash_map;
+} // namespace jg
+
+namespace jg::details
+{
+
+// Owns an entry extracted from a dense_hash_map, until it is inserted in a map using an equal
+// allocator. The node is moved out of the nodes_ array as a whole: with the out_of_line storage
+// policy, the pair itself never moves.
+template <class Node, class Key, class T, class Allocator>
+class node_handle
+{
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using allocator_type = Allocator;
+
+    node_handle() noexcept {}
+
+    node_handle(node_handle&& other) noexcept(std::is_nothrow_move_constructible_v<Node>)
+    {
+        take(other);
+    }
+
+    auto operator=(node_handle&& other) noexcept(std::is_nothrow_move_constructible_v<Node>)
+        -> node_handle&
+    {
+        if (this != &other)
+        {
+            reset();
+            take(other);
+        }
+
+        return *this;
+    }
+
+    ~node_handle() { reset(); }
+
+    [[nodiscard]] auto empty() const noexcept -> bool { return !alloc_.has_value(); }
+
+    explicit operator bool() const noexcept { return alloc_.has_value(); }
+
+    auto get_allocator() const -> allocator_type
+    {
+        assert(!empty() && "get_allocator() called on an empty node handle.");
+        return *alloc_;
+    }
+
+    // The key may be modified before inserting the node back, unless JG_STRICT_TYPE_PUNNING forces
+    // the pair to be stored with a const key.
+    auto key() const -> decltype(auto)
+    {
+        assert(!empty() && "key() called on an empty node handle.");
+
+        if constexpr (is_set_v<T>)
+        {
+            return (node_.pair.pair());
+        }
+        else
+        {
+            return (node_.pair.pair().first);
+        }
+    }
+
+    // The value of a dense_hash_set node, which is its key.
+    template <class U = T, std::enable_if_t<is_set_v<U>, int> = 0>
+    auto value() const -> key_type&
+    {
+        return key();
+    }
+
+    auto mapped() const -> mapped_type&
+    {
+        assert(!empty() && "mapped() called on an empty node handle.");
+        return node_.pair.pair().second;
+    }
+
+    void swap(node_handle& other) noexcept(std::is_nothrow_move_constructible_v<Node>)
+    {
+        node_handle tmp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+private:
+    template <class, class, class, class, class, class, class>
+    friend class jg::dense_hash_map;
+
+    node_handle(Node&& node, const allocator_type& alloc)
+    {
+        ::new (static_cast<void*>(std::addressof(node_))) Node(std::move(node));
+        alloc_.emplace(alloc);
+    }
+
+    // Moves the node out and leaves the handle empty.
+    auto release() -> Node
+    {
+        Node node(std::move(node_));
+        reset();
+        return node;
+    }
+
+    void reset() noexcept
+    {
+        if (alloc_)
+        {
+            node_.~Node();
+            alloc_.reset();
+        }
+    }
+
+    void take(node_handle& other)
+    {
+        if (other.alloc_)
+        {
+            ::new (static_cast<void*>(std::addressof(node_))) Node(std::move(other.node_));
+            alloc_.emplace(std::move(*other.alloc_));
+            other.reset();
+        }
+    }
+
+    // The node is alive while alloc_ holds a value. It is managed by hand rather than through a
+    // std::optional<Node>, whose inlined destructor trips -Wmaybe-uninitialized on GCC at -O2.
+    union
+    {
+        mutable Node node_;
+    };
+
+    std::optional<allocator_type> alloc_;
+};
+
+template <class Node, class Key, class T, class Allocator>
+void swap(
+    node_handle<Node, Key, T, Allocator>& lhs,
+    node_handle<Node, Key, T, Allocator>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+    lhs.swap(rhs);
+}
+
+template <class Iterator, class NodeHandle>
+struct insert_return_type
+{
+    Iterator position;
+    bool inserted;
+    NodeHandle node;
+};
+
+} // namespace jg::details
+
+#endif // JG_NODE_HANDLE_HPP
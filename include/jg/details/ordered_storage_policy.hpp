@@ -0,0 +1,194 @@
+#ifndef JG_ORDERED_STORAGE_POLICY_HPP
+#define JG_ORDERED_STORAGE_POLICY_HPP
+
+#include "node.hpp"
+#include "vector_storage_policy.hpp"
+
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace jg::details
+{
+
+// The next link of a tombstone: a node erased from an ordered map, out of any chain, whose pair is
+// destroyed.
+template <class Key, class T>
+constexpr node_index_t<Key, T> tombstone_link = node_end_index<Key, T> - 1;
+
+// The link and the pair of an ordered_node. The pair only lives while the node is not a
+// tombstone, copying or moving a tombstone gives a tombstone.
+template <class Key, class T>
+class tombstone_node_base
+{
+    using pair_type = key_value_pair_t<Key, T>;
+
+public:
+    template <class... Args>
+    constexpr tombstone_node_base(node_index_t<Key, T> next, Args&&... args)
+        : next(next), pair(std::forward<Args>(args)...)
+    {}
+
+    template <class Allocator, class... Args>
+    constexpr tombstone_node_base(
+        std::allocator_arg_t, const Allocator& alloc, node_index_t<Key, T> next, Args&&... args)
+        : next(next), pair(std::allocator_arg, alloc, std::forward<Args>(args)...)
+    {}
+
+    template <class Allocator>
+    tombstone_node_base(
+        std::allocator_arg_t, const Allocator& alloc, const tombstone_node_base& other)
+        : next(other.next)
+    {
+        if (!other.is_tombstone())
+        {
+            revive(std::allocator_arg, alloc, other.pair.pair());
+        }
+    }
+
+    template <class Allocator>
+    tombstone_node_base(std::allocator_arg_t, const Allocator& alloc, tombstone_node_base&& other)
+        : next(other.next)
+    {
+        if (!other.is_tombstone())
+        {
+            revive(std::allocator_arg, alloc, std::move(other.pair.pair()));
+        }
+    }
+
+    tombstone_node_base(const tombstone_node_base& other) noexcept(
+        std::is_nothrow_copy_constructible_v<pair_type>)
+        : next(other.next)
+    {
+        if (!other.is_tombstone())
+        {
+            revive(other.pair);
+        }
+    }
+
+    tombstone_node_base(tombstone_node_base&& other) noexcept(
+        std::is_nothrow_move_constructible_v<pair_type>)
+        : next(other.next)
+    {
+        if (!other.is_tombstone())
+        {
+            revive(std::move(other.pair));
+        }
+    }
+
+    auto operator=(const tombstone_node_base& other) noexcept(
+        std::is_nothrow_copy_constructible_v<pair_type>&&
+            std::is_nothrow_copy_assignable_v<pair_type>) -> tombstone_node_base&
+    {
+        if (this != &other)
+        {
+            assign(other.is_tombstone(), other.pair, other.next);
+        }
+
+        return *this;
+    }
+
+    auto operator=(tombstone_node_base&& other) noexcept(
+        std::is_nothrow_move_constructible_v<pair_type>&&
+            std::is_nothrow_move_assignable_v<pair_type>) -> tombstone_node_base&
+    {
+        if (this != &other)
+        {
+            assign(other.is_tombstone(), std::move(other.pair), other.next);
+        }
+
+        return *this;
+    }
+
+    ~tombstone_node_base()
+    {
+        if (!is_tombstone())
+        {
+            pair.~pair_type();
+        }
+    }
+
+    constexpr auto is_tombstone() const noexcept -> bool
+    {
+        return next == tombstone_link<Key, T>;
+    }
+
+    // Destroys the pair. The node must already be out of its chain.
+    void bury() noexcept
+    {
+        pair.~pair_type();
+        next = tombstone_link<Key, T>;
+    }
+
+    node_index_t<Key, T> next = node_end_index<Key, T>;
+
+    union
+    {
+        pair_type pair;
+    };
+
+private:
+    template <class... Args>
+    void revive(Args&&... args)
+    {
+        ::new (static_cast<void*>(std::addressof(pair))) pair_type(std::forward<Args>(args)...);
+    }
+
+    template <class Pair>
+    void assign(bool is_other_tombstone, Pair&& other_pair, node_index_t<Key, T> other_next)
+    {
+        if (is_other_tombstone)
+        {
+            if (!is_tombstone())
+            {
+                pair.~pair_type();
+            }
+        }
+        else if (is_tombstone())
+        {
+            revive(std::forward<Pair>(other_pair));
+        }
+        else
+        {
+            pair = std::forward<Pair>(other_pair);
+        }
+
+        next = other_next;
+    }
+};
+
+// Node of the ordered_storage_policy.
+template <class Key, class T, class Pair = std::pair<Key, T>>
+struct ordered_node : tombstone_node_base<Key, T>,
+                      disable_copy_constructor<Pair>,
+                      disable_copy_assignment<Pair>,
+                      disable_move_constructor<Pair>,
+                      disable_move_assignment<Pair>
+{
+    using tombstone_node_base<Key, T>::tombstone_node_base;
+};
+
+// Keeps the entries in insertion order, erasures included. An erased node is unlinked from its
+// chain and left in place as a tombstone, which the iterators skip, instead of being replaced by
+// the last node: erasing never moves another entry nor walks a chain twice. The nodes are compacted
+// once the tombstones outnumber the entries, and by shrink_to_fit(). The iterators are
+// bidirectional rather than random access.
+template <class Base = vector_storage_policy>
+struct ordered_storage_policy : Base
+{
+    template <class Key, class T, class Allocator>
+    using node = ordered_node<Key, T>;
+};
+
+} // namespace jg::details
+
+namespace std
+{
+template <class Key, class T, class Allocator>
+struct uses_allocator<jg::details::ordered_node<Key, T>, Allocator> : true_type
+{
+};
+} // namespace std
+
+#endif // JG_ORDERED_STORAGE_POLICY_HPP
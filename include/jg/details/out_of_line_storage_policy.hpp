@@ -0,0 +1,452 @@
+#ifndef JG_OUT_OF_LINE_STORAGE_POLICY_HPP
+#define JG_OUT_OF_LINE_STORAGE_POLICY_HPP
+
+#include "node.hpp"
+#include "vector_storage_policy.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jg::details
+{
+
+// Slab the pairs of the out_of_line_storage_policy live in: blocks carved out of chunks allocated
+// through the map's allocator, the blocks of the erased pairs being reused first. Every block
+// records its slab, so that a pair can be freed without the map it belongs to, and the slab lives
+// until the last allocator and the last pair referring to it are gone.
+template <class Storage, class Allocator>
+class pair_slab
+{
+public:
+    using allocator_type = Allocator;
+
+    struct block
+    {
+        block() noexcept : next_free(nullptr) {}
+
+        ~block() {}
+
+        pair_slab* owner = nullptr;
+
+        union
+        {
+            Storage value;
+            block* next_free;
+        };
+    };
+
+    static auto create(const Allocator& alloc) -> pair_slab*
+    {
+        slab_allocator_type slab_alloc(alloc);
+        auto p = slab_traits::allocate(slab_alloc, 1);
+        return ::new (static_cast<void*>(std::addressof(*p))) pair_slab(alloc);
+    }
+
+    pair_slab(const pair_slab&) = delete;
+    auto operator=(const pair_slab&) -> pair_slab& = delete;
+
+    void retain() noexcept { ++refs_; }
+
+    void release() noexcept
+    {
+        if (--refs_ == 0)
+        {
+            destroy();
+        }
+    }
+
+    template <class... Args>
+    auto emplace(Args&&... args) -> block*
+    {
+        block* b = take_block();
+
+#ifndef JG_NO_EXCEPTION
+        try
+        {
+#endif
+            ::new (static_cast<void*>(std::addressof(b->value))) Storage(
+                std::allocator_arg, std::as_const(storage_alloc_), std::forward<Args>(args)...);
+#ifndef JG_NO_EXCEPTION
+        }
+        catch (...)
+        {
+            b->next_free = std::exchange(free_, b);
+            throw;
+        }
+#endif
+
+        retain();
+        return b;
+    }
+
+    static void erase(block* b) noexcept
+    {
+        auto* slab = b->owner;
+        b->value.~Storage();
+        b->next_free = std::exchange(slab->free_, b);
+        slab->release();
+    }
+
+private:
+    template <class U>
+    using rebind_alloc = typename std::allocator_traits<Allocator>::template rebind_alloc<U>;
+
+    using storage_allocator_type = rebind_alloc<Storage>;
+    using block_allocator_type = rebind_alloc<block>;
+    using block_traits = std::allocator_traits<block_allocator_type>;
+    using slab_allocator_type = rebind_alloc<pair_slab>;
+    using slab_traits = std::allocator_traits<slab_allocator_type>;
+
+    struct chunk
+    {
+        typename block_traits::pointer blocks;
+        std::size_t size;
+    };
+
+    static constexpr std::size_t min_chunk_size = 8u;
+    static constexpr std::size_t max_chunk_size =
+        std::max(min_chunk_size, std::size_t{64u * 1024u} / sizeof(block));
+
+    explicit pair_slab(const Allocator& alloc)
+        : storage_alloc_(alloc), chunks_(rebind_alloc<chunk>(alloc))
+    {}
+
+    auto take_block() -> block*
+    {
+        if (free_ != nullptr)
+        {
+            return std::exchange(free_, free_->next_free);
+        }
+
+        if (next_ == last_)
+        {
+            add_chunk();
+        }
+
+        block* b = ::new (static_cast<void*>(next_++)) block();
+        b->owner = this;
+        return b;
+    }
+
+    // Chunks grow with the number of blocks carved so far, up to max_chunk_size blocks.
+    void add_chunk()
+    {
+        const auto size = std::clamp(block_count_, min_chunk_size, max_chunk_size);
+        block_allocator_type block_alloc(storage_alloc_);
+
+        if (chunks_.size() == chunks_.capacity())
+        {
+            chunks_.reserve(2u * chunks_.size() + 1u);
+        }
+
+        auto blocks = block_traits::allocate(block_alloc, size);
+        chunks_.push_back(chunk{blocks, size});
+        next_ = std::addressof(*blocks);
+        last_ = next_ + size;
+        block_count_ += size;
+    }
+
+    void destroy() noexcept
+    {
+        block_allocator_type block_alloc(storage_alloc_);
+
+        for (const auto& c : chunks_)
+        {
+            block_traits::deallocate(block_alloc, c.blocks, c.size);
+        }
+
+        slab_allocator_type slab_alloc(storage_alloc_);
+        auto p = std::pointer_traits<typename slab_traits::pointer>::pointer_to(*this);
+        this->~pair_slab();
+        slab_traits::deallocate(slab_alloc, p, 1);
+    }
+
+    storage_allocator_type storage_alloc_;
+    std::vector<chunk, rebind_alloc<chunk>> chunks_;
+    block* free_ = nullptr;
+    block* next_ = nullptr;
+    block* last_ = nullptr;
+    std::size_t block_count_ = 0;
+    std::size_t refs_ = 1;
+};
+
+// Allocator of the nodes_ container of the out_of_line_storage_policy: the node allocator of the
+// map, plus the slab the nodes it constructs get their pair from. Each container gets a slab of its
+// own, created on its first insertion; copies of the allocator share it.
+template <class NodeAllocator>
+class pair_slab_allocator : public NodeAllocator
+{
+    using base_traits = std::allocator_traits<NodeAllocator>;
+    using node_type = typename base_traits::value_type;
+    using slab_type = typename node_type::slab_type;
+
+public:
+    template <class U>
+    struct rebind
+    {
+        using other = std::conditional_t<
+            std::is_same_v<U, node_type>, pair_slab_allocator,
+            typename base_traits::template rebind_alloc<U>>;
+    };
+
+    using propagate_on_container_copy_assignment =
+        typename base_traits::propagate_on_container_copy_assignment;
+    using propagate_on_container_move_assignment =
+        typename base_traits::propagate_on_container_move_assignment;
+    using propagate_on_container_swap = std::true_type;
+    using is_always_equal = typename base_traits::is_always_equal;
+
+    pair_slab_allocator() = default;
+
+    template <class Alloc, std::enable_if_t<!std::is_same_v<Alloc, pair_slab_allocator>, int> = 0>
+    pair_slab_allocator(const Alloc& alloc) : NodeAllocator(alloc)
+    {}
+
+    pair_slab_allocator(const pair_slab_allocator& other) noexcept
+        : NodeAllocator(other.base()), slab_(other.slab_)
+    {
+        if (slab_ != nullptr)
+        {
+            slab_->retain();
+        }
+    }
+
+    pair_slab_allocator(pair_slab_allocator&& other) noexcept
+        : NodeAllocator(std::move(other.base())), slab_(std::exchange(other.slab_, nullptr))
+    {}
+
+    // Assigning an allocator only assigns the node allocator: each container keeps its slab.
+    auto operator=(const pair_slab_allocator& other) noexcept -> pair_slab_allocator&
+    {
+        base() = other.base();
+        return *this;
+    }
+
+    auto operator=(pair_slab_allocator&& other) noexcept -> pair_slab_allocator&
+    {
+        if (this != &other)
+        {
+            base() = std::move(other.base());
+            reset();
+            slab_ = std::exchange(other.slab_, nullptr);
+        }
+
+        return *this;
+    }
+
+    ~pair_slab_allocator() { reset(); }
+
+    auto select_on_container_copy_construction() const -> pair_slab_allocator
+    {
+        return pair_slab_allocator(base_traits::select_on_container_copy_construction(base()));
+    }
+
+    template <class U, class... Args>
+    void construct(U* p, Args&&... args)
+    {
+        if constexpr (std::is_same_v<U, node_type>)
+        {
+            ::new (static_cast<void*>(p))
+                node_type(std::allocator_arg, *this, std::forward<Args>(args)...);
+        }
+        else
+        {
+            base_traits::construct(base(), p, std::forward<Args>(args)...);
+        }
+    }
+
+    auto slab() const -> slab_type&
+    {
+        if (slab_ == nullptr)
+        {
+            slab_ = slab_type::create(typename slab_type::allocator_type(base()));
+        }
+
+        return *slab_;
+    }
+
+    // Containers swapping their nodes swap their slabs too; the node allocators only when they
+    // propagate on swap, containers requiring them equal otherwise.
+    friend void swap(pair_slab_allocator& lhs, pair_slab_allocator& rhs) noexcept
+    {
+        if constexpr (base_traits::propagate_on_container_swap::value)
+        {
+            using std::swap;
+            swap(lhs.base(), rhs.base());
+        }
+
+        std::swap(lhs.slab_, rhs.slab_);
+    }
+
+    friend auto operator==(const pair_slab_allocator& lhs, const pair_slab_allocator& rhs) noexcept
+        -> bool
+    {
+        return lhs.base() == rhs.base();
+    }
+
+    friend auto operator!=(const pair_slab_allocator& lhs, const pair_slab_allocator& rhs) noexcept
+        -> bool
+    {
+        return !(lhs == rhs);
+    }
+
+private:
+    auto base() noexcept -> NodeAllocator& { return *this; }
+
+    auto base() const noexcept -> const NodeAllocator& { return *this; }
+
+    void reset() noexcept
+    {
+        if (slab_ != nullptr)
+        {
+            std::exchange(slab_, nullptr)->release();
+        }
+    }
+
+    mutable slab_type* slab_ = nullptr;
+};
+
+// Owning handle to a key/value pair kept in a pair_slab, outside of the nodes_ array.
+// It exposes the same pair() / const_key_pair() interface as key_value_pair_t so that the
+// iterators do not have to know where the pair lives. The pair never moves once constructed: moving
+// the handle only moves the pointer.
+template <class Key, class T, class Allocator>
+class out_of_line_pair
+{
+public:
+    using slab_type = pair_slab<key_value_pair_t<Key, T>, Allocator>;
+    using pair_t = std::pair<Key, T>;
+    using const_key_pair_t = std::pair<const Key, T>;
+
+    template <class... Args>
+    explicit out_of_line_pair(slab_type& slab, Args&&... args)
+        : block_(slab.emplace(std::forward<Args>(args)...))
+    {}
+
+    out_of_line_pair(const out_of_line_pair&) = delete;
+
+    out_of_line_pair(out_of_line_pair&& other) noexcept
+        : block_(std::exchange(other.block_, nullptr))
+    {}
+
+    auto operator=(const out_of_line_pair& other) -> out_of_line_pair&
+    {
+        if (this != &other)
+        {
+            if (block_ == nullptr)
+            {
+                block_ = other.block_->owner->emplace(other.pair());
+            }
+            else
+            {
+                block_->value = other.block_->value;
+            }
+        }
+
+        return *this;
+    }
+
+    auto operator=(out_of_line_pair&& other) noexcept -> out_of_line_pair&
+    {
+        if (this != &other)
+        {
+            release();
+            block_ = std::exchange(other.block_, nullptr);
+        }
+
+        return *this;
+    }
+
+    ~out_of_line_pair() { release(); }
+
+    auto pair() -> decltype(auto) { return block_->value.pair(); }
+
+    auto pair() const -> decltype(auto) { return block_->value.pair(); }
+
+    auto const_key_pair() -> decltype(auto) { return block_->value.const_key_pair(); }
+
+    auto const_key_pair() const -> decltype(auto) { return block_->value.const_key_pair(); }
+
+private:
+    void release() noexcept
+    {
+        if (block_ != nullptr)
+        {
+            slab_type::erase(std::exchange(block_, nullptr));
+        }
+    }
+
+    typename slab_type::block* block_ = nullptr;
+};
+
+// Node of the out_of_line_storage_policy: only the chain link, the cached hash of the key and a
+// pointer to the pair are kept in nodes_. The pair_slab_allocator of nodes_ builds the nodes,
+// passing itself for them to take their pair from its slab; moving a node keeps its pair in place.
+template <class Key, class T, class Allocator, class Pair = std::pair<Key, T>>
+struct out_of_line_node : disable_copy_constructor<Pair>,
+                          disable_copy_assignment<Pair>,
+                          disable_move_constructor<Pair>,
+                          disable_move_assignment<Pair>
+{
+    using slab_type = typename out_of_line_pair<Key, T, Allocator>::slab_type;
+
+    template <class Alloc, class... Args>
+    out_of_line_node(
+        std::allocator_arg_t, const Alloc& alloc, node_index_t<Key, T> next, Args&&... args)
+        : next(next), pair(alloc.slab(), std::forward<Args>(args)...)
+    {}
+
+    template <class Alloc>
+    out_of_line_node(std::allocator_arg_t, const Alloc& alloc, const out_of_line_node& other)
+        : next(other.next), hash(other.hash), pair(alloc.slab(), other.pair.pair())
+    {}
+
+    template <class Alloc>
+    out_of_line_node(std::allocator_arg_t, const Alloc& /*alloc*/, out_of_line_node&& other)
+        : next(other.next), hash(other.hash), pair(std::move(other.pair))
+    {}
+
+    out_of_line_node(out_of_line_node&& other) = default;
+
+    auto operator=(const out_of_line_node& other) -> out_of_line_node& = default;
+
+    auto operator=(out_of_line_node&& other) -> out_of_line_node& = default;
+
+    node_index_t<Key, T> next = node_end_index<Key, T>;
+    std::size_t hash = 0;
+    out_of_line_pair<Key, T, Allocator> pair;
+};
+
+template <class Node>
+inline constexpr bool is_out_of_line_node_v = false;
+
+template <class Key, class T, class Allocator, class Pair>
+inline constexpr bool is_out_of_line_node_v<out_of_line_node<Key, T, Allocator, Pair>> = true;
+
+// Keeps large key/value pairs out of the nodes_ array: erasing, growing and walking the chains
+// only touches small {next, hash, pointer} records, and references to the pairs stay valid when
+// nodes_ reallocates or when other entries are erased. The pairs are packed into a slab per map,
+// whose chunks come from the map's allocator and are only given back when the map and all the
+// pairs taken from it are gone. The blocks of erased pairs are reused by the next insertions.
+//
+// An entry moved to another map, through a node handle, merge() or a move or swap the allocator
+// does not propagate with, keeps its pair in the slab it came from: two maps sharing a slab that
+// way must not be modified concurrently. Base must keep the nodes in a nodes_container.
+template <class Base = vector_storage_policy>
+struct out_of_line_storage_policy : Base
+{
+    template <class Key, class T, class Allocator>
+    using node = out_of_line_node<Key, T, Allocator>;
+
+    template <class T, class Allocator>
+    using nodes_container =
+        typename Base::template nodes_container<T, pair_slab_allocator<Allocator>>;
+};
+
+} // namespace jg::details
+
+#endif // JG_OUT_OF_LINE_STORAGE_POLICY_HPP
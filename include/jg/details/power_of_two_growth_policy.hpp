@@ -39,6 +39,20 @@ struct power_of_two_growth_policy
     }
 
     static constexpr auto minimum_capacity() -> std::size_t { return 8u; }
+
+    // Next bucket count once the max load factor is reached.
+    static constexpr auto grow_bucket_count(std::size_t bucket_count) -> std::size_t
+    {
+        return bucket_count * 2;
+    }
+
+    static constexpr float default_max_load_factor = 0.875f;
+};
+
+// Speed-oriented preset: shorter chains at the cost of twice as many buckets.
+struct speed_growth_policy : power_of_two_growth_policy
+{
+    static constexpr float default_max_load_factor = 0.5f;
 };
 
 } // namespace jg::details
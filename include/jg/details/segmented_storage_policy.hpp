@@ -0,0 +1,26 @@
+#ifndef JG_SEGMENTED_STORAGE_POLICY_HPP
+#define JG_SEGMENTED_STORAGE_POLICY_HPP
+
+#include "segmented_vector.hpp"
+
+#include <cstddef>
+
+namespace jg::details
+{
+
+// Chunked storage for very large maps: growing nodes_ or buckets_ allocates new chunks of
+// 2^ChunkBits elements and never moves the existing ones. This trades an extra indirection on
+// every access for a peak memory during growth of one chunk rather than twice the whole array.
+template <std::size_t ChunkBits = 16>
+struct segmented_storage_policy
+{
+    template <class T, class Allocator>
+    using nodes_container = segmented_vector<T, Allocator, ChunkBits>;
+
+    template <class T, class Allocator>
+    using buckets_container = segmented_vector<T, Allocator, ChunkBits>;
+};
+
+} // namespace jg::details
+
+#endif // JG_SEGMENTED_STORAGE_POLICY_HPP
@@ -0,0 +1,587 @@
+#ifndef JG_SEGMENTED_VECTOR_HPP
+#define JG_SEGMENTED_VECTOR_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jg::details
+{
+
+template <class Container, bool isConst>
+class segmented_vector_iterator
+{
+    friend segmented_vector_iterator<Container, true>;
+
+    using container_type = std::conditional_t<isConst, const Container, Container>;
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = typename Container::value_type;
+    using difference_type = typename Container::difference_type;
+    using reference = std::conditional_t<isConst, const value_type&, value_type&>;
+    using pointer = std::conditional_t<isConst, const value_type*, value_type*>;
+
+    constexpr segmented_vector_iterator() noexcept = default;
+
+    constexpr segmented_vector_iterator(
+        container_type& container, typename Container::size_type index) noexcept
+        : container_(&container), index_(index)
+    {}
+
+    template <bool DepIsConst = isConst, std::enable_if_t<DepIsConst, int> = 0>
+    constexpr segmented_vector_iterator(
+        const segmented_vector_iterator<Container, false>& other) noexcept
+        : container_(other.container_), index_(other.index_)
+    {}
+
+    constexpr auto operator*() const noexcept -> reference { return (*container_)[index_]; }
+
+    constexpr auto operator->() const noexcept -> pointer { return &(*container_)[index_]; }
+
+    constexpr auto operator[](difference_type n) const noexcept -> reference
+    {
+        return (*container_)[index_ + n];
+    }
+
+    constexpr auto operator++() noexcept -> segmented_vector_iterator&
+    {
+        ++index_;
+        return *this;
+    }
+
+    constexpr auto operator++(int) noexcept -> segmented_vector_iterator
+    {
+        auto old = *this;
+        ++index_;
+        return old;
+    }
+
+    constexpr auto operator--() noexcept -> segmented_vector_iterator&
+    {
+        --index_;
+        return *this;
+    }
+
+    constexpr auto operator--(int) noexcept -> segmented_vector_iterator
+    {
+        auto old = *this;
+        --index_;
+        return old;
+    }
+
+    constexpr auto operator+=(difference_type n) noexcept -> segmented_vector_iterator&
+    {
+        index_ += n;
+        return *this;
+    }
+
+    constexpr auto operator-=(difference_type n) noexcept -> segmented_vector_iterator&
+    {
+        index_ -= n;
+        return *this;
+    }
+
+    constexpr auto operator+(difference_type n) const noexcept -> segmented_vector_iterator
+    {
+        return {*container_, index_ + n};
+    }
+
+    friend constexpr auto operator+(difference_type n, const segmented_vector_iterator& it) noexcept
+        -> segmented_vector_iterator
+    {
+        return it + n;
+    }
+
+    constexpr auto operator-(difference_type n) const noexcept -> segmented_vector_iterator
+    {
+        return {*container_, index_ - n};
+    }
+
+    constexpr auto index() const noexcept -> typename Container::size_type { return index_; }
+
+private:
+    container_type* container_ = nullptr;
+    typename Container::size_type index_ = 0;
+};
+
+template <class Container, bool isConst, bool isConst2>
+constexpr auto operator-(
+    const segmented_vector_iterator<Container, isConst>& lhs,
+    const segmented_vector_iterator<Container, isConst2>& rhs) noexcept ->
+    typename Container::difference_type
+{
+    return static_cast<typename Container::difference_type>(lhs.index()) -
+           static_cast<typename Container::difference_type>(rhs.index());
+}
+
+template <class Container, bool isConst, bool isConst2>
+constexpr auto operator==(
+    const segmented_vector_iterator<Container, isConst>& lhs,
+    const segmented_vector_iterator<Container, isConst2>& rhs) noexcept -> bool
+{
+    return lhs.index() == rhs.index();
+}
+
+template <class Container, bool isConst, bool isConst2>
+constexpr auto operator!=(
+    const segmented_vector_iterator<Container, isConst>& lhs,
+    const segmented_vector_iterator<Container, isConst2>& rhs) noexcept -> bool
+{
+    return lhs.index() != rhs.index();
+}
+
+template <class Container, bool isConst, bool isConst2>
+constexpr auto operator<(
+    const segmented_vector_iterator<Container, isConst>& lhs,
+    const segmented_vector_iterator<Container, isConst2>& rhs) noexcept -> bool
+{
+    return lhs.index() < rhs.index();
+}
+
+template <class Container, bool isConst, bool isConst2>
+constexpr auto operator>(
+    const segmented_vector_iterator<Container, isConst>& lhs,
+    const segmented_vector_iterator<Container, isConst2>& rhs) noexcept -> bool
+{
+    return lhs.index() > rhs.index();
+}
+
+template <class Container, bool isConst, bool isConst2>
+constexpr auto operator<=(
+    const segmented_vector_iterator<Container, isConst>& lhs,
+    const segmented_vector_iterator<Container, isConst2>& rhs) noexcept -> bool
+{
+    return lhs.index() <= rhs.index();
+}
+
+template <class Container, bool isConst, bool isConst2>
+constexpr auto operator>=(
+    const segmented_vector_iterator<Container, isConst>& lhs,
+    const segmented_vector_iterator<Container, isConst2>& rhs) noexcept -> bool
+{
+    return lhs.index() >= rhs.index();
+}
+
+// A std::vector look-alike storing its elements in fixed-size chunks of 2^ChunkBits elements.
+// The high bits of an index select the chunk, the low bits the offset within the chunk.
+// Growing past the first chunk only allocates a new chunk: existing elements never move and the
+// peak memory during growth is the current storage plus one chunk, instead of twice the storage.
+// The first chunk grows geometrically up to the chunk size so that small containers do not pay for
+// a full chunk.
+template <class T, class Allocator, std::size_t ChunkBits>
+class segmented_vector
+{
+    static_assert(ChunkBits > 0 && ChunkBits < 32, "Unreasonable chunk size.");
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+    using chunk_pointer = typename alloc_traits::pointer;
+    using chunks_container_type = std::vector<
+        chunk_pointer, typename alloc_traits::template rebind_alloc<chunk_pointer>>;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = typename alloc_traits::pointer;
+    using const_pointer = typename alloc_traits::const_pointer;
+    using iterator = segmented_vector_iterator<segmented_vector, false>;
+    using const_iterator = segmented_vector_iterator<segmented_vector, true>;
+
+    static constexpr size_type chunk_size = size_type{1} << ChunkBits;
+    static constexpr size_type chunk_mask = chunk_size - 1;
+
+    segmented_vector() noexcept(std::is_nothrow_default_constructible_v<allocator_type>)
+        : segmented_vector(allocator_type())
+    {}
+
+    explicit segmented_vector(const allocator_type& alloc) noexcept
+        : alloc_(alloc), chunks_(alloc)
+    {}
+
+    segmented_vector(const segmented_vector& other)
+        : segmented_vector(
+              other, alloc_traits::select_on_container_copy_construction(other.alloc_))
+    {}
+
+    segmented_vector(const segmented_vector& other, const allocator_type& alloc)
+        : segmented_vector(alloc)
+    {
+        append_copies(other);
+    }
+
+    segmented_vector(segmented_vector&& other) noexcept
+        : alloc_(std::move(other.alloc_))
+        , chunks_(std::move(other.chunks_))
+        , size_(std::exchange(other.size_, 0u))
+        , first_chunk_capacity_(std::exchange(other.first_chunk_capacity_, 0u))
+    {
+        other.chunks_.clear();
+    }
+
+    segmented_vector(segmented_vector&& other, const allocator_type& alloc)
+        : segmented_vector(alloc)
+    {
+        if (alloc_ == other.alloc_)
+        {
+            steal(other);
+        }
+        else
+        {
+            append_moves(other);
+        }
+    }
+
+    ~segmented_vector() { release(); }
+
+    auto operator=(const segmented_vector& other) -> segmented_vector&
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        clear();
+
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+        {
+            if (alloc_ != other.alloc_)
+            {
+                release();
+            }
+
+            alloc_ = other.alloc_;
+        }
+
+        append_copies(other);
+        return *this;
+    }
+
+    auto operator=(segmented_vector&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value) -> segmented_vector&
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            release();
+            alloc_ = std::move(other.alloc_);
+            steal(other);
+        }
+        else
+        {
+            if (alloc_ == other.alloc_)
+            {
+                release();
+                steal(other);
+            }
+            else
+            {
+                clear();
+                append_moves(other);
+            }
+        }
+
+        return *this;
+    }
+
+    auto get_allocator() const -> allocator_type { return alloc_; }
+
+    auto operator[](size_type index) noexcept -> reference
+    {
+        return chunks_[index >> ChunkBits][index & chunk_mask];
+    }
+
+    auto operator[](size_type index) const noexcept -> const_reference
+    {
+        return chunks_[index >> ChunkBits][index & chunk_mask];
+    }
+
+    auto front() noexcept -> reference { return (*this)[0]; }
+    auto front() const noexcept -> const_reference { return (*this)[0]; }
+    auto back() noexcept -> reference { return (*this)[size_ - 1]; }
+    auto back() const noexcept -> const_reference { return (*this)[size_ - 1]; }
+
+    auto begin() noexcept -> iterator { return {*this, 0u}; }
+    auto begin() const noexcept -> const_iterator { return {*this, 0u}; }
+    auto cbegin() const noexcept -> const_iterator { return {*this, 0u}; }
+    auto end() noexcept -> iterator { return {*this, size_}; }
+    auto end() const noexcept -> const_iterator { return {*this, size_}; }
+    auto cend() const noexcept -> const_iterator { return {*this, size_}; }
+
+    [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+
+    auto size() const noexcept -> size_type { return size_; }
+
+    auto max_size() const noexcept -> size_type
+    {
+        return std::min<size_type>(
+            alloc_traits::max_size(alloc_),
+            std::numeric_limits<difference_type>::max() / sizeof(value_type));
+    }
+
+    auto capacity() const noexcept -> size_type
+    {
+        return chunks_.size() <= 1 ? first_chunk_capacity_ : chunks_.size() * chunk_size;
+    }
+
+    void reserve(size_type count)
+    {
+        if (count <= capacity())
+        {
+            return;
+        }
+
+        if (chunks_.size() <= 1)
+        {
+            reallocate_first_chunk(std::min(count, chunk_size));
+        }
+
+        while (capacity() < count)
+        {
+            append_chunk();
+        }
+    }
+
+    void resize(size_type count)
+    {
+        while (size_ > count)
+        {
+            pop_back();
+        }
+
+        reserve(count);
+
+        while (size_ < count)
+        {
+            emplace_back();
+        }
+    }
+
+    void clear() noexcept
+    {
+        while (size_ > 0)
+        {
+            pop_back();
+        }
+    }
+
+    // Releases the chunks past the last element. While the container fits in its first chunk, the
+    // first chunk is reallocated to the exact size.
+    void shrink_to_fit()
+    {
+        if (size_ == 0)
+        {
+            release();
+            return;
+        }
+
+        if (chunks_.size() <= 1)
+        {
+            reallocate_first_chunk(size_);
+            return;
+        }
+
+        const auto used_chunks = (size_ + chunk_mask) >> ChunkBits;
+
+        while (chunks_.size() > used_chunks)
+        {
+            alloc_traits::deallocate(alloc_, chunks_.back(), chunk_size);
+            chunks_.pop_back();
+        }
+    }
+
+    template <class... Args>
+    auto emplace_back(Args&&... args) -> reference
+    {
+        if (size_ == capacity())
+        {
+            grow();
+        }
+
+        auto* slot = std::addressof((*this)[size_]);
+        alloc_traits::construct(alloc_, slot, std::forward<Args>(args)...);
+        ++size_;
+
+        return *slot;
+    }
+
+    void push_back(const value_type& value) { emplace_back(value); }
+
+    void push_back(value_type&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() noexcept
+    {
+        assert(size_ > 0 && "pop_back() called on an empty segmented_vector.");
+        --size_;
+        alloc_traits::destroy(alloc_, std::addressof((*this)[size_]));
+    }
+
+    void swap(segmented_vector& other) noexcept
+    {
+        using std::swap;
+
+        if constexpr (alloc_traits::propagate_on_container_swap::value)
+        {
+            swap(alloc_, other.alloc_);
+        }
+
+        chunks_.swap(other.chunks_);
+        swap(size_, other.size_);
+        swap(first_chunk_capacity_, other.first_chunk_capacity_);
+    }
+
+private:
+    void grow()
+    {
+        if (chunks_.size() <= 1 && first_chunk_capacity_ < chunk_size)
+        {
+            reallocate_first_chunk(
+                std::min(chunk_size, std::max<size_type>(8u, first_chunk_capacity_ * 2)));
+        }
+        else
+        {
+            append_chunk();
+        }
+    }
+
+    void append_chunk()
+    {
+        chunks_.reserve(chunks_.size() + 1);
+        chunks_.push_back(alloc_traits::allocate(alloc_, chunk_size));
+    }
+
+    // Only the first chunk is ever reallocated, and only while the container fits in one chunk.
+    void reallocate_first_chunk(size_type new_capacity)
+    {
+        assert(chunks_.size() <= 1 && new_capacity <= chunk_size);
+
+        if (new_capacity == first_chunk_capacity_)
+        {
+            return;
+        }
+
+        assert(new_capacity >= size_);
+
+        chunks_.reserve(1);
+        auto new_chunk = alloc_traits::allocate(alloc_, new_capacity);
+
+        if (!chunks_.empty())
+        {
+            auto old_chunk = chunks_.front();
+            size_type moved = 0;
+
+            // The old elements are only destroyed once all of them are in the new chunk, so that
+            // the container is left untouched if one of the constructions throws.
+#ifndef JG_NO_EXCEPTION
+            try
+            {
+#endif
+                for (; moved < size_; ++moved)
+                {
+                    alloc_traits::construct(
+                        alloc_, std::addressof(new_chunk[moved]),
+                        std::move_if_noexcept(old_chunk[moved]));
+                }
+#ifndef JG_NO_EXCEPTION
+            }
+            catch (...)
+            {
+                for (size_type i = 0; i < moved; ++i)
+                {
+                    alloc_traits::destroy(alloc_, std::addressof(new_chunk[i]));
+                }
+
+                alloc_traits::deallocate(alloc_, new_chunk, new_capacity);
+                throw;
+            }
+#endif
+
+            for (size_type i = 0; i < size_; ++i)
+            {
+                alloc_traits::destroy(alloc_, std::addressof(old_chunk[i]));
+            }
+
+            alloc_traits::deallocate(alloc_, old_chunk, first_chunk_capacity_);
+            chunks_.front() = new_chunk;
+        }
+        else
+        {
+            chunks_.push_back(new_chunk);
+        }
+
+        first_chunk_capacity_ = new_capacity;
+    }
+
+    void append_copies(const segmented_vector& other)
+    {
+        reserve(size_ + other.size_);
+
+        for (size_type i = 0; i < other.size_; ++i)
+        {
+            emplace_back(other[i]);
+        }
+    }
+
+    void append_moves(segmented_vector& other)
+    {
+        reserve(size_ + other.size_);
+
+        for (size_type i = 0; i < other.size_; ++i)
+        {
+            emplace_back(std::move(other[i]));
+        }
+    }
+
+    void steal(segmented_vector& other) noexcept
+    {
+        chunks_ = std::move(other.chunks_);
+        other.chunks_.clear();
+        size_ = std::exchange(other.size_, 0u);
+        first_chunk_capacity_ = std::exchange(other.first_chunk_capacity_, 0u);
+    }
+
+    void release() noexcept
+    {
+        clear();
+
+        for (size_type i = 0; i < chunks_.size(); ++i)
+        {
+            alloc_traits::deallocate(
+                alloc_, chunks_[i], i == 0 ? first_chunk_capacity_ : chunk_size);
+        }
+
+        chunks_.clear();
+        first_chunk_capacity_ = 0;
+    }
+
+    allocator_type alloc_;
+    chunks_container_type chunks_;
+    size_type size_ = 0;
+    size_type first_chunk_capacity_ = 0;
+};
+
+template <class T, class Allocator, std::size_t ChunkBits>
+void swap(
+    segmented_vector<T, Allocator, ChunkBits>& lhs,
+    segmented_vector<T, Allocator, ChunkBits>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace jg::details
+
+#endif // JG_SEGMENTED_VECTOR_HPP
@@ -0,0 +1,60 @@
+#ifndef JG_SET_NODE_HPP
+#define JG_SET_NODE_HPP
+
+#include "node.hpp"
+#include "vector_storage_policy.hpp"
+
+#include <tuple>
+#include <utility>
+
+namespace jg::details
+{
+
+// The key of a set node, standing where map nodes hold their key/value pair: pair() gives access
+// to the key in a node handle and const_key_pair() is what the iterators project, so iterating
+// over the nodes of a set yields the keys themselves.
+template <class Key>
+class set_value
+{
+public:
+    template <class... Args>
+    constexpr set_value(std::piecewise_construct_t, std::tuple<Args...> key_args, std::tuple<>)
+        : key_(std::make_from_tuple<Key>(std::move(key_args)))
+    {}
+
+    constexpr auto pair() noexcept -> Key& { return key_; }
+
+    constexpr auto pair() const noexcept -> const Key& { return key_; }
+
+    constexpr auto const_key_pair() const noexcept -> const Key& { return key_; }
+
+private:
+    Key key_;
+};
+
+// Node of a dense_hash_set: the link to the next node of the chain and the key, without a mapped
+// value nor the padding it would bring.
+template <class Key>
+struct set_node
+{
+    template <class... Args>
+    constexpr set_node(node_index_t<Key, no_mapped_value> next, Args&&... args)
+        : next(next), pair(std::forward<Args>(args)...)
+    {}
+
+    node_index_t<Key, no_mapped_value> next = node_end_index<Key, no_mapped_value>;
+    set_value<Key> pair;
+};
+
+// Storage of a dense_hash_set: the containers and options of Base, holding set nodes. The node of
+// Base, if any, is replaced.
+template <class Base = vector_storage_policy>
+struct set_storage_policy : Base
+{
+    template <class Key, class T, class Allocator>
+    using node = set_node<Key>;
+};
+
+} // namespace jg::details
+
+#endif // JG_SET_NODE_HPP
@@ -0,0 +1,507 @@
+#ifndef JG_SINGLE_BLOCK_STORAGE_HPP
+#define JG_SINGLE_BLOCK_STORAGE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace jg::details
+{
+
+template <class Node, class Allocator>
+class single_block_storage;
+
+// std::vector look-alike view over the nodes part of a single_block_storage.
+template <class Node, class Allocator>
+class single_block_nodes
+{
+    using storage_type = single_block_storage<Node, Allocator>;
+
+public:
+    using value_type = Node;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+
+    auto operator[](size_type index) noexcept -> reference { return self().node_data()[index]; }
+
+    auto operator[](size_type index) const noexcept -> const_reference
+    {
+        return self().node_data()[index];
+    }
+
+    auto back() noexcept -> reference { return (*this)[size() - 1]; }
+    auto back() const noexcept -> const_reference { return (*this)[size() - 1]; }
+
+    auto begin() noexcept -> iterator { return self().node_data(); }
+    auto begin() const noexcept -> const_iterator { return self().node_data(); }
+    auto cbegin() const noexcept -> const_iterator { return begin(); }
+    auto end() noexcept -> iterator { return begin() + size(); }
+    auto end() const noexcept -> const_iterator { return begin() + size(); }
+    auto cend() const noexcept -> const_iterator { return end(); }
+
+    [[nodiscard]] auto empty() const noexcept -> bool { return size() == 0; }
+
+    auto size() const noexcept -> size_type { return self().size_; }
+
+    auto max_size() const noexcept -> size_type { return self().max_size(); }
+
+    auto capacity() const noexcept -> size_type { return self().capacity_; }
+
+    void reserve(size_type count) { self().reserve_nodes(count); }
+
+    void clear() noexcept { self().destroy_nodes(); }
+
+    void shrink_to_fit() { self().shrink_to_fit(); }
+
+    template <class... Args>
+    auto emplace_back(Args&&... args) -> reference
+    {
+        return self().emplace_node(std::forward<Args>(args)...);
+    }
+
+    void pop_back() noexcept { self().pop_node(); }
+
+private:
+    auto self() noexcept -> storage_type& { return static_cast<storage_type&>(*this); }
+
+    auto self() const noexcept -> const storage_type&
+    {
+        return static_cast<const storage_type&>(*this);
+    }
+};
+
+// std::vector look-alike view over the buckets part of a single_block_storage.
+template <class Node, class Allocator>
+class single_block_buckets
+{
+    using storage_type = single_block_storage<Node, Allocator>;
+
+public:
+    using value_type = std::size_t;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using iterator = value_type*;
+    using const_iterator = const value_type*;
+
+    auto operator[](size_type index) noexcept -> reference { return self().bucket_data()[index]; }
+
+    auto operator[](size_type index) const noexcept -> const_reference
+    {
+        return self().bucket_data()[index];
+    }
+
+    auto begin() noexcept -> iterator { return self().bucket_data(); }
+    auto begin() const noexcept -> const_iterator { return self().bucket_data(); }
+    auto end() noexcept -> iterator { return begin() + size(); }
+    auto end() const noexcept -> const_iterator { return begin() + size(); }
+
+    [[nodiscard]] auto empty() const noexcept -> bool { return size() == 0; }
+
+    auto size() const noexcept -> size_type { return self().bucket_count_; }
+
+    auto max_size() const noexcept -> size_type { return self().max_size(); }
+
+    void resize(size_type count) { self().resize_buckets(count); }
+
+    void clear() noexcept { self().bucket_count_ = 0; }
+
+    void shrink_to_fit() { self().shrink_to_fit(); }
+
+private:
+    auto self() noexcept -> storage_type& { return static_cast<storage_type&>(*this); }
+
+    auto self() const noexcept -> const storage_type&
+    {
+        return static_cast<const storage_type&>(*this);
+    }
+};
+
+// Storage placing buckets_ and nodes_ in one allocation: a header holding the buckets, followed by
+// the node array. Resizing the buckets also grows the node capacity up to the bucket count, so that
+// a map filled up to its load factor only allocates once per growth step, and a small map lives in
+// exactly one allocation. Shrinking the buckets (clear(), rehash() to a smaller size) reuses the
+// header in place.
+template <class Node, class Allocator>
+class single_block_storage : public single_block_nodes<Node, Allocator>,
+                             public single_block_buckets<Node, Allocator>
+{
+    friend single_block_nodes<Node, Allocator>;
+    friend single_block_buckets<Node, Allocator>;
+
+    using alloc_traits =
+        typename std::allocator_traits<Allocator>::template rebind_traits<Node>;
+
+    static_assert(
+        std::is_pointer_v<typename alloc_traits::pointer>,
+        "single_block_storage requires an allocator returning raw pointers.");
+    static_assert(
+        alignof(Node) >= alignof(std::size_t),
+        "The buckets header must be suitably aligned for the nodes following it.");
+
+public:
+    using nodes_container_type = single_block_nodes<Node, Allocator>;
+    using buckets_container_type = single_block_buckets<Node, Allocator>;
+    using allocator_type = typename alloc_traits::allocator_type;
+    using size_type = std::size_t;
+
+    static constexpr size_type minimum_node_capacity = 8u;
+
+    single_block_storage() noexcept(std::is_nothrow_default_constructible_v<allocator_type>)
+        : single_block_storage(allocator_type())
+    {}
+
+    explicit single_block_storage(const allocator_type& alloc) noexcept : alloc_(alloc) {}
+
+    single_block_storage(const single_block_storage& other)
+        : single_block_storage(
+              other, alloc_traits::select_on_container_copy_construction(other.alloc_))
+    {}
+
+    single_block_storage(const single_block_storage& other, const allocator_type& alloc)
+        : alloc_(alloc)
+    {
+        assign_from(other);
+    }
+
+    single_block_storage(single_block_storage&& other) noexcept : alloc_(std::move(other.alloc_))
+    {
+        steal(other);
+    }
+
+    single_block_storage(single_block_storage&& other, const allocator_type& alloc)
+        : alloc_(alloc)
+    {
+        if (alloc_ == other.alloc_)
+        {
+            steal(other);
+        }
+        else
+        {
+            assign_from(std::move(other));
+        }
+    }
+
+    ~single_block_storage() { release(); }
+
+    auto operator=(const single_block_storage& other) -> single_block_storage&
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        release();
+
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+        {
+            alloc_ = other.alloc_;
+        }
+
+        assign_from(other);
+        return *this;
+    }
+
+    auto operator=(single_block_storage&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value) -> single_block_storage&
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        release();
+
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            alloc_ = std::move(other.alloc_);
+            steal(other);
+        }
+        else
+        {
+            if (alloc_ == other.alloc_)
+            {
+                steal(other);
+            }
+            else
+            {
+                assign_from(std::move(other));
+            }
+        }
+
+        return *this;
+    }
+
+    auto get_allocator() const -> allocator_type { return alloc_; }
+
+    auto nodes() noexcept -> nodes_container_type& { return *this; }
+
+    auto nodes() const noexcept -> const nodes_container_type& { return *this; }
+
+    auto buckets() noexcept -> buckets_container_type& { return *this; }
+
+    auto buckets() const noexcept -> const buckets_container_type& { return *this; }
+
+    void swap(single_block_storage& other) noexcept
+    {
+        using std::swap;
+
+        if constexpr (alloc_traits::propagate_on_container_swap::value)
+        {
+            swap(alloc_, other.alloc_);
+        }
+
+        swap(block_, other.block_);
+        swap(header_slots_, other.header_slots_);
+        swap(bucket_count_, other.bucket_count_);
+        swap(size_, other.size_);
+        swap(capacity_, other.capacity_);
+    }
+
+private:
+    // Number of node-sized slots needed in front of the nodes to hold bucket_count buckets.
+    static constexpr auto header_slots_for(size_type bucket_count) noexcept -> size_type
+    {
+        return (bucket_count * sizeof(size_type) + sizeof(Node) - 1) / sizeof(Node);
+    }
+
+    auto bucket_data() noexcept -> size_type*
+    {
+        return static_cast<size_type*>(static_cast<void*>(block_));
+    }
+
+    auto bucket_data() const noexcept -> const size_type*
+    {
+        return static_cast<const size_type*>(static_cast<const void*>(block_));
+    }
+
+    auto node_data() noexcept -> Node* { return block_ + header_slots_; }
+
+    auto node_data() const noexcept -> const Node* { return block_ + header_slots_; }
+
+    auto max_size() const noexcept -> size_type { return alloc_traits::max_size(alloc_); }
+
+    template <class... Args>
+    auto emplace_node(Args&&... args) -> Node&
+    {
+        if (size_ == capacity_)
+        {
+            // The arguments may refer to the current block (e.g. a bucket): the new node is
+            // constructed in the new block before the old one is released.
+            reallocate<true>(
+                bucket_count_, std::max(minimum_node_capacity, capacity_ * 2),
+                std::forward<Args>(args)...);
+        }
+        else
+        {
+            alloc_traits::construct(alloc_, node_data() + size_, std::forward<Args>(args)...);
+            ++size_;
+        }
+
+        return node_data()[size_ - 1];
+    }
+
+    void pop_node() noexcept
+    {
+        assert(size_ > 0 && "pop_back() called on an empty single_block_storage.");
+        --size_;
+        alloc_traits::destroy(alloc_, node_data() + size_);
+    }
+
+    void destroy_nodes() noexcept
+    {
+        while (size_ > 0)
+        {
+            pop_node();
+        }
+    }
+
+    void reserve_nodes(size_type count)
+    {
+        if (count > capacity_)
+        {
+            reallocate<false>(bucket_count_, count);
+        }
+    }
+
+    // Reallocates the block to the exact size of the buckets and nodes, if it holds more.
+    void shrink_to_fit()
+    {
+        if (size_ == 0 && bucket_count_ == 0)
+        {
+            release();
+        }
+        else if (header_slots_ > header_slots_for(bucket_count_) || capacity_ > size_)
+        {
+            reallocate<false>(bucket_count_, size_);
+        }
+    }
+
+    void resize_buckets(size_type count)
+    {
+        if (header_slots_for(count) <= header_slots_)
+        {
+            if (count > bucket_count_)
+            {
+                std::uninitialized_fill_n(
+                    bucket_data() + bucket_count_, count - bucket_count_, size_type{});
+            }
+
+            bucket_count_ = count;
+            return;
+        }
+
+        reallocate<false>(count, std::max(capacity_, count));
+    }
+
+    template <bool append, class... Args>
+    void reallocate(size_type bucket_count, size_type capacity, Args&&... args)
+    {
+        const auto header_slots = header_slots_for(bucket_count);
+        Node* block = alloc_traits::allocate(alloc_, header_slots + capacity);
+        Node* nodes = block + header_slots;
+        auto* buckets = static_cast<size_type*>(static_cast<void*>(block));
+
+        const auto kept_buckets = std::min(bucket_count, bucket_count_);
+        std::uninitialized_copy_n(bucket_data(), kept_buckets, buckets);
+        std::uninitialized_fill_n(buckets + kept_buckets, bucket_count - kept_buckets, size_type{});
+
+        [[maybe_unused]] bool appended = false;
+        size_type moved = 0;
+
+#ifndef JG_NO_EXCEPTION
+        try
+        {
+#endif
+            if constexpr (append)
+            {
+                alloc_traits::construct(alloc_, nodes + size_, std::forward<Args>(args)...);
+                appended = true;
+            }
+
+            for (; moved < size_; ++moved)
+            {
+                alloc_traits::construct(
+                    alloc_, nodes + moved, std::move_if_noexcept(node_data()[moved]));
+            }
+#ifndef JG_NO_EXCEPTION
+        }
+        catch (...)
+        {
+            for (size_type i = 0; i < moved; ++i)
+            {
+                alloc_traits::destroy(alloc_, nodes + i);
+            }
+
+            if (appended)
+            {
+                alloc_traits::destroy(alloc_, nodes + size_);
+            }
+
+            alloc_traits::deallocate(alloc_, block, header_slots + capacity);
+            throw;
+        }
+#endif
+
+        const auto size = size_ + (append ? 1 : 0);
+        release();
+
+        block_ = block;
+        header_slots_ = header_slots;
+        bucket_count_ = bucket_count;
+        size_ = size;
+        capacity_ = capacity;
+    }
+
+    // Expects an empty storage. Copies or moves the content of other into a block sized for it.
+    template <class Other>
+    void assign_from(Other&& other)
+    {
+        assert(block_ == nullptr);
+
+        if (other.block_ == nullptr)
+        {
+            return;
+        }
+
+        reallocate<false>(other.bucket_count_, std::max(other.size_, other.bucket_count_));
+        std::copy_n(other.bucket_data(), other.bucket_count_, bucket_data());
+
+#ifndef JG_NO_EXCEPTION
+        try
+        {
+#endif
+            for (auto& node : other.nodes())
+            {
+                if constexpr (std::is_lvalue_reference_v<Other>)
+                {
+                    emplace_node(node);
+                }
+                else
+                {
+                    emplace_node(std::move(node));
+                }
+            }
+#ifndef JG_NO_EXCEPTION
+        }
+        catch (...)
+        {
+            release();
+            throw;
+        }
+#endif
+    }
+
+    void steal(single_block_storage& other) noexcept
+    {
+        block_ = std::exchange(other.block_, nullptr);
+        header_slots_ = std::exchange(other.header_slots_, 0u);
+        bucket_count_ = std::exchange(other.bucket_count_, 0u);
+        size_ = std::exchange(other.size_, 0u);
+        capacity_ = std::exchange(other.capacity_, 0u);
+    }
+
+    void release() noexcept
+    {
+        destroy_nodes();
+
+        if (block_ != nullptr)
+        {
+            alloc_traits::deallocate(alloc_, block_, header_slots_ + capacity_);
+        }
+
+        block_ = nullptr;
+        header_slots_ = 0;
+        bucket_count_ = 0;
+        capacity_ = 0;
+    }
+
+    allocator_type alloc_;
+    Node* block_ = nullptr;
+    size_type header_slots_ = 0;
+    size_type bucket_count_ = 0;
+    size_type size_ = 0;
+    size_type capacity_ = 0;
+};
+
+template <class Node, class Allocator>
+void swap(
+    single_block_storage<Node, Allocator>& lhs, single_block_storage<Node, Allocator>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace jg::details
+
+#endif // JG_SINGLE_BLOCK_STORAGE_HPP
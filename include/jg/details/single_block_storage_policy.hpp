@@ -0,0 +1,19 @@
+#ifndef JG_SINGLE_BLOCK_STORAGE_POLICY_HPP
+#define JG_SINGLE_BLOCK_STORAGE_POLICY_HPP
+
+#include "single_block_storage.hpp"
+
+namespace jg::details
+{
+
+// For many small maps: buckets_ and nodes_ share a single allocation, halving the allocator
+// traffic and keeping the buckets right in front of the nodes they point to.
+struct single_block_storage_policy
+{
+    template <class Node, class Allocator>
+    using storage = single_block_storage<Node, Allocator>;
+};
+
+} // namespace jg::details
+
+#endif // JG_SINGLE_BLOCK_STORAGE_POLICY_HPP
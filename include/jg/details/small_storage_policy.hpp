@@ -0,0 +1,29 @@
+#ifndef JG_SMALL_STORAGE_POLICY_HPP
+#define JG_SMALL_STORAGE_POLICY_HPP
+
+#include "small_vector.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace jg::details
+{
+
+// Small-size optimization: up to N nodes are stored inline in the map, and as long as the map holds
+// no more than N entries it has no buckets at all and looks them up with a linear scan of the keys.
+// buckets_ is only allocated once the map outgrows N, so an empty map never allocates.
+template <std::size_t N>
+struct small_storage_policy
+{
+    static constexpr std::size_t linear_scan_capacity = N;
+
+    template <class T, class Allocator>
+    using nodes_container = small_vector<T, Allocator, N>;
+
+    template <class T, class Allocator>
+    using buckets_container = std::vector<T, Allocator>;
+};
+
+} // namespace jg::details
+
+#endif // JG_SMALL_STORAGE_POLICY_HPP
@@ -0,0 +1,383 @@
+#ifndef JG_SMALL_VECTOR_HPP
+#define JG_SMALL_VECTOR_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace jg::details
+{
+
+// A std::vector look-alike keeping up to N elements in an inline buffer and only allocating once it
+// outgrows it. Moving a small_vector whose elements are inline moves the elements one by one, which
+// invalidates iterators and references to them.
+template <class T, class Allocator, std::size_t N>
+class small_vector
+{
+    static_assert(N > 0, "Use a std::vector if no inline capacity is needed.");
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = value_type*;
+    using const_pointer = const value_type*;
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+
+    static constexpr size_type inline_capacity = N;
+
+    small_vector() noexcept(std::is_nothrow_default_constructible_v<allocator_type>)
+        : small_vector(allocator_type())
+    {}
+
+    explicit small_vector(const allocator_type& alloc) noexcept : alloc_(alloc) {}
+
+    small_vector(const small_vector& other)
+        : small_vector(other, alloc_traits::select_on_container_copy_construction(other.alloc_))
+    {}
+
+    small_vector(const small_vector& other, const allocator_type& alloc) : small_vector(alloc)
+    {
+        append_copies(other);
+    }
+
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        : small_vector(other.alloc_)
+    {
+        take(other);
+    }
+
+    small_vector(small_vector&& other, const allocator_type& alloc) : small_vector(alloc)
+    {
+        if (alloc_ == other.alloc_)
+        {
+            take(other);
+        }
+        else
+        {
+            append_moves(other);
+        }
+    }
+
+    ~small_vector() { release(); }
+
+    auto operator=(const small_vector& other) -> small_vector&
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        clear();
+
+        if constexpr (alloc_traits::propagate_on_container_copy_assignment::value)
+        {
+            if (alloc_ != other.alloc_)
+            {
+                release();
+            }
+
+            alloc_ = other.alloc_;
+        }
+
+        append_copies(other);
+        return *this;
+    }
+
+    auto operator=(small_vector&& other) noexcept(
+        std::is_nothrow_move_constructible_v<T> &&
+        (alloc_traits::propagate_on_container_move_assignment::value ||
+         alloc_traits::is_always_equal::value)) -> small_vector&
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        if constexpr (alloc_traits::propagate_on_container_move_assignment::value)
+        {
+            release();
+            alloc_ = std::move(other.alloc_);
+            take(other);
+        }
+        else
+        {
+            if (alloc_ == other.alloc_)
+            {
+                release();
+                take(other);
+            }
+            else
+            {
+                clear();
+                append_moves(other);
+            }
+        }
+
+        return *this;
+    }
+
+    auto get_allocator() const -> allocator_type { return alloc_; }
+
+    auto operator[](size_type index) noexcept -> reference { return data_[index]; }
+
+    auto operator[](size_type index) const noexcept -> const_reference { return data_[index]; }
+
+    auto back() noexcept -> reference { return data_[size_ - 1]; }
+    auto back() const noexcept -> const_reference { return data_[size_ - 1]; }
+
+    auto begin() noexcept -> iterator { return data_; }
+    auto begin() const noexcept -> const_iterator { return data_; }
+    auto cbegin() const noexcept -> const_iterator { return data_; }
+    auto end() noexcept -> iterator { return data_ + size_; }
+    auto end() const noexcept -> const_iterator { return data_ + size_; }
+    auto cend() const noexcept -> const_iterator { return data_ + size_; }
+
+    [[nodiscard]] auto empty() const noexcept -> bool { return size_ == 0; }
+
+    auto size() const noexcept -> size_type { return size_; }
+
+    auto max_size() const noexcept -> size_type { return alloc_traits::max_size(alloc_); }
+
+    auto capacity() const noexcept -> size_type { return capacity_; }
+
+    auto is_inline() const noexcept -> bool { return data_ == inline_data(); }
+
+    void reserve(size_type count)
+    {
+        if (count > capacity_)
+        {
+            reallocate<false>(count);
+        }
+    }
+
+    void clear() noexcept
+    {
+        while (size_ > 0)
+        {
+            pop_back();
+        }
+    }
+
+    // Moves the elements back inline if they fit, otherwise reallocates to the exact size.
+    void shrink_to_fit()
+    {
+        if (is_inline() || size_ == capacity_)
+        {
+            return;
+        }
+
+        if (size_ <= N)
+        {
+            auto* heap_data = std::exchange(data_, inline_data());
+            const auto heap_capacity = std::exchange(capacity_, N);
+            const auto size = std::exchange(size_, 0u);
+
+            for (size_type i = 0; i < size; ++i)
+            {
+                emplace_back(std::move(heap_data[i]));
+                alloc_traits::destroy(alloc_, heap_data + i);
+            }
+
+            alloc_traits::deallocate(alloc_, heap_data, heap_capacity);
+        }
+        else
+        {
+            reallocate<false>(size_);
+        }
+    }
+
+    template <class... Args>
+    auto emplace_back(Args&&... args) -> reference
+    {
+        if (size_ == capacity_)
+        {
+            // The arguments may refer to an element: construct the new one before moving them.
+            reallocate<true>(capacity_ * 2, std::forward<Args>(args)...);
+        }
+        else
+        {
+            alloc_traits::construct(alloc_, data_ + size_, std::forward<Args>(args)...);
+            ++size_;
+        }
+
+        return back();
+    }
+
+    void push_back(const value_type& value) { emplace_back(value); }
+
+    void push_back(value_type&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() noexcept
+    {
+        assert(size_ > 0 && "pop_back() called on an empty small_vector.");
+        --size_;
+        alloc_traits::destroy(alloc_, data_ + size_);
+    }
+
+    void swap(small_vector& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        using std::swap;
+
+        if (!is_inline() && !other.is_inline())
+        {
+            if constexpr (alloc_traits::propagate_on_container_swap::value)
+            {
+                swap(alloc_, other.alloc_);
+            }
+
+            swap(data_, other.data_);
+            swap(size_, other.size_);
+            swap(capacity_, other.capacity_);
+            return;
+        }
+
+        small_vector tmp(std::move(other));
+        other.release();
+        other.take(*this);
+        release();
+        take(tmp);
+    }
+
+private:
+    auto inline_data() noexcept -> T* { return reinterpret_cast<T*>(inline_buffer_); }
+
+    auto inline_data() const noexcept -> const T*
+    {
+        return reinterpret_cast<const T*>(inline_buffer_);
+    }
+
+    template <bool append, class... Args>
+    void reallocate(size_type new_capacity, Args&&... args)
+    {
+        T* new_data = alloc_traits::allocate(alloc_, new_capacity);
+
+        [[maybe_unused]] bool appended = false;
+        size_type moved = 0;
+
+#ifndef JG_NO_EXCEPTION
+        try
+        {
+#endif
+            if constexpr (append)
+            {
+                alloc_traits::construct(alloc_, new_data + size_, std::forward<Args>(args)...);
+                appended = true;
+            }
+
+            for (; moved < size_; ++moved)
+            {
+                alloc_traits::construct(
+                    alloc_, new_data + moved, std::move_if_noexcept(data_[moved]));
+            }
+#ifndef JG_NO_EXCEPTION
+        }
+        catch (...)
+        {
+            for (size_type i = 0; i < moved; ++i)
+            {
+                alloc_traits::destroy(alloc_, new_data + i);
+            }
+
+            if (appended)
+            {
+                alloc_traits::destroy(alloc_, new_data + size_);
+            }
+
+            alloc_traits::deallocate(alloc_, new_data, new_capacity);
+            throw;
+        }
+#endif
+
+        const auto size = size_ + (append ? 1 : 0);
+        release();
+
+        data_ = new_data;
+        size_ = size;
+        capacity_ = new_capacity;
+    }
+
+    void append_copies(const small_vector& other)
+    {
+        reserve(size_ + other.size_);
+
+        for (const auto& value : other)
+        {
+            emplace_back(value);
+        }
+    }
+
+    void append_moves(small_vector& other)
+    {
+        reserve(size_ + other.size_);
+
+        for (auto& value : other)
+        {
+            emplace_back(std::move(value));
+        }
+
+        other.clear();
+    }
+
+    // Expects an empty, inline small_vector. Steals the heap buffer of other, or moves its inline
+    // elements.
+    void take(small_vector& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        assert(empty() && is_inline());
+
+        if (other.is_inline())
+        {
+            for (auto& value : other)
+            {
+                alloc_traits::construct(alloc_, data_ + size_, std::move(value));
+                ++size_;
+            }
+
+            other.clear();
+        }
+        else
+        {
+            data_ = std::exchange(other.data_, other.inline_data());
+            size_ = std::exchange(other.size_, 0u);
+            capacity_ = std::exchange(other.capacity_, N);
+        }
+    }
+
+    void release() noexcept
+    {
+        clear();
+
+        if (!is_inline())
+        {
+            alloc_traits::deallocate(alloc_, data_, capacity_);
+            data_ = inline_data();
+            capacity_ = N;
+        }
+    }
+
+    allocator_type alloc_;
+    T* data_ = inline_data();
+    size_type size_ = 0;
+    size_type capacity_ = N;
+    alignas(T) unsigned char inline_buffer_[N * sizeof(T)];
+};
+
+template <class T, class Allocator, std::size_t N>
+void swap(small_vector<T, Allocator, N>& lhs, small_vector<T, Allocator, N>& rhs) noexcept(
+    noexcept(lhs.swap(rhs)))
+{
+    lhs.swap(rhs);
+}
+
+} // namespace jg::details
+
+#endif // JG_SMALL_VECTOR_HPP
@@ -0,0 +1,69 @@
+#ifndef JG_SPLIT_STORAGE_HPP
+#define JG_SPLIT_STORAGE_HPP
+
+#include <type_traits>
+#include <utility>
+
+namespace jg::details
+{
+
+// Default storage of the map: buckets_ and nodes_ are two independent containers, each one owning
+// its own allocation.
+template <class NodesContainer, class BucketsContainer>
+class split_storage
+{
+public:
+    using nodes_container_type = NodesContainer;
+    using buckets_container_type = BucketsContainer;
+
+    constexpr split_storage() = default;
+
+    template <class Allocator>
+    constexpr explicit split_storage(const Allocator& alloc) : buckets_(alloc), nodes_(alloc)
+    {}
+
+    template <class Allocator>
+    constexpr split_storage(const split_storage& other, const Allocator& alloc)
+        : buckets_(other.buckets_, alloc), nodes_(other.nodes_, alloc)
+    {}
+
+    template <class Allocator>
+    constexpr split_storage(split_storage&& other, const Allocator& alloc)
+        : buckets_(std::move(other.buckets_), alloc), nodes_(std::move(other.nodes_), alloc)
+    {}
+
+    constexpr auto get_allocator() const { return buckets_.get_allocator(); }
+
+    constexpr auto nodes() noexcept -> nodes_container_type& { return nodes_; }
+
+    constexpr auto nodes() const noexcept -> const nodes_container_type& { return nodes_; }
+
+    constexpr auto buckets() noexcept -> buckets_container_type& { return buckets_; }
+
+    constexpr auto buckets() const noexcept -> const buckets_container_type& { return buckets_; }
+
+    constexpr void swap(split_storage& other) noexcept(
+        std::is_nothrow_swappable_v<buckets_container_type>&&
+            std::is_nothrow_swappable_v<nodes_container_type>)
+    {
+        using std::swap;
+        swap(buckets_, other.buckets_);
+        swap(nodes_, other.nodes_);
+    }
+
+private:
+    buckets_container_type buckets_;
+    nodes_container_type nodes_;
+};
+
+template <class NodesContainer, class BucketsContainer>
+constexpr void swap(
+    split_storage<NodesContainer, BucketsContainer>& lhs,
+    split_storage<NodesContainer, BucketsContainer>& rhs) noexcept(noexcept(lhs.swap(rhs)))
+{
+    lhs.swap(rhs);
+}
+
+} // namespace jg::details
+
+#endif // JG_SPLIT_STORAGE_HPP
@@ -0,0 +1,247 @@
+#ifndef JG_TIMING_WHEEL_HPP
+#define JG_TIMING_WHEEL_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace jg::details
+{
+
+// Where an entry sits in a timing_wheel: its slot, and its position in the slot.
+struct wheel_location
+{
+    std::size_t slot = std::numeric_limits<std::size_t>::max();
+    std::size_t position = 0;
+};
+
+// A hierarchical timing wheel of node indices, each with a deadline given as a tick. Level l has
+// slot_count slots of slot_count^l ticks each, covering the ticks that share their level l + 1
+// block with the current tick, and the deadlines beyond the last level share an overflow slot.
+// When the current tick enters a new block of a level, the slot of the level above holding that
+// block is cascaded into the finer levels.
+//
+// The owner keeps the location of every node, reached through location_of(node), which the wheel
+// updates when it moves a node between or within slots. When the owner moves a node to another
+// index, it tells the wheel with relocate().
+template <class Allocator>
+class timing_wheel
+{
+    struct item
+    {
+        std::size_t node;
+        std::uint64_t tick;
+    };
+
+    using alloc_traits = std::allocator_traits<Allocator>;
+    using slot_type = std::vector<item, typename alloc_traits::template rebind_alloc<item>>;
+    using slots_type =
+        std::vector<slot_type, typename alloc_traits::template rebind_alloc<slot_type>>;
+
+public:
+    static constexpr std::size_t slot_bits = 6;
+    static constexpr std::size_t slot_count = std::size_t{1} << slot_bits;
+    static constexpr std::size_t level_count = 4;
+    static constexpr std::size_t overflow_slot = level_count * slot_count;
+
+    explicit timing_wheel(const Allocator& alloc = Allocator())
+        : slots_(overflow_slot + 1, slot_type(alloc), alloc)
+    {}
+
+    timing_wheel(const timing_wheel& other, const Allocator& alloc)
+        : slots_(other.slots_, alloc)
+        , level_sizes_(other.level_sizes_)
+        , size_(other.size_)
+        , current_(other.current_)
+    {}
+
+    constexpr auto size() const noexcept -> std::size_t { return size_; }
+
+    constexpr auto current() const noexcept -> std::uint64_t { return current_; }
+
+    void clear() noexcept
+    {
+        for (auto& slot : slots_)
+        {
+            slot.clear();
+        }
+
+        level_sizes_ = {};
+        size_ = 0;
+    }
+
+    template <class LocationOf>
+    void insert(std::size_t node, std::uint64_t tick, LocationOf location_of)
+    {
+        const auto slot = slot_of(tick);
+        auto& items = slots_[slot];
+        items.push_back({node, tick});
+        location_of(node) = {slot, items.size() - 1};
+        ++level_sizes_[slot / slot_count];
+        ++size_;
+    }
+
+    template <class LocationOf>
+    void erase(std::size_t node, LocationOf location_of) noexcept
+    {
+        const auto location = location_of(node);
+        auto& items = slots_[location.slot];
+
+        if (location.position + 1 != items.size())
+        {
+            items[location.position] = items.back();
+            location_of(items[location.position].node).position = location.position;
+        }
+
+        items.pop_back();
+        --level_sizes_[location.slot / slot_count];
+        --size_;
+    }
+
+    // The node at location is now at index node.
+    void relocate(std::size_t node, const wheel_location& location) noexcept
+    {
+        slots_[location.slot][location.position].node = node;
+    }
+
+    // Moves the current tick to now, removing from the wheel the nodes whose tick has passed and
+    // calling on_due(node) for each of them. The nodes of the now tick are removed if is_due(node).
+    template <class LocationOf, class IsDue, class OnDue>
+    void advance(std::uint64_t now, LocationOf location_of, IsDue is_due, OnDue on_due)
+    {
+        for (;;)
+        {
+            cascade(location_of);
+            expire_slot(current_ & (slot_count - 1), current_ < now, location_of, is_due, on_due);
+
+            if (current_ >= now)
+            {
+                return;
+            }
+
+            current_ = std::min(now, next_tick());
+        }
+    }
+
+private:
+    // The slot of tick, as seen from the current tick. The past ticks go to the current one.
+    auto slot_of(std::uint64_t tick) const noexcept -> std::size_t
+    {
+        tick = std::max(tick, current_);
+
+        for (std::size_t level = 0; level < level_count; ++level)
+        {
+            const auto block_bits = (level + 1) * slot_bits;
+
+            if ((tick >> block_bits) == (current_ >> block_bits))
+            {
+                return level * slot_count + ((tick >> (level * slot_bits)) & (slot_count - 1));
+            }
+        }
+
+        return overflow_slot;
+    }
+
+    // The next tick at which the wheel has something to do: the next one while the level 0 holds
+    // nodes, otherwise the next block of the lowest level holding nodes, to cascade it.
+    auto next_tick() const noexcept -> std::uint64_t
+    {
+        if (size_ == 0u)
+        {
+            return std::numeric_limits<std::uint64_t>::max();
+        }
+
+        std::size_t level = 0;
+
+        while (level < level_count && level_sizes_[level] == 0u)
+        {
+            ++level;
+        }
+
+        if (level < level_count)
+        {
+            return ((current_ >> (level * slot_bits)) + 1) << (level * slot_bits);
+        }
+
+        // Only the overflow slot holds nodes: go straight to the block of the earliest of them.
+        const auto& overflow = slots_[overflow_slot];
+        const auto earliest = std::min_element(
+            overflow.begin(), overflow.end(),
+            [](const item& lhs, const item& rhs) { return lhs.tick < rhs.tick; });
+        const auto block_bits = level_count * slot_bits;
+        return (earliest->tick >> block_bits) << block_bits;
+    }
+
+    // Re-inserts the nodes of the slots whose block the current tick has just entered, from the
+    // overflow slot down to the level 1.
+    template <class LocationOf>
+    void cascade(LocationOf location_of)
+    {
+        for (std::size_t level = level_count; level > 0; --level)
+        {
+            if ((current_ & ((std::uint64_t{1} << (level * slot_bits)) - 1)) != 0u)
+            {
+                continue;
+            }
+
+            const auto slot = level == level_count
+                                  ? overflow_slot
+                                  : level * slot_count +
+                                        ((current_ >> (level * slot_bits)) & (slot_count - 1));
+
+            if (slots_[slot].empty())
+            {
+                continue;
+            }
+
+            slot_type items(slots_[slot].get_allocator());
+            items.swap(slots_[slot]);
+            level_sizes_[level] -= items.size();
+            size_ -= items.size();
+
+            for (const auto& cascaded : items)
+            {
+                insert(cascaded.node, cascaded.tick, location_of);
+            }
+        }
+    }
+
+    template <class LocationOf, class IsDue, class OnDue>
+    void expire_slot(
+        std::size_t slot, bool all_due, LocationOf location_of, IsDue is_due, OnDue on_due)
+    {
+        auto& items = slots_[slot];
+        std::size_t kept = 0;
+
+        for (std::size_t i = 0; i < items.size(); ++i)
+        {
+            if (all_due || is_due(items[i].node))
+            {
+                on_due(items[i].node);
+                continue;
+            }
+
+            items[kept] = items[i];
+            location_of(items[kept].node).position = kept;
+            ++kept;
+        }
+
+        level_sizes_[0] -= items.size() - kept;
+        size_ -= items.size() - kept;
+        items.resize(kept);
+    }
+
+    slots_type slots_;
+    std::array<std::size_t, level_count + 1> level_sizes_{};
+    std::size_t size_ = 0;
+    std::uint64_t current_ = 0;
+};
+
+} // namespace jg::details
+
+#endif // JG_TIMING_WHEEL_HPP
@@ -0,0 +1,21 @@
+#ifndef JG_VECTOR_STORAGE_POLICY_HPP
+#define JG_VECTOR_STORAGE_POLICY_HPP
+
+#include <vector>
+
+namespace jg::details
+{
+
+// Default storage: buckets_ and nodes_ are plain contiguous std::vector.
+struct vector_storage_policy
+{
+    template <class T, class Allocator>
+    using nodes_container = std::vector<T, Allocator>;
+
+    template <class T, class Allocator>
+    using buckets_container = std::vector<T, Allocator>;
+};
+
+} // namespace jg::details
+
+#endif // JG_VECTOR_STORAGE_POLICY_HPP
@@ -0,0 +1,257 @@
+#ifndef JG_HUGE_PAGE_ALLOCATOR_HPP
+#define JG_HUGE_PAGE_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <memory_resource>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace jg
+{
+namespace details
+{
+    static constexpr const std::size_t huge_page_size = std::size_t{2} * 1024u * 1024u;
+    static constexpr const std::size_t small_page_size = std::size_t{4} * 1024u;
+
+    [[noreturn]] inline void throw_bad_alloc()
+    {
+#ifdef JG_NO_EXCEPTION
+        std::abort();
+#else
+        throw std::bad_alloc();
+#endif
+    }
+
+    [[nodiscard]] constexpr auto round_to_huge_page(std::size_t bytes) noexcept -> std::size_t
+    {
+        return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+    }
+
+    // Writes one byte per small page so that the page faults happen now rather than on the first
+    // random access. Used when the kernel cannot populate the range for us.
+    inline void touch_pages(void* p, std::size_t bytes) noexcept
+    {
+        auto* first = static_cast<volatile char*>(p);
+
+        for (std::size_t offset = 0; offset < bytes; offset += small_page_size)
+        {
+            first[offset] = 0;
+        }
+    }
+
+#if defined(__linux__)
+
+    // Maps a 2MB aligned anonymous range, asks for transparent huge pages and pre-faults it.
+    // madvise failures are ignored: without THP we simply end up with regular pages.
+    [[nodiscard]] inline auto map_huge_pages(std::size_t bytes, bool prefault) -> void*
+    {
+        const auto size = round_to_huge_page(bytes);
+
+        // Over-map by one huge page so that the range can be trimmed to a 2MB boundary, otherwise
+        // the kernel may not be able to back the first and last pages with huge pages.
+        const auto mapped_size = size + huge_page_size;
+        void* mapped = ::mmap(
+            nullptr, mapped_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if (mapped == MAP_FAILED)
+        {
+            throw_bad_alloc();
+        }
+
+        const auto address = reinterpret_cast<std::uintptr_t>(mapped);
+        const auto aligned = (address + huge_page_size - 1) & ~(huge_page_size - 1);
+        const auto head = aligned - address;
+        const auto tail = mapped_size - head - size;
+
+        if (head > 0)
+        {
+            ::munmap(mapped, head);
+        }
+
+        if (tail > 0)
+        {
+            ::munmap(reinterpret_cast<void*>(aligned + size), tail);
+        }
+
+        auto* p = reinterpret_cast<void*>(aligned);
+
+#if defined(MADV_HUGEPAGE)
+        ::madvise(p, size, MADV_HUGEPAGE);
+#endif
+
+        if (prefault)
+        {
+#if defined(MADV_POPULATE_WRITE)
+            if (::madvise(p, size, MADV_POPULATE_WRITE) != 0)
+            {
+                touch_pages(p, size);
+            }
+#else
+            touch_pages(p, size);
+#endif
+        }
+
+        return p;
+    }
+
+    inline void unmap_huge_pages(void* p, std::size_t bytes) noexcept
+    {
+        ::munmap(p, round_to_huge_page(bytes));
+    }
+
+    static constexpr const bool has_huge_page_support = true;
+
+#else
+
+    [[nodiscard]] inline auto map_huge_pages(std::size_t bytes, bool prefault) -> void*
+    {
+        void* p = ::operator new(bytes, std::align_val_t{small_page_size});
+
+        if (prefault)
+        {
+            touch_pages(p, bytes);
+        }
+
+        return p;
+    }
+
+    inline void unmap_huge_pages(void* p, std::size_t /*bytes*/) noexcept
+    {
+        ::operator delete(p, std::align_val_t{small_page_size});
+    }
+
+    static constexpr const bool has_huge_page_support = false;
+
+#endif
+
+} // namespace details
+
+// Allocator placing large blocks (the buckets_ and nodes_ arrays of a big dense_hash_map) on 2MB
+// transparent huge pages. Blocks are pre-faulted at allocation time, which means that a reserve()
+// pays for all the page faults upfront instead of spreading latency spikes over the next inserts.
+// Blocks smaller than huge_page_threshold go through the regular std::allocator.
+template <class T, bool Prefault = true>
+class huge_page_allocator
+{
+public:
+    using value_type = T;
+    using is_always_equal = std::true_type;
+
+    static constexpr std::size_t huge_page_threshold = details::huge_page_size / 2;
+
+    template <class U>
+    struct rebind
+    {
+        using other = huge_page_allocator<U, Prefault>;
+    };
+
+    constexpr huge_page_allocator() noexcept = default;
+
+    template <class U>
+    constexpr huge_page_allocator(const huge_page_allocator<U, Prefault>& /*other*/) noexcept
+    {}
+
+    [[nodiscard]] auto allocate(std::size_t n) -> T*
+    {
+        const auto bytes = n * sizeof(T);
+
+        if (bytes < huge_page_threshold)
+        {
+            return std::allocator<T>{}.allocate(n);
+        }
+
+        return static_cast<T*>(details::map_huge_pages(bytes, Prefault));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+        const auto bytes = n * sizeof(T);
+
+        if (bytes < huge_page_threshold)
+        {
+            std::allocator<T>{}.deallocate(p, n);
+            return;
+        }
+
+        details::unmap_huge_pages(p, bytes);
+    }
+};
+
+template <class T, class U, bool Prefault>
+constexpr auto operator==(
+    const huge_page_allocator<T, Prefault>& /*lhs*/,
+    const huge_page_allocator<U, Prefault>& /*rhs*/) noexcept -> bool
+{
+    return true;
+}
+
+template <class T, class U, bool Prefault>
+constexpr auto operator!=(
+    const huge_page_allocator<T, Prefault>& /*lhs*/,
+    const huge_page_allocator<U, Prefault>& /*rhs*/) noexcept -> bool
+{
+    return false;
+}
+
+namespace pmr
+{
+    // Memory resource counterpart of huge_page_allocator, meant for jg::pmr::dense_hash_map.
+    // Small blocks are forwarded to the upstream resource.
+    class huge_page_resource : public std::pmr::memory_resource
+    {
+    public:
+        static constexpr std::size_t huge_page_threshold = details::huge_page_size / 2;
+
+        huge_page_resource() noexcept : huge_page_resource(std::pmr::get_default_resource()) {}
+
+        explicit huge_page_resource(
+            std::pmr::memory_resource* upstream, bool prefault = true) noexcept
+            : upstream_(upstream), prefault_(prefault)
+        {}
+
+        huge_page_resource(const huge_page_resource&) = delete;
+        auto operator=(const huge_page_resource&) -> huge_page_resource& = delete;
+
+        auto upstream_resource() const noexcept -> std::pmr::memory_resource* { return upstream_; }
+
+    private:
+        auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override
+        {
+            if (bytes < huge_page_threshold || alignment > details::huge_page_size)
+            {
+                return upstream_->allocate(bytes, alignment);
+            }
+
+            return details::map_huge_pages(bytes, prefault_);
+        }
+
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+        {
+            if (bytes < huge_page_threshold || alignment > details::huge_page_size)
+            {
+                upstream_->deallocate(p, bytes, alignment);
+                return;
+            }
+
+            details::unmap_huge_pages(p, bytes);
+        }
+
+        auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override
+        {
+            return this == &other;
+        }
+
+        std::pmr::memory_resource* upstream_;
+        bool prefault_;
+    };
+} // namespace pmr
+
+} // namespace jg
+
+#endif // JG_HUGE_PAGE_ALLOCATOR_HPP
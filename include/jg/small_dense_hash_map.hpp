@@ -0,0 +1,38 @@
+#ifndef JG_SMALL_DENSE_HASH_MAP_HPP
+#define JG_SMALL_DENSE_HASH_MAP_HPP
+
+#include "dense_hash_map.hpp"
+#include "details/small_storage_policy.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+namespace jg
+{
+
+// A dense_hash_map keeping up to N entries inline, looked up by a linear scan without any bucket.
+// It switches to the hashed representation when it outgrows N and goes back to the linear one on
+// clear(). bucket_count() and load_factor() are 0 while the map is in linear mode, and the bucket
+// interface, bucket() and the local iterators, must not be used then.
+template <
+    class Key, class T, std::size_t N = 8, class Hash = std::hash<Key>,
+    class Pred = std::equal_to<Key>, class Allocator = std::allocator<std::pair<const Key, T>>>
+using small_dense_hash_map = dense_hash_map<
+    Key, T, Hash, Pred, Allocator, details::power_of_two_growth_policy,
+    details::small_storage_policy<N>>;
+
+namespace pmr
+{
+    template <
+        class Key, class T, std::size_t N = 8, class Hash = std::hash<Key>,
+        class Pred = std::equal_to<Key>>
+    using small_dense_hash_map = jg::small_dense_hash_map<
+        Key, T, N, Hash, Pred, std::pmr::polymorphic_allocator<std::pair<const Key, T>>>;
+} // namespace pmr
+
+} // namespace jg
+
+#endif // JG_SMALL_DENSE_HASH_MAP_HPP
@@ -1,12 +1,26 @@
 #define CATCH_CONFIG_MAIN // This tells Catch to provide a main() - only do this in one cpp file
 
 #include "catch2/catch.hpp"
+#include "jg/dense_bimap.hpp"
 #include "jg/dense_hash_map.hpp"
+#include "jg/dense_hash_map_algorithms.hpp"
+#include "jg/dense_hash_multimap.hpp"
+#include "jg/dense_hash_set.hpp"
+#include "jg/dense_index.hpp"
+#include "jg/dense_lru_cache.hpp"
+#include "jg/dense_string_map.hpp"
+#include "jg/dense_ttl_map.hpp"
+#include "jg/small_dense_hash_map.hpp"
 #include "jg/details/type_traits.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <memory_resource>
+#include <new>
+#include <numeric>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace
@@ -165,6 +179,138 @@ struct counting_pmr_resource : std::pmr::memory_resource
 
     int* alloc_counter = nullptr;
 };
+
+// A stateful allocator without a default constructor, counting the allocations made through it.
+template <class T>
+struct counting_allocator
+{
+    using value_type = T;
+
+    explicit counting_allocator(int* alloc_counter) noexcept : alloc_counter(alloc_counter) {}
+
+    template <class U>
+    counting_allocator(const counting_allocator<U>& other) noexcept
+        : alloc_counter(other.alloc_counter)
+    {}
+
+    auto allocate(std::size_t n) -> T*
+    {
+        ++(*alloc_counter);
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept { std::allocator<T>{}.deallocate(p, n); }
+
+    int* alloc_counter;
+};
+
+template <class T, class U>
+auto operator==(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) -> bool
+{
+    return lhs.alloc_counter == rhs.alloc_counter;
+}
+
+template <class T, class U>
+auto operator!=(const counting_allocator<T>& lhs, const counting_allocator<U>& rhs) -> bool
+{
+    return !(lhs == rhs);
+}
+
+// Counts its calls without any state, so that all its instances are known to be equivalent.
+struct stateless_counting_hash
+{
+    auto operator()(int i) const -> std::size_t
+    {
+        ++calls;
+        return std::hash<int>{}(i);
+    }
+
+    static inline std::size_t calls = 0;
+};
+
+struct lifetime_counts
+{
+    int constructions = 0;
+    int copies = 0;
+    int moves = 0;
+};
+
+// A key counting how many times it is built from a std::string_view, copied and moved.
+struct counted_string
+{
+    explicit counted_string(std::string_view s) : value(s) { ++counts.constructions; }
+
+    counted_string(const counted_string& other) : value(other.value) { ++counts.copies; }
+
+    counted_string(counted_string&& other) noexcept : value(std::move(other.value))
+    {
+        ++counts.moves;
+    }
+
+    auto operator=(const counted_string&) -> counted_string& = default;
+    auto operator=(counted_string&&) noexcept -> counted_string& = default;
+
+    std::string value;
+    static inline lifetime_counts counts;
+};
+
+auto operator==(const counted_string& lhs, const counted_string& rhs) -> bool
+{
+    return lhs.value == rhs.value;
+}
+
+auto operator==(const counted_string& lhs, std::string_view rhs) -> bool
+{
+    return lhs.value == rhs;
+}
+
+struct counted_value
+{
+    counted_value(int v) : value(v) { ++counts.constructions; }
+
+    counted_value(const counted_value& other) : value(other.value) { ++counts.copies; }
+
+    counted_value(counted_value&& other) noexcept : value(other.value) { ++counts.moves; }
+
+    auto operator=(const counted_value&) -> counted_value& = default;
+    auto operator=(counted_value&&) noexcept -> counted_value& = default;
+
+    int value;
+    static inline lifetime_counts counts;
+};
+
+auto operator==(const lifetime_counts& lhs, const lifetime_counts& rhs) -> bool
+{
+    return lhs.constructions == rhs.constructions && lhs.copies == rhs.copies &&
+           lhs.moves == rhs.moves;
+}
+
+auto operator<<(std::ostream& os, const lifetime_counts& counts) -> std::ostream&
+{
+    return os << "{" << counts.constructions << ", " << counts.copies << ", " << counts.moves
+              << "}";
+}
+
+// Transparent the C++20 way: through is_transparent on both the hasher and the key equal.
+struct string_view_hash
+{
+    using is_transparent = void;
+
+    auto operator()(std::string_view s) const -> std::size_t
+    {
+        return std::hash<std::string_view>{}(s);
+    }
+
+    auto operator()(const counted_string& s) const -> std::size_t { return (*this)(s.value); }
+};
+
+struct counted_string_hash
+{
+    auto operator()(const counted_string& s) const -> std::size_t
+    {
+        return std::hash<std::string>{}(s.value);
+    }
+};
 } // namespace
 
 namespace std
@@ -539,6 +685,18 @@ TEST_CASE("iterator")
         static_assert(std::is_same_v<decltype((m.cbegin()->second)), const int&>);
         REQUIRE(std::equal(expected.cbegin(), expected.cend(), m.cbegin(), m.cend()));
     }
+
+    SECTION("random access")
+    {
+        auto it = m.begin();
+        REQUIRE((it + 2)->first == "jacques");
+        REQUIRE((2 + it)->first == "jacques");
+        REQUIRE(it[1].first == "paul");
+        REQUIRE((m.end() - 1)->first == "jacques");
+        REQUIRE((it++)->first == "pierre");
+        REQUIRE((it--)->first == "paul");
+        REQUIRE(it == m.begin());
+    }
 }
 TEST_CASE("clear")
 {
@@ -569,6 +727,111 @@ TEST_CASE("clear")
     SECTION("no_except") { REQUIRE(noexcept(m.clear())); }
 }
 
+TEST_CASE("clear keeping capacity")
+{
+    int counter = 0;
+    auto r = counting_pmr_resource(&counter);
+    jg::pmr::dense_hash_map<int, int> m(8u, &r);
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        m.try_emplace(i, i);
+    }
+
+    const auto bucket_count = m.bucket_count();
+
+    SECTION("refill does not allocate")
+    {
+        const auto allocations = counter;
+
+        for (int round = 0; round < 3; ++round)
+        {
+            m.clear(jg::keep_capacity);
+            REQUIRE(m.empty());
+            REQUIRE(m.bucket_count() == bucket_count);
+            REQUIRE_FALSE(m.contains(0));
+
+            for (int i = 0; i < 1000; ++i)
+            {
+                REQUIRE(m.try_emplace(i, i + round).second);
+            }
+
+            REQUIRE(m.at(999) == 999 + round);
+        }
+
+        REQUIRE(counter == allocations);
+    }
+
+    SECTION("sparse")
+    {
+        m.clear(jg::keep_capacity);
+
+        for (int i = 0; i < 10; ++i)
+        {
+            m.try_emplace(i, i);
+        }
+
+        m.clear(jg::keep_capacity);
+        REQUIRE(m.bucket_count() == bucket_count);
+
+        for (std::size_t i = 0; i < m.bucket_count(); ++i)
+        {
+            REQUIRE(m.bucket_size(i) == 0u);
+        }
+
+        m.try_emplace(5, 5);
+        REQUIRE(m.size() == 1u);
+        REQUIRE(m.at(5) == 5);
+    }
+
+    SECTION("shrink_to_fit")
+    {
+        m.clear(jg::keep_capacity);
+        m.try_emplace(1, 1);
+        m.shrink_to_fit();
+        REQUIRE(m.bucket_count() == 8u);
+        REQUIRE(m.at(1) == 1);
+    }
+
+    SECTION("no_except") { REQUIRE(noexcept(m.clear(jg::keep_capacity))); }
+}
+
+TEST_CASE("shrink_to_fit with every storage")
+{
+    auto check = [](auto m) {
+        for (int i = 0; i < 1000; ++i)
+        {
+            m.try_emplace(i, std::to_string(i));
+        }
+
+        for (int i = 0; i < 997; ++i)
+        {
+            m.erase(i);
+        }
+
+        m.shrink_to_fit();
+        REQUIRE(m.size() == 3u);
+        REQUIRE(m.at(998) == "998");
+
+        m.clear(jg::keep_capacity);
+        m.shrink_to_fit();
+        REQUIRE(m.empty());
+        m.try_emplace(1, "1");
+        REQUIRE(m.at(1) == "1");
+    };
+
+    check(jg::dense_hash_map<int, std::string>{});
+    check(jg::small_dense_hash_map<int, std::string, 4>{});
+    check(jg::dense_hash_map<
+          int, std::string, std::hash<int>, std::equal_to<int>,
+          std::allocator<std::pair<const int, std::string>>,
+          jg::details::power_of_two_growth_policy, jg::details::segmented_storage_policy<4>>{});
+    check(jg::dense_hash_map<
+          int, std::string, std::hash<int>, std::equal_to<int>,
+          std::allocator<std::pair<const int, std::string>>,
+          jg::details::power_of_two_growth_policy, jg::details::single_block_storage_policy>{});
+}
+
 template <class T, class V>
 using has_insert = decltype(std::declval<T>().insert(std::declval<V>()));
 
@@ -967,6 +1230,87 @@ TEST_CASE("emplace optimization", "[emplace]")
     }
 }
 
+TEST_CASE("emplace constructions", "[emplace]")
+{
+    using namespace std::string_view_literals;
+    using constructed = lifetime_counts;
+
+    const auto reset_counts = [] {
+        counted_string::counts = {};
+        counted_value::counts = {};
+    };
+
+    SECTION("heterogeneous keys are built in place")
+    {
+        jg::dense_hash_map<counted_string, counted_value, string_view_hash, std::equal_to<>> m;
+        m.reserve(8);
+
+        reset_counts();
+        REQUIRE(m.emplace("a"sv, 1).second);
+        REQUIRE(counted_string::counts == constructed{1, 0, 0});
+        REQUIRE(counted_value::counts == constructed{1, 0, 0});
+
+        reset_counts();
+        REQUIRE(m.emplace(std::pair("b"sv, 2)).second);
+        REQUIRE(counted_string::counts == constructed{1, 0, 0});
+        REQUIRE(counted_value::counts == constructed{1, 0, 0});
+
+        reset_counts();
+        REQUIRE(m.emplace(
+                     std::piecewise_construct, std::forward_as_tuple("c"sv),
+                     std::forward_as_tuple(3))
+                    .second);
+        REQUIRE(counted_string::counts == constructed{1, 0, 0});
+        REQUIRE(counted_value::counts == constructed{1, 0, 0});
+
+        reset_counts();
+        REQUIRE_FALSE(m.emplace("a"sv, 4).second);
+        REQUIRE_FALSE(m.emplace(std::pair("b"sv, 5)).second);
+        REQUIRE_FALSE(m.emplace(
+                           std::piecewise_construct, std::forward_as_tuple("c"sv),
+                           std::forward_as_tuple(6))
+                          .second);
+        REQUIRE(counted_string::counts == constructed{});
+        REQUIRE(counted_value::counts == constructed{});
+    }
+
+    SECTION("converted keys are built once and the mapped values in place")
+    {
+        jg::dense_hash_map<counted_string, counted_value, counted_string_hash> m;
+        m.reserve(8);
+
+        reset_counts();
+        REQUIRE(m.emplace("a"sv, 1).second);
+        REQUIRE(counted_string::counts == constructed{1, 0, 1});
+        REQUIRE(counted_value::counts == constructed{1, 0, 0});
+
+        reset_counts();
+        REQUIRE(m.emplace(
+                     std::piecewise_construct, std::forward_as_tuple("b"sv),
+                     std::forward_as_tuple(2))
+                    .second);
+        REQUIRE(counted_string::counts == constructed{1, 0, 1});
+        REQUIRE(counted_value::counts == constructed{1, 0, 0});
+
+        reset_counts();
+        const counted_string key{"c"sv};
+        REQUIRE(m.emplace(std::piecewise_construct, std::forward_as_tuple(key), std::tuple(3))
+                    .second);
+        REQUIRE(counted_string::counts == constructed{1, 1, 0});
+        REQUIRE(counted_value::counts == constructed{1, 0, 0});
+
+        reset_counts();
+        REQUIRE_FALSE(m.emplace(
+                           std::piecewise_construct, std::forward_as_tuple("b"sv),
+                           std::forward_as_tuple(4))
+                          .second);
+        REQUIRE_FALSE(m.emplace(key, 5).second);
+        REQUIRE(counted_string::counts == constructed{1, 0, 0});
+        REQUIRE(counted_value::counts == constructed{});
+        REQUIRE(m.at(key).value == 3);
+    }
+}
+
 TEST_CASE("emplace_hint")
 {
     jg::dense_hash_map<std::string, int> m;
@@ -1094,6 +1438,99 @@ TEST_CASE("try_emplace effects guarantees", "[try_emplace]")
     }
 }
 
+TEST_CASE("upsert")
+{
+    SECTION("counting")
+    {
+        const std::vector<std::string> words = {"a", "b", "a", "c", "a", "b"};
+        jg::dense_hash_map<std::string, int> counts;
+        int made = 0;
+
+        for (const auto& word : words)
+        {
+            counts.upsert(
+                word,
+                [&made] {
+                    ++made;
+                    return 1;
+                },
+                [](int& count) { ++count; });
+        }
+
+        REQUIRE(made == 3);
+        REQUIRE(counts.size() == 3);
+        REQUIRE(counts.at("a") == 3);
+        REQUIRE(counts.at("b") == 2);
+        REQUIRE(counts.at("c") == 1);
+    }
+
+    SECTION("result")
+    {
+        jg::dense_hash_map<std::unique_ptr<int>, std::string> m;
+
+        const auto [it, inserted] = m.upsert(
+            nullptr, [] { return std::string("new"); }, [](std::string& s) { s += "!"; });
+        REQUIRE(inserted);
+        REQUIRE(it->second == "new");
+
+        const auto [it2, inserted2] = m.upsert(
+            nullptr, [] { return std::string("other"); }, [](std::string& s) { s += "!"; });
+        REQUIRE_FALSE(inserted2);
+        REQUIRE(it2 == it);
+        REQUIRE(it2->second == "new!");
+    }
+
+    SECTION("try_emplace_or_visit")
+    {
+        jg::dense_hash_map<std::string, std::vector<int>> m;
+        const auto append = [](int value) {
+            return [value](auto& entry) { entry.second.push_back(value); };
+        };
+
+        REQUIRE(m.try_emplace_or_visit("x", append(1), 2, 7).second);
+        REQUIRE(m.at("x") == std::vector<int>{7, 7});
+
+        const std::string key = "x";
+        const auto [it, inserted] = m.try_emplace_or_visit(key, append(3), 1, 0);
+        REQUIRE_FALSE(inserted);
+        REQUIRE(it->first == "x");
+        REQUIRE(it->second == std::vector<int>{7, 7, 3});
+    }
+
+    SECTION("key not copied if not inserted")
+    {
+        std::size_t counter{};
+        jg::dense_hash_map<increase_counter_on_copy_or_move, int> m;
+        m.emplace(&counter, 42);
+        const auto counter_after_insertion = counter;
+
+        increase_counter_on_copy_or_move key{&counter};
+        m.upsert(key, [] { return 0; }, [](int& value) { ++value; });
+        m.try_emplace_or_visit(std::move(key), [](auto&) {});
+
+        REQUIRE(counter == counter_after_insertion);
+        REQUIRE(m.begin()->second == 43);
+    }
+
+    SECTION("small map leaving linear mode")
+    {
+        jg::small_dense_hash_map<int, int, 4> m;
+
+        for (int round = 0; round < 3; ++round)
+        {
+            for (int i = 0; i < 100; ++i)
+            {
+                m.upsert(i, [] { return 1; }, [](int& count) { ++count; });
+            }
+        }
+
+        REQUIRE(m.size() == 100);
+        REQUIRE(std::all_of(m.begin(), m.end(), [](const auto& entry) {
+            return entry.second == 3;
+        }));
+    }
+}
+
 TEST_CASE("erase iterator", "[erase]")
 {
     jg::dense_hash_map<std::string, int> m;
@@ -1270,6 +1707,25 @@ TEST_CASE("range erase")
         REQUIRE(m.find("snoop") == m.end());
     }
 
+    SECTION("bulk")
+    {
+        jg::dense_hash_map<int, int> m2;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            m2.try_emplace(i, i);
+        }
+
+        auto it = m2.erase(std::next(m2.begin(), 100), std::next(m2.begin(), 900));
+        REQUIRE(it->first == 900);
+        REQUIRE(m2.size() == 200u);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            REQUIRE(m2.contains(i) == (i < 100 || i >= 900));
+        }
+    }
+
     SECTION("none")
     {
         auto it = m.erase(m.begin(), m.begin());
@@ -1281,103 +1737,361 @@ TEST_CASE("range erase")
     }
 }
 
-TEST_CASE("rehash")
+TEST_CASE("extract and insert node")
 {
-    jg::dense_hash_map<std::string, int> m;
+    jg::dense_hash_map<std::string, std::string> m1 = {{"tintin", "reporter"}, {"milou", "dog"}};
+    jg::dense_hash_map<std::string, std::string> m2;
 
-    SECTION("by insertion")
+    SECTION("by key")
     {
-        const int amount = 1000;
-        const auto old_bucket_count = m.bucket_count();
-
-        for (int i = 0; i < amount; ++i)
-        {
-            m.emplace("test" + std::to_string(i), i);
-        }
-
-        REQUIRE(m.size() == amount);
-        REQUIRE(m.bucket_count() != old_bucket_count);
-        REQUIRE(m.bucket_count() >= std::ceil(1000 / m.max_load_factor()));
+        auto nh = m1.extract("milou");
+        REQUIRE(nh);
+        REQUIRE(nh.key() == "milou");
+        REQUIRE(nh.mapped() == "dog");
+        REQUIRE(m1.size() == 1u);
+        REQUIRE_FALSE(m1.contains("milou"));
+        REQUIRE(m1.at("tintin") == "reporter");
 
-        for (int i = 0; i < amount; ++i)
-        {
-            const std::string key = "test" + std::to_string(i);
-            auto it = m.find(key);
-            REQUIRE(it != m.end());
-            REQUIRE(it->first == key);
-            REQUIRE(it->second == i);
-        }
+        const auto result = m2.insert(std::move(nh));
+        REQUIRE(result.inserted);
+        REQUIRE(result.position->first == "milou");
+        REQUIRE(result.node.empty());
+        REQUIRE(nh.empty());
+        REQUIRE(m2.at("milou") == "dog");
     }
 
-    SECTION("rehash member function")
+    SECTION("by iterator")
     {
-        m.try_emplace("tarzan", 42);
-        m.try_emplace("spirou", 1337);
+        auto nh = m1.extract(m1.begin());
+        REQUIRE(nh.key() == "tintin");
+        REQUIRE(m1.size() == 1u);
+        REQUIRE(m1.at("milou") == "dog");
+    }
 
-        const auto old_load_factor = m.load_factor();
+    SECTION("missing key")
+    {
+        auto nh = m1.extract("haddock");
+        REQUIRE(nh.empty());
+        REQUIRE(m1.size() == 2u);
 
-        m.rehash(1000);
+        const auto result = m2.insert(std::move(nh));
+        REQUIRE_FALSE(result.inserted);
+        REQUIRE(result.position == m2.end());
+    }
 
-        REQUIRE(m.load_factor() < old_load_factor);
-        REQUIRE(m.bucket_count() == 1024);
+    SECTION("existing key")
+    {
+        m2.try_emplace("milou", "snowy");
 
-        auto it = m.find("tarzan");
-        REQUIRE(it != m.end());
-        REQUIRE(it->first == "tarzan");
-        REQUIRE(it->second == 42);
+        const auto result = m2.insert(m1.extract("milou"));
+        REQUIRE_FALSE(result.inserted);
+        REQUIRE(result.position->second == "snowy");
+        REQUIRE(result.node.key() == "milou");
+        REQUIRE(result.node.mapped() == "dog");
+    }
 
-        it = m.find("spirou");
-        REQUIRE(it != m.end());
-        REQUIRE(it->first == "spirou");
-        REQUIRE(it->second == 1337);
+#ifndef JG_STRICT_TYPE_PUNNING
+    SECTION("change the key")
+    {
+        auto nh = m1.extract("milou");
+        nh.key() = "snowy";
+        m1.insert(std::move(nh));
+        REQUIRE(m1.at("snowy") == "dog");
+        REQUIRE_FALSE(m1.contains("milou"));
     }
+#endif
 
-    SECTION("reserve")
+    SECTION("many")
     {
-        m.try_emplace("tarzan", 42);
-        m.try_emplace("spirou", 1337);
+        jg::dense_hash_map<int, int> m3;
 
-        const auto old_load_factor = m.load_factor();
+        for (int i = 0; i < 1000; ++i)
+        {
+            m3.try_emplace(i, i);
+        }
 
-        m.reserve(1000);
+        jg::dense_hash_map<int, int> m4;
 
-        REQUIRE(m.load_factor() < old_load_factor);
-        REQUIRE(m.bucket_count() >= std::ceil(1000 / m.max_load_factor()));
+        for (int i = 0; i < 1000; i += 2)
+        {
+            m4.insert(m3.extract(i));
+        }
 
-        auto it = m.find("tarzan");
-        REQUIRE(it != m.end());
-        REQUIRE(it->first == "tarzan");
-        REQUIRE(it->second == 42);
+        REQUIRE(m3.size() == 500u);
+        REQUIRE(m4.size() == 500u);
 
-        it = m.find("spirou");
-        REQUIRE(it != m.end());
-        REQUIRE(it->first == "spirou");
-        REQUIRE(it->second == 1337);
+        for (int i = 0; i < 1000; ++i)
+        {
+            REQUIRE(m3.contains(i) == (i % 2 == 1));
+            REQUIRE(m4.contains(i) == (i % 2 == 0));
+        }
     }
 
-    SECTION("max_load_factor")
+    SECTION("out of line pairs do not move")
     {
-        m.try_emplace("tarzan", 42);
-        m.try_emplace("spirou", 1337);
+        jg::dense_hash_map<
+            int, std::string, std::hash<int>, std::equal_to<int>,
+            std::allocator<std::pair<const int, std::string>>,
+            jg::details::power_of_two_growth_policy, jg::details::out_of_line_storage_policy<>>
+            m3, m4;
 
-        REQUIRE(m.bucket_count() == 8);
-        REQUIRE(m.load_factor() == 0.25); // We have 2/8 == 0.25 load factor.
+        m3.try_emplace(1, "one");
+        auto* value = &m3.at(1);
 
-        m.max_load_factor(0.2f); // So this should trigger a regrowth.
+        m4.insert(m3.extract(1));
+        REQUIRE(&m4.at(1) == value);
+    }
+}
 
-        REQUIRE(m.max_load_factor() == 0.2f);
-        REQUIRE(m.bucket_count() == 16); // Doubling the size will work.
+TEST_CASE("merge")
+{
+    SECTION("duplicates stay in the source")
+    {
+        jg::dense_hash_map<int, std::string> m1 = {{1, "a"}, {2, "b"}};
+        jg::dense_hash_map<int, std::string> m2 = {{2, "x"}, {3, "c"}, {4, "d"}};
 
-        auto it = m.find("tarzan");
-        REQUIRE(it != m.end());
-        REQUIRE(it->first == "tarzan");
-        REQUIRE(it->second == 42);
+        m1.merge(m2);
+
+        REQUIRE(m1.size() == 4u);
+        REQUIRE(m1.at(2) == "b");
+        REQUIRE(m1.at(3) == "c");
+        REQUIRE(m2.size() == 1u);
+        REQUIRE(m2.at(2) == "x");
+
+        m1.merge(m1);
+        REQUIRE(m1.size() == 4u);
+    }
+
+    SECTION("large")
+    {
+        jg::dense_hash_map<int, int> m1;
+        jg::dense_hash_map<int, int> m2;
+
+        for (int i = 0; i < 10000; ++i)
+        {
+            m1.try_emplace(i, i);
+            m2.try_emplace(i + 5000, -i);
+        }
+
+        m1.merge(std::move(m2));
+        REQUIRE(m1.size() == 15000u);
+        REQUIRE(m2.size() == 5000u);
+
+        for (int i = 0; i < 15000; ++i)
+        {
+            REQUIRE(m1.at(i) == (i < 10000 ? i : -(i - 5000)));
+        }
+
+        for (int i = 5000; i < 10000; ++i)
+        {
+            REQUIRE(m2.at(i) == -(i - 5000));
+        }
+    }
+
+    SECTION("cached hashes are reused")
+    {
+        using map_type = jg::dense_hash_map<
+            int, int, stateless_counting_hash, std::equal_to<int>,
+            std::allocator<std::pair<const int, int>>, jg::details::power_of_two_growth_policy,
+            jg::details::out_of_line_storage_policy<>>;
+
+        map_type m1;
+        map_type m2;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            m1.try_emplace(i, i);
+            m2.try_emplace(i + 1000, i);
+        }
+
+        stateless_counting_hash::calls = 0;
+        m1.merge(m2);
+
+        REQUIRE(stateless_counting_hash::calls == 0u);
+        REQUIRE(m1.size() == 2000u);
+        REQUIRE(m2.empty());
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            REQUIRE(m1.contains(i));
+        }
+    }
+
+    SECTION("allocates through the allocator of the map")
+    {
+        int counter = 0;
+        auto r = counting_pmr_resource(&counter);
+
+        jg::pmr::dense_hash_map<int, int> m1(&r);
+        jg::pmr::dense_hash_map<int, int> m2(&r);
+        m1.reserve(200);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            m1.try_emplace(i, i);
+            m2.try_emplace(i + 100, i);
+        }
+
+        // The nodes and buckets of m1 are already reserved: only the bookkeeping of merge remains.
+        const auto before_merge = counter;
+        m1.merge(m2);
+
+        REQUIRE(counter == before_merge + 1);
+        REQUIRE(m1.size() == 200u);
+        REQUIRE(m2.empty());
+    }
+
+SECTION("small maps")
+    {
+        jg::small_dense_hash_map<int, int, 4> m1 = {{1, 1}, {2, 2}};
+        jg::small_dense_hash_map<int, int, 4> m2 = {{2, 0}, {3, 3}};
+        jg::small_dense_hash_map<int, int, 4> m3 = {{4, 4}, {5, 5}, {6, 6}};
+
+        m1.merge(m2);
+        REQUIRE(m1.size() == 3u);
+        REQUIRE(m1.bucket_count() == 0u);
+        REQUIRE(m2.size() == 1u);
+
+        m1.merge(m3);
+        REQUIRE(m1.size() == 6u);
+        REQUIRE(m1.bucket_count() > 0u);
+
+        for (int i = 1; i <= 6; ++i)
+        {
+            REQUIRE(m1.at(i) == i);
+        }
+    }
+}
+
+TEST_CASE("rehash")
+{
+    jg::dense_hash_map<std::string, int> m;
+
+    SECTION("by insertion")
+    {
+        const int amount = 1000;
+        const auto old_bucket_count = m.bucket_count();
+
+        for (int i = 0; i < amount; ++i)
+        {
+            m.emplace("test" + std::to_string(i), i);
+        }
+
+        REQUIRE(m.size() == amount);
+        REQUIRE(m.bucket_count() != old_bucket_count);
+        REQUIRE(m.bucket_count() >= std::ceil(1000 / m.max_load_factor()));
+
+        for (int i = 0; i < amount; ++i)
+        {
+            const std::string key = "test" + std::to_string(i);
+            auto it = m.find(key);
+            REQUIRE(it != m.end());
+            REQUIRE(it->first == key);
+            REQUIRE(it->second == i);
+        }
+    }
+
+    SECTION("rehash member function")
+    {
+        m.try_emplace("tarzan", 42);
+        m.try_emplace("spirou", 1337);
+
+        const auto old_load_factor = m.load_factor();
+
+        m.rehash(1000);
+
+        REQUIRE(m.load_factor() < old_load_factor);
+        REQUIRE(m.bucket_count() == 1024);
+
+        auto it = m.find("tarzan");
+        REQUIRE(it != m.end());
+        REQUIRE(it->first == "tarzan");
+        REQUIRE(it->second == 42);
+
+        it = m.find("spirou");
+        REQUIRE(it != m.end());
+        REQUIRE(it->first == "spirou");
+        REQUIRE(it->second == 1337);
+    }
+
+    SECTION("reserve")
+    {
+        m.try_emplace("tarzan", 42);
+        m.try_emplace("spirou", 1337);
+
+        const auto old_load_factor = m.load_factor();
+
+        m.reserve(1000);
+
+        REQUIRE(m.load_factor() < old_load_factor);
+        REQUIRE(m.bucket_count() >= std::ceil(1000 / m.max_load_factor()));
+
+        auto it = m.find("tarzan");
+        REQUIRE(it != m.end());
+        REQUIRE(it->first == "tarzan");
+        REQUIRE(it->second == 42);
+
+        it = m.find("spirou");
+        REQUIRE(it != m.end());
+        REQUIRE(it->first == "spirou");
+        REQUIRE(it->second == 1337);
+    }
+
+    SECTION("max_load_factor")
+    {
+        m.try_emplace("tarzan", 42);
+        m.try_emplace("spirou", 1337);
+
+        REQUIRE(m.bucket_count() == 8);
+        REQUIRE(m.load_factor() == 0.25); // We have 2/8 == 0.25 load factor.
+
+        m.max_load_factor(0.2f); // So this should trigger a regrowth.
+
+        REQUIRE(m.max_load_factor() == 0.2f);
+        REQUIRE(m.bucket_count() == 16); // Doubling the size will work.
+
+        auto it = m.find("tarzan");
+        REQUIRE(it != m.end());
+        REQUIRE(it->first == "tarzan");
+        REQUIRE(it->second == 42);
 
         it = m.find("spirou");
         REQUIRE(it != m.end());
         REQUIRE(it->first == "spirou");
         REQUIRE(it->second == 1337);
     }
+
+    SECTION("no growth when the key is present")
+    {
+        m.reserve(1000);
+        const auto full_bucket_count = m.bucket_count();
+
+        for (int i = 0; m.size() + 1 <= m.bucket_count() * m.max_load_factor(); ++i)
+        {
+            m.try_emplace(std::to_string(i), i);
+        }
+
+        REQUIRE(m.bucket_count() == full_bucket_count);
+
+        REQUIRE_FALSE(m.emplace("0", 1).second);
+        REQUIRE_FALSE(m.try_emplace("1", 1).second);
+        REQUIRE_FALSE(m.insert_or_assign("2", 1).second);
+        REQUIRE_FALSE(m.upsert("3", [] { return 0; }, [](int& value) { ++value; }).second);
+        m["4"] = 5;
+
+        auto nh = m.extract("5");
+        nh.key() = "6";
+        REQUIRE_FALSE(m.insert(std::move(nh)).inserted);
+
+        REQUIRE(m.bucket_count() == full_bucket_count);
+        REQUIRE(m.at("2") == 1);
+        REQUIRE(m.at("3") == 4);
+        REQUIRE(m.at("4") == 5);
+
+        m.try_emplace("5", 5);
+        m.try_emplace("new", 0);
+        REQUIRE(m.bucket_count() > full_bucket_count);
+    }
 }
 
 TEST_CASE("swap", "[swap]")
@@ -1732,6 +2446,91 @@ TEST_CASE("equal_range transparent hash", "[equal_range]")
     }
 }
 
+TEST_CASE("heterogeneous insertion and erase")
+{
+    using namespace std::string_view_literals;
+    jg::dense_hash_map<counted_string, int, string_view_hash, std::equal_to<>> m;
+    counted_string::counts = {};
+
+    SECTION("try_emplace")
+    {
+        const auto [it, inserted] = m.try_emplace("alpha"sv, 1);
+        REQUIRE(inserted);
+        REQUIRE(it->first.value == "alpha");
+        REQUIRE(counted_string::counts.constructions == 1);
+
+        const auto [it2, inserted2] = m.try_emplace("alpha"sv, 2);
+        REQUIRE_FALSE(inserted2);
+        REQUIRE(it2 == it);
+        REQUIRE(it2->second == 1);
+
+        REQUIRE(m.try_emplace(m.end(), "alpha"sv, 3) == it);
+        REQUIRE(counted_string::counts.constructions == 1);
+    }
+
+    SECTION("subscript operator")
+    {
+        m["alpha"sv] = 1;
+        ++m["alpha"sv];
+        REQUIRE(counted_string::counts.constructions == 1);
+
+        REQUIRE(m["beta"sv] == 0);
+        REQUIRE(counted_string::counts.constructions == 2);
+        REQUIRE(m.size() == 2);
+    }
+
+    SECTION("insert_or_assign and upsert")
+    {
+        REQUIRE(m.insert_or_assign("alpha"sv, 1).second);
+        REQUIRE_FALSE(m.insert_or_assign("alpha"sv, 2).second);
+        REQUIRE_FALSE(m.upsert("alpha"sv, [] { return 0; }, [](int& v) { v *= 10; }).second);
+        REQUIRE_FALSE(
+            m.try_emplace_or_visit("alpha"sv, [](auto& entry) { ++entry.second; }).second);
+        REQUIRE(counted_string::counts.constructions == 1);
+        REQUIRE(m.at("alpha"sv) == 21);
+    }
+
+    SECTION("at")
+    {
+        m.try_emplace("alpha"sv, 1);
+        const auto& cm = m;
+
+        REQUIRE(m.at("alpha"sv) == 1);
+        REQUIRE(cm.at("alpha"sv) == 1);
+        static_assert(std::is_same_v<decltype(m.at("alpha"sv)), int&>);
+        static_assert(std::is_same_v<decltype(cm.at("alpha"sv)), const int&>);
+#ifndef JG_NO_EXCEPTION
+        REQUIRE_THROWS_AS(m.at("beta"sv), std::out_of_range);
+        REQUIRE_THROWS_AS(cm.at("beta"sv), std::out_of_range);
+#endif
+        REQUIRE(counted_string::counts.constructions == 1);
+    }
+
+    SECTION("erase")
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            m.try_emplace(std::to_string(i), i);
+        }
+
+        REQUIRE(m.erase("42"sv) == 1);
+        REQUIRE(m.erase("42"sv) == 0);
+        REQUIRE(m.erase(m.begin()) != m.end());
+        REQUIRE(m.size() == 98);
+        REQUIRE(counted_string::counts.constructions == 100);
+    }
+
+    SECTION("nested transparent_key_equal")
+    {
+        jg::dense_hash_map<std::string, int, string_hash> m2 = {{"queen", 1}, {"king", 2}};
+
+        REQUIRE(m2.at(nested_string{"queen"}) == 1);
+        REQUIRE(m2.erase(nested_string{"queen"}) == 1);
+        REQUIRE(m2.erase(nested_string{"queen"}) == 0);
+        REQUIRE(m2.size() == 1);
+    }
+}
+
 TEST_CASE("bucket iterator")
 {
     jg::dense_hash_map<std::string, int, collision_hasher> m = {
@@ -1788,6 +2587,82 @@ TEST_CASE("load_factor")
     REQUIRE(cm.load_factor() < cm.max_load_factor());
 }
 
+TEST_CASE("min_load_factor")
+{
+    jg::dense_hash_map<int, int> m;
+    REQUIRE(m.min_load_factor() == 0.0f);
+
+    for (int i = 0; i < 10000; ++i)
+    {
+        m.try_emplace(i, i);
+    }
+
+    const auto full_bucket_count = m.bucket_count();
+
+    SECTION("disabled by default")
+    {
+        m.erase(m.begin() + 10, m.end());
+        REQUIRE(m.bucket_count() == full_bucket_count);
+    }
+
+    SECTION("shrinks after mass erases")
+    {
+        m.min_load_factor(0.1f);
+
+        for (int i = 100; i < 10000; ++i)
+        {
+            m.erase(i);
+        }
+
+        REQUIRE(m.size() == 100u);
+        REQUIRE(m.bucket_count() < full_bucket_count);
+        REQUIRE(m.load_factor() >= m.min_load_factor());
+        REQUIRE(m.load_factor() <= m.max_load_factor() / 2);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            REQUIRE(m.at(i) == i);
+        }
+    }
+
+    SECTION("range erase shrinks once")
+    {
+        m.min_load_factor(0.1f);
+        const auto it = m.erase(m.begin() + 10, m.end());
+        REQUIRE(it == m.end());
+        REQUIRE(m.size() == 10u);
+        REQUIRE(m.bucket_count() == 32u);
+    }
+
+    SECTION("erase_if")
+    {
+        m.min_load_factor(0.1f);
+        std::erase_if(m, [](const auto& p) { return p.first % 100 != 0; });
+        REQUIRE(m.size() == 100u);
+        REQUIRE(m.bucket_count() < full_bucket_count);
+
+        for (int i = 0; i < 10000; i += 100)
+        {
+            REQUIRE(m.at(i) == i);
+        }
+    }
+
+    SECTION("no thrashing at the boundary")
+    {
+        m.min_load_factor(0.1f);
+        m.erase(m.begin() + 1000, m.end());
+
+        const auto bucket_count = m.bucket_count();
+
+        for (int round = 0; round < 100; ++round)
+        {
+            m.erase(static_cast<int>(round));
+            m.try_emplace(static_cast<int>(round), round);
+            REQUIRE(m.bucket_count() == bucket_count);
+        }
+    }
+}
+
 TEST_CASE("observers")
 {
     const jg::dense_hash_map<std::string, int> m = {};
@@ -1863,43 +2738,272 @@ TEST_CASE("erase_if")
 
         REQUIRE(std::equal(m1.begin(), m1.end(), expected.begin(), expected.end()));
     }
-}
 
-TEST_CASE("deduction guides")
-{
-    jg::dense_hash_map<std::string, int> m;
+    SECTION("keeps the order and returns the count")
+    {
+        jg::dense_hash_map<int, int> m;
 
-    jg::dense_hash_map m1(m.begin(), m.end());
-    REQUIRE(std::is_same_v<decltype(m1), jg::dense_hash_map<std::string, int>>);
+        for (int i = 0; i < 1000; ++i)
+        {
+            m.try_emplace(i, i);
+        }
 
-    jg::dense_hash_map m2({std::pair{"foo", 2}, {"bar", 3}});
-    REQUIRE(std::is_same_v<decltype(m2), jg::dense_hash_map<const char*, int>>);
+        REQUIRE(std::erase_if(m, [](const auto& pair) { return pair.first % 3 == 0; }) == 334u);
+        REQUIRE(m.size() == 666u);
 
-    jg::dense_hash_map m3(m.begin(), m.end(), 42u, named_allocator<const char*>{"test"});
-    REQUIRE(std::is_same_v<
-            decltype(m3), jg::dense_hash_map<
-                              std::string, int, std::hash<std::string>, std::equal_to<std::string>,
-                              named_allocator<const char*>>>);
+        int previous = -1;
 
-    // Rule 4 works thanks to https://cplusplus.github.io/LWG/issue2713
-    jg::dense_hash_map m4(m.begin(), m.end(), named_allocator<const char*>{"test"});
-    REQUIRE(std::is_same_v<
-            decltype(m4), jg::dense_hash_map<
-                              std::string, int, std::hash<std::string>, std::equal_to<std::string>,
-                              named_allocator<const char*>>>);
+        for (const auto& [key, value] : m)
+        {
+            REQUIRE(key % 3 != 0);
+            REQUIRE(key > previous);
+            REQUIRE(m.at(key) == value);
+            previous = key;
+        }
 
-    jg::dense_hash_map m5(
-        m.begin(), m.end(), 42u, collision_hasher{}, named_allocator<const char*>{"test"});
-    REQUIRE(std::is_same_v<
-            decltype(m5), jg::dense_hash_map<
-                              std::string, int, collision_hasher, std::equal_to<std::string>,
-                              named_allocator<const char*>>>);
+        REQUIRE(m.erase_if([](const auto&) { return false; }) == 0u);
+    }
 
-    jg::dense_hash_map m6(
-        {std::pair{"foo", 2}, {"bar", 3}}, 42u, named_allocator<std::string>{"test"});
-    REQUIRE(std::is_same_v<
-            decltype(m6), jg::dense_hash_map<
-                              const char*, int, std::hash<const char*>, std::equal_to<const char*>,
+    SECTION("with every storage")
+    {
+        auto check = [](auto m) {
+            for (int i = 0; i < 100; ++i)
+            {
+                m.try_emplace(i, std::to_string(i));
+            }
+
+            REQUIRE(m.erase_if([](const auto& pair) { return pair.first % 2 == 0; }) == 50u);
+            REQUIRE(m.size() == 50u);
+
+            for (int i = 0; i < 100; ++i)
+            {
+                REQUIRE(m.contains(i) == (i % 2 == 1));
+            }
+
+            m.erase(1);
+            REQUIRE(m.size() == 49u);
+        };
+
+        auto check_storage = [&](auto storage_policy) {
+            check(jg::dense_hash_map<
+                  int, std::string, std::hash<int>, std::equal_to<int>,
+                  std::allocator<std::pair<const int, std::string>>,
+                  jg::details::power_of_two_growth_policy, decltype(storage_policy)>{});
+        };
+
+        check_storage(jg::details::vector_storage_policy{});
+        check_storage(jg::details::segmented_storage_policy<4>{});
+        check_storage(jg::details::out_of_line_storage_policy<>{});
+        check_storage(jg::details::doubly_linked_storage_policy<>{});
+        check_storage(jg::details::ordered_storage_policy<>{});
+        check_storage(jg::details::handle_storage_policy<>{});
+        check_storage(jg::details::single_block_storage_policy{});
+        check(jg::small_dense_hash_map<int, std::string, 128>{});
+    }
+
+    SECTION("throwing predicate")
+    {
+        jg::dense_hash_map<int, int> m;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            m.try_emplace(i, i);
+        }
+
+        REQUIRE_THROWS(m.erase_if([](const auto& pair) {
+            if (pair.first == 50)
+            {
+                throw std::runtime_error("boom");
+            }
+
+            return pair.first % 2 == 0;
+        }));
+
+        REQUIRE(m.size() == 75u);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            REQUIRE(m.contains(i) == (i >= 50 || i % 2 == 1));
+        }
+    }
+
+    SECTION("parallel")
+    {
+        // Runs the tasks backward, as any order must be supported.
+        auto executor = [](std::size_t count, auto task) {
+            for (auto i = count; i > 0; --i)
+            {
+                task(i - 1);
+            }
+        };
+
+        jg::dense_hash_map<int, int> m;
+        jg::dense_hash_map<int, int> expected;
+
+        for (int i = 0; i < 100000; ++i)
+        {
+            m.try_emplace(i, i);
+
+            if (i % 7 != 0)
+            {
+                expected.try_emplace(i, i);
+            }
+        }
+
+        REQUIRE(m.erase_if(executor, [](const auto& pair) { return pair.first % 7 == 0; }) ==
+                14286u);
+        REQUIRE(m == expected);
+        REQUIRE(std::equal(m.begin(), m.end(), expected.begin(), expected.end()));
+    }
+}
+
+TEST_CASE("set algebra")
+{
+    // Runs the tasks backward, as any order must be supported.
+    auto executor = [](std::size_t count, auto task) {
+        for (auto i = count; i > 0; --i)
+        {
+            task(i - 1);
+        }
+    };
+
+    // Keys multiple of 2 in lhs, multiple of 3 in rhs.
+    jg::dense_hash_map<int, int> lhs;
+    jg::dense_hash_map<int, int> rhs;
+
+    for (int i = 0; i < 60000; ++i)
+    {
+        lhs.try_emplace(2 * i, i);
+
+        if (i < 30000)
+        {
+            rhs.try_emplace(3 * i, -i);
+        }
+    }
+
+    SECTION("intersect_keys")
+    {
+        std::vector<int> keys;
+        jg::intersect_keys(lhs, rhs, std::back_inserter(keys));
+
+        REQUIRE(keys.size() == 15000u);
+        REQUIRE(std::all_of(keys.begin(), keys.end(), [](int key) { return key % 6 == 0; }));
+        // The smaller map, rhs, is walked.
+        REQUIRE(std::is_sorted(keys.begin(), keys.end()));
+
+        std::vector<int> parallel_keys(keys.size());
+        const auto end = jg::intersect_keys(executor, rhs, lhs, parallel_keys.begin());
+        REQUIRE(end == parallel_keys.end());
+        REQUIRE(parallel_keys == keys);
+    }
+
+    SECTION("difference")
+    {
+        std::vector<int> keys;
+        jg::difference(lhs, rhs, std::back_inserter(keys));
+
+        REQUIRE(keys.size() == 45000u);
+        REQUIRE(std::all_of(
+            keys.begin(), keys.end(), [](int key) { return key % 3 != 0 || key >= 90000; }));
+
+        std::vector<int> parallel_keys;
+        jg::difference(executor, lhs, rhs, std::back_inserter(parallel_keys));
+        REQUIRE(parallel_keys == keys);
+
+        keys.clear();
+        jg::difference(rhs, lhs, std::back_inserter(keys));
+        REQUIRE(keys.size() == 15000u);
+    }
+
+    SECTION("union_into")
+    {
+        REQUIRE(jg::union_into(lhs, rhs) == 15000u);
+        REQUIRE(lhs.size() == 75000u);
+        REQUIRE(lhs.at(6) == 3);
+        REQUIRE(lhs.at(3) == -1);
+        REQUIRE(jg::union_into(lhs, rhs) == 0u);
+    }
+
+    SECTION("probe")
+    {
+        std::vector<int> probe_keys = {1, 2, 3, 4, 120000, 6};
+        std::vector<jg::probe_result<jg::dense_hash_map<int, int>>> results(probe_keys.size());
+
+        const auto end = jg::probe(lhs, probe_keys, results.begin());
+        results.erase(end, results.end());
+
+        REQUIRE(results.size() == 3u);
+        REQUIRE(results[0].first == 1u);
+        REQUIRE(*results[0].second == std::pair<const int, int>{2, 1});
+        REQUIRE(results[1].first == 3u);
+        REQUIRE(results[2].first == 5u);
+        REQUIRE(results[2].second == &*lhs.find(6));
+
+        std::vector<int> many_keys(100000);
+        std::iota(many_keys.begin(), many_keys.end(), 0);
+
+        std::vector<jg::probe_result<jg::dense_hash_map<int, int>>> sequential;
+        std::vector<jg::probe_result<jg::dense_hash_map<int, int>>> parallel;
+        jg::probe(lhs, many_keys, std::back_inserter(sequential));
+        jg::probe(executor, lhs, many_keys, std::back_inserter(parallel));
+
+        REQUIRE(sequential.size() == 50000u);
+        REQUIRE(parallel == sequential);
+    }
+
+    SECTION("small maps")
+    {
+        jg::small_dense_hash_map<int, int> small = {{0, 0}, {1, 1}, {2, 2}};
+        std::vector<int> keys;
+
+        jg::intersect_keys(small, rhs, std::back_inserter(keys));
+        REQUIRE(keys == std::vector<int>{0});
+
+        keys.clear();
+        jg::difference(small, rhs, std::back_inserter(keys));
+        REQUIRE(keys == std::vector<int>{1, 2});
+
+        keys.clear();
+        jg::intersect_keys(rhs, small, std::back_inserter(keys));
+        REQUIRE(keys == std::vector<int>{0});
+    }
+}
+
+TEST_CASE("deduction guides")
+{
+    jg::dense_hash_map<std::string, int> m;
+
+    jg::dense_hash_map m1(m.begin(), m.end());
+    REQUIRE(std::is_same_v<decltype(m1), jg::dense_hash_map<std::string, int>>);
+
+    jg::dense_hash_map m2({std::pair{"foo", 2}, {"bar", 3}});
+    REQUIRE(std::is_same_v<decltype(m2), jg::dense_hash_map<const char*, int>>);
+
+    jg::dense_hash_map m3(m.begin(), m.end(), 42u, named_allocator<const char*>{"test"});
+    REQUIRE(std::is_same_v<
+            decltype(m3), jg::dense_hash_map<
+                              std::string, int, std::hash<std::string>, std::equal_to<std::string>,
+                              named_allocator<const char*>>>);
+
+    // Rule 4 works thanks to https://cplusplus.github.io/LWG/issue2713
+    jg::dense_hash_map m4(m.begin(), m.end(), named_allocator<const char*>{"test"});
+    REQUIRE(std::is_same_v<
+            decltype(m4), jg::dense_hash_map<
+                              std::string, int, std::hash<std::string>, std::equal_to<std::string>,
+                              named_allocator<const char*>>>);
+
+    jg::dense_hash_map m5(
+        m.begin(), m.end(), 42u, collision_hasher{}, named_allocator<const char*>{"test"});
+    REQUIRE(std::is_same_v<
+            decltype(m5), jg::dense_hash_map<
+                              std::string, int, collision_hasher, std::equal_to<std::string>,
+                              named_allocator<const char*>>>);
+
+    jg::dense_hash_map m6(
+        {std::pair{"foo", 2}, {"bar", 3}}, 42u, named_allocator<std::string>{"test"});
+    REQUIRE(std::is_same_v<
+            decltype(m6), jg::dense_hash_map<
+                              const char*, int, std::hash<const char*>, std::equal_to<const char*>,
                               named_allocator<std::string>>>);
 
     // Rule 7 also works thanks to https://cplusplus.github.io/LWG/issue2713
@@ -2064,3 +3168,2312 @@ TEST_CASE("growth policy")
     m.rehash(500);
     REQUIRE(m.bucket_count() == 500);
 }
+
+TEST_CASE("growth policy presets")
+{
+    SECTION("lean growth")
+    {
+        jg::dense_hash_map<
+            int, std::string, std::hash<int>, std::equal_to<int>,
+            std::allocator<std::pair<const int, std::string>>, jg::details::lean_growth_policy>
+            m{};
+
+        REQUIRE(m.max_load_factor() == 1.0f);
+        REQUIRE(m.bucket_count() == 8);
+
+        for (int i = 0; i < 9; ++i)
+        {
+            m.try_emplace(i, std::to_string(i));
+        }
+
+        REQUIRE(m.bucket_count() == 12);
+
+        // Inserting a copy of a value already in the map while nodes_ reallocates.
+        for (int i = 9; i < 1000; ++i)
+        {
+            m.try_emplace(i, m.at(i - 1));
+        }
+
+        REQUIRE(m.size() == 1000);
+        REQUIRE(m.at(999) == "8");
+        REQUIRE(m.load_factor() <= 1.0f);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            REQUIRE(m.contains(i));
+        }
+    }
+
+    SECTION("nodes grow by smaller steps")
+    {
+        int default_counter = 0;
+        int lean_counter = 0;
+        auto default_resource = counting_pmr_resource(&default_counter);
+        auto lean_resource = counting_pmr_resource(&lean_counter);
+
+        jg::pmr::dense_hash_map<int, int> default_map(&default_resource);
+        jg::pmr::dense_hash_map<
+            int, int, std::hash<int>, std::equal_to<int>, jg::details::lean_growth_policy>
+            lean_map(&lean_resource);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            default_map.try_emplace(i, i);
+            lean_map.try_emplace(i, i);
+        }
+
+        REQUIRE(lean_map.size() == default_map.size());
+        REQUIRE(std::all_of(default_map.begin(), default_map.end(), [&](const auto& p) {
+            return lean_map.at(p.first) == p.second;
+        }));
+        REQUIRE(lean_counter > default_counter);
+    }
+
+    SECTION("speed growth")
+    {
+        jg::dense_hash_map<
+            int, int, std::hash<int>, std::equal_to<int>, std::allocator<std::pair<const int, int>>,
+            jg::details::speed_growth_policy>
+            m{};
+
+        REQUIRE(m.max_load_factor() == 0.5f);
+
+        for (int i = 0; i < 5; ++i)
+        {
+            m.try_emplace(i, i);
+        }
+
+        REQUIRE(m.bucket_count() == 16);
+    }
+}
+
+TEST_CASE("segmented storage")
+{
+    using map_type = jg::dense_hash_map<
+        int, std::string, std::hash<int>, std::equal_to<int>,
+        std::allocator<std::pair<const int, std::string>>, jg::details::power_of_two_growth_policy,
+        jg::details::segmented_storage_policy<4>>;
+
+    map_type m;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        m.try_emplace(i, std::to_string(i));
+    }
+
+    REQUIRE(m.size() == 1000u);
+
+    SECTION("find")
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            REQUIRE(m.at(i) == std::to_string(i));
+        }
+
+        REQUIRE_FALSE(m.contains(1000));
+    }
+
+    SECTION("random access iteration")
+    {
+        REQUIRE(std::distance(m.begin(), m.end()) == 1000);
+        REQUIRE((m.begin() + 500)->first == 500);
+        REQUIRE((m.end() - 1)->first == 999);
+        REQUIRE(m.cbegin() < m.cend());
+    }
+
+    SECTION("growth does not move nodes")
+    {
+        auto* first_value = &m.begin()->second;
+        auto* last_value = &std::prev(m.end())->second;
+
+        for (int i = 1000; i < 5000; ++i)
+        {
+            m.try_emplace(i, std::to_string(i));
+        }
+
+        REQUIRE(first_value == &m.find(0)->second);
+        REQUIRE(last_value == &m.find(999)->second);
+    }
+
+    SECTION("throwing copy while growing the first chunk")
+    {
+        // Without a move constructor, growing the first chunk copies the values.
+        struct throwing_copy
+        {
+            throwing_copy(int value, int* copies_left) : value(value), copies_left(copies_left) {}
+
+            throwing_copy(const throwing_copy& other)
+                : value(other.value), copies_left(other.copies_left)
+            {
+                if ((*copies_left)-- == 0)
+                {
+                    throw std::runtime_error("boom");
+                }
+            }
+
+            ~throwing_copy() { value = -1; }
+
+            int value;
+            int* copies_left;
+        };
+
+        jg::dense_hash_map<
+            int, throwing_copy, std::hash<int>, std::equal_to<int>,
+            std::allocator<std::pair<const int, throwing_copy>>,
+            jg::details::power_of_two_growth_policy, jg::details::segmented_storage_policy<4>>
+            tm;
+
+        int copies_left = std::numeric_limits<int>::max();
+
+        for (int i = 0; i < 8; ++i)
+        {
+            tm.try_emplace(i, i, &copies_left);
+        }
+
+        copies_left = 3;
+        REQUIRE_THROWS(tm.try_emplace(8, 8, &copies_left));
+        copies_left = std::numeric_limits<int>::max();
+
+        REQUIRE(tm.size() == 8u);
+
+        for (int i = 0; i < 8; ++i)
+        {
+            REQUIRE(tm.at(i).value == i);
+        }
+
+        tm.try_emplace(8, 8, &copies_left);
+        REQUIRE(tm.at(8).value == 8);
+    }
+
+    SECTION("erase")
+    {
+        for (int i = 0; i < 1000; i += 2)
+        {
+            REQUIRE(m.erase(i) == 1u);
+        }
+
+        REQUIRE(m.size() == 500u);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            REQUIRE(m.contains(i) == (i % 2 == 1));
+        }
+
+        m.erase(m.begin(), m.end());
+        REQUIRE(m.empty());
+    }
+
+    SECTION("copy and move")
+    {
+        auto copy = m;
+        REQUIRE(copy == m);
+
+        auto moved = std::move(copy);
+        REQUIRE(moved == m);
+        REQUIRE(copy.empty());
+
+        m.clear();
+        REQUIRE(m.empty());
+        REQUIRE(m.bucket_count() == 8u);
+        m = moved;
+        REQUIRE(moved == m);
+    }
+
+    SECTION("pmr")
+    {
+        int counter = 0;
+        auto r = counting_pmr_resource(&counter);
+
+        jg::pmr::dense_hash_map<
+            std::pmr::string, std::pmr::string, std::hash<std::pmr::string>,
+            std::equal_to<std::pmr::string>, jg::details::power_of_two_growth_policy,
+            jg::details::segmented_storage_policy<4>>
+            pm(8u, &r);
+
+        pm.try_emplace(
+            "a_super_long_string_to_disable_short_string_optimization",
+            "a_super_long_string_to_disable_short_string_optimization");
+
+        REQUIRE(pm.begin()->second.get_allocator().resource() == &r);
+    }
+}
+
+TEST_CASE("out of line storage")
+{
+    using map_type = jg::dense_hash_map<
+        std::string, std::string, std::hash<std::string>, std::equal_to<std::string>,
+        std::allocator<std::pair<const std::string, std::string>>,
+        jg::details::power_of_two_growth_policy, jg::details::out_of_line_storage_policy<>>;
+
+    map_type m;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        m.try_emplace(std::to_string(i), std::to_string(i * 2));
+    }
+
+    SECTION("lookup")
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            REQUIRE(m.at(std::to_string(i)) == std::to_string(i * 2));
+        }
+
+        REQUIRE_FALSE(m.contains("100"));
+    }
+
+    SECTION("references are stable across growth and erase")
+    {
+        auto& value = m.at("42");
+
+        for (int i = 100; i < 10000; ++i)
+        {
+            m.try_emplace(std::to_string(i), std::to_string(i * 2));
+        }
+
+        for (int i = 0; i < 42; ++i)
+        {
+            m.erase(std::to_string(i));
+        }
+
+        REQUIRE(&value == &m.at("42"));
+        REQUIRE(value == "84");
+    }
+
+    SECTION("erase")
+    {
+        m.erase(m.begin());
+        REQUIRE(m.size() == 99u);
+        REQUIRE_FALSE(m.contains("0"));
+        REQUIRE(m.erase("50") == 1u);
+        REQUIRE(m.erase("50") == 0u);
+        REQUIRE(m.size() == 98u);
+    }
+
+    SECTION("copy and move")
+    {
+        auto copy = m;
+        REQUIRE(copy == m);
+        REQUIRE(&copy.at("1") != &m.at("1"));
+
+        auto* value = &copy.at("1");
+        auto moved = std::move(copy);
+        REQUIRE(&moved.at("1") == value);
+        REQUIRE(moved == m);
+
+        moved = m;
+        REQUIRE(moved == m);
+    }
+
+    SECTION("move only")
+    {
+        jg::dense_hash_map<
+            int, std::unique_ptr<int>, std::hash<int>, std::equal_to<int>,
+            std::allocator<std::pair<const int, std::unique_ptr<int>>>,
+            jg::details::power_of_two_growth_policy, jg::details::out_of_line_storage_policy<>>
+            m2;
+
+        m2.try_emplace(1, std::make_unique<int>(1));
+        m2[2] = std::make_unique<int>(2);
+        REQUIRE(*m2.at(2) == 2);
+
+        auto m3 = std::move(m2);
+        REQUIRE(*m3.at(1) == 1);
+    }
+
+    SECTION("pmr")
+    {
+        std::pmr::unsynchronized_pool_resource pool;
+
+        jg::pmr::dense_hash_map<
+            std::pmr::string, std::pmr::string, std::hash<std::pmr::string>,
+            std::equal_to<std::pmr::string>, jg::details::power_of_two_growth_policy,
+            jg::details::out_of_line_storage_policy<>>
+            pm(8u, &pool);
+
+        pm.try_emplace(
+            "a_super_long_string_to_disable_short_string_optimization",
+            "a_super_long_string_to_disable_short_string_optimization");
+
+        REQUIRE(pm.begin()->second.get_allocator().resource() == &pool);
+    }
+
+    SECTION("stateful allocator")
+    {
+        using alloc_type = counting_allocator<std::pair<const int, std::string>>;
+
+        int counter = 0;
+        jg::dense_hash_map<
+            int, std::string, std::hash<int>, std::equal_to<int>, alloc_type,
+            jg::details::power_of_two_growth_policy, jg::details::out_of_line_storage_policy<>>
+            sm(8u, std::hash<int>(), std::equal_to<int>(), alloc_type(&counter));
+
+        sm.reserve(100);
+        const auto reserved = counter;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            sm.try_emplace(i, std::to_string(i));
+        }
+
+        // The pairs come from a few chunks, allocated through the allocator of the map.
+        REQUIRE(counter > reserved);
+        REQUIRE(counter <= reserved + 10);
+        const auto inserted = counter;
+
+        // The block of an erased pair is reused by the next insertion.
+        const auto* seven = &sm.at(7);
+        sm.erase(7);
+        sm.try_emplace(7, "seven");
+        REQUIRE(&sm.at(7) == seven);
+        REQUIRE(counter == inserted);
+
+        auto copy = sm;
+        REQUIRE(copy == sm);
+        REQUIRE(copy.get_allocator() == sm.get_allocator());
+        REQUIRE(counter > inserted);
+
+        auto nh = copy.extract(42);
+        sm.erase(42);
+        REQUIRE(sm.insert(std::move(nh)).inserted);
+        REQUIRE(sm.at(42) == "42");
+    }
+}
+
+TEST_CASE("out of line storage caches hashes")
+{
+    struct counting_hash
+    {
+        auto operator()(int i) const -> std::size_t
+        {
+            ++*calls;
+            return std::hash<int>{}(i);
+        }
+
+        std::size_t* calls;
+    };
+
+    std::size_t calls = 0;
+
+    jg::dense_hash_map<
+        int, int, counting_hash, std::equal_to<int>, std::allocator<std::pair<const int, int>>,
+        jg::details::power_of_two_growth_policy, jg::details::out_of_line_storage_policy<>>
+        m(8u, counting_hash{&calls});
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        m.try_emplace(i, i);
+    }
+
+    REQUIRE(calls == 1000u);
+
+    m.rehash(1u << 14);
+    m.erase(m.begin(), std::next(m.begin(), 10));
+    REQUIRE(calls == 1000u);
+}
+
+TEST_CASE("doubly linked storage")
+{
+    struct counting_hash
+    {
+        auto operator()(int i) const -> std::size_t
+        {
+            ++*calls;
+            // Few distinct hashes, to get long chains.
+            return static_cast<std::size_t>(i % 7);
+        }
+
+        std::size_t* calls;
+    };
+
+    std::size_t calls = 0;
+
+    jg::dense_hash_map<
+        int, int, counting_hash, std::equal_to<int>, std::allocator<std::pair<const int, int>>,
+        jg::details::power_of_two_growth_policy, jg::details::doubly_linked_storage_policy<>>
+        m(8u, counting_hash{&calls});
+
+    for (int i = 0; i < 500; ++i)
+    {
+        m.try_emplace(i, i);
+    }
+
+    SECTION("erase by iterator does not hash")
+    {
+        calls = 0;
+
+        while (m.size() > 100)
+        {
+            m.erase(std::next(m.begin(), static_cast<std::ptrdiff_t>(m.size() / 3)));
+        }
+
+        m.erase(m.begin(), std::next(m.begin(), 50));
+        REQUIRE(calls == 0u);
+        REQUIRE(m.size() == 50u);
+
+        for (const auto& [key, value] : m)
+        {
+            REQUIRE(m.at(key) == value);
+        }
+    }
+
+    SECTION("churn")
+    {
+        std::unordered_map<int, int> reference(m.begin(), m.end());
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            const int key = (i * 7919) % 1000;
+
+            if (i % 3 == 0)
+            {
+                REQUIRE(m.erase(key) == reference.erase(key));
+            }
+            else if (i % 3 == 1 && !m.empty())
+            {
+                const auto it = std::next(m.begin(), static_cast<std::ptrdiff_t>(i % m.size()));
+                reference.erase(it->first);
+                m.erase(it);
+            }
+            else
+            {
+                REQUIRE(m.try_emplace(key, i).second == reference.try_emplace(key, i).second);
+            }
+        }
+
+        REQUIRE(m.size() == reference.size());
+
+        for (const auto& [key, value] : reference)
+        {
+            REQUIRE(m.at(key) == value);
+        }
+
+        m.rehash(1024u);
+
+        for (const auto& [key, value] : reference)
+        {
+            REQUIRE(m.at(key) == value);
+        }
+    }
+
+    SECTION("copy")
+    {
+        auto copy = m;
+        copy.erase(copy.begin());
+        REQUIRE_FALSE(copy.contains(0));
+        REQUIRE(copy.size() == 499u);
+        REQUIRE(m.contains(0));
+    }
+}
+
+TEST_CASE("move to front storage")
+{
+    struct colliding_hash
+    {
+        auto operator()(int i) const -> std::size_t { return static_cast<std::size_t>(i % 4); }
+    };
+
+    using map_type = jg::dense_hash_map<
+        int, int, colliding_hash, std::equal_to<int>, std::allocator<std::pair<const int, int>>,
+        jg::details::power_of_two_growth_policy, jg::details::move_to_front_storage_policy<>>;
+
+    map_type m;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        m.try_emplace(i, i);
+    }
+
+    // New nodes are pushed at the head: the first key inserted is the last of its chain.
+    REQUIRE(m.probe_depth(0) == 25u);
+    REQUIRE(m.probe_depth(96) == 1u);
+    REQUIRE(m.probe_depth(1000) == 0u);
+
+    SECTION("find moves to front")
+    {
+        auto& value = m.at(0);
+        const auto it = m.find(0);
+
+        REQUIRE(m.probe_depth(0) == 1u);
+        REQUIRE(m.probe_depth(96) == 2u);
+        REQUIRE(&it->second == &value);
+        REQUIRE(m.find(1000) == m.end());
+
+        for (int i = 0; i < 100; ++i)
+        {
+            REQUIRE(m.at(i) == i);
+        }
+
+        REQUIRE(m.bucket_size(m.bucket(0)) == 25u);
+    }
+
+    SECTION("const find leaves chains untouched")
+    {
+        const auto& cm = m;
+        REQUIRE(cm.find(0) != cm.end());
+        REQUIRE(cm.at(0) == 0);
+        REQUIRE(m.probe_depth(0) == 25u);
+    }
+
+    SECTION("with doubly linked nodes")
+    {
+        jg::dense_hash_map<
+            int, int, colliding_hash, std::equal_to<int>, std::allocator<std::pair<const int, int>>,
+            jg::details::power_of_two_growth_policy,
+            jg::details::move_to_front_storage_policy<jg::details::doubly_linked_storage_policy<>>>
+            dm(m.begin(), m.end());
+
+        for (int i = 0; i < 100; i += 3)
+        {
+            REQUIRE(dm.find(i) != dm.end());
+            REQUIRE(dm.probe_depth(i) == 1u);
+        }
+
+        while (dm.size() > 10)
+        {
+            dm.erase(std::next(dm.begin(), static_cast<std::ptrdiff_t>(dm.size() / 2)));
+        }
+
+        for (const auto& [key, value] : m)
+        {
+            REQUIRE(dm.contains(key) == (dm.find(key) != dm.end()));
+        }
+
+        for (auto it = dm.begin(); it != dm.end(); ++it)
+        {
+            REQUIRE(dm.at(it->first) == it->second);
+        }
+    }
+}
+
+TEST_CASE("ordered storage")
+{
+    using map_type = jg::dense_hash_map<
+        int, std::string, std::hash<int>, std::equal_to<int>,
+        std::allocator<std::pair<const int, std::string>>, jg::details::power_of_two_growth_policy,
+        jg::details::ordered_storage_policy<>>;
+
+    static_assert(std::is_same_v<
+                  std::iterator_traits<map_type::iterator>::iterator_category,
+                  std::bidirectional_iterator_tag>);
+
+    auto keys_of = [](const auto& m) {
+        std::vector<int> keys;
+
+        for (const auto& [key, value] : m)
+        {
+            REQUIRE(value == std::to_string(key));
+            keys.push_back(key);
+        }
+
+        return keys;
+    };
+
+    map_type m;
+
+    for (int i = 0; i < 10; ++i)
+    {
+        m.try_emplace(i, std::to_string(i));
+    }
+
+    SECTION("erase keeps the insertion order")
+    {
+        REQUIRE(m.erase(3) == 1u);
+        REQUIRE(m.erase(0) == 1u);
+        REQUIRE(m.erase(42) == 0u);
+        REQUIRE(m.size() == 8u);
+        REQUIRE(keys_of(m) == std::vector<int>{1, 2, 4, 5, 6, 7, 8, 9});
+        REQUIRE(m.begin()->first == 1);
+        REQUIRE(std::prev(m.end())->first == 9);
+        REQUIRE(std::prev(m.find(4))->first == 2);
+
+        m.try_emplace(3, "3");
+        REQUIRE(keys_of(m) == std::vector<int>{1, 2, 4, 5, 6, 7, 8, 9, 3});
+
+        for (int i = 0; i < 10; ++i)
+        {
+            REQUIRE(m.contains(i) == (i != 0));
+        }
+    }
+
+    SECTION("erase returns the next entry")
+    {
+        auto it = m.erase(m.find(4));
+        REQUIRE(it->first == 5);
+
+        it = m.erase(m.find(3), m.find(7));
+        REQUIRE(it->first == 7);
+        REQUIRE(keys_of(m) == std::vector<int>{0, 1, 2, 7, 8, 9});
+
+        it = m.erase(m.find(9));
+        REQUIRE(it == m.end());
+        REQUIRE(std::prev(m.end())->first == 8);
+    }
+
+    SECTION("erase while iterating")
+    {
+        for (auto it = m.begin(); it != m.end();)
+        {
+            it = it->first % 3 == 0 ? m.erase(it) : std::next(it);
+        }
+
+        REQUIRE(keys_of(m) == std::vector<int>{1, 2, 4, 5, 7, 8});
+
+        for (auto it = m.begin(); it != m.end();)
+        {
+            it = m.erase(it);
+        }
+
+        REQUIRE(m.empty());
+        REQUIRE(m.begin() == m.end());
+        m.try_emplace(1, "1");
+        REQUIRE(keys_of(m) == std::vector<int>{1});
+    }
+
+    SECTION("churn")
+    {
+        std::vector<int> reference(10);
+        std::iota(reference.begin(), reference.end(), 0);
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            const int key = (i * 7919) % 300;
+            const auto found = std::find(reference.begin(), reference.end(), key);
+
+            if (i % 2 == 0)
+            {
+                REQUIRE(m.erase(key) == (found != reference.end() ? 1u : 0u));
+
+                if (found != reference.end())
+                {
+                    reference.erase(found);
+                }
+            }
+            else
+            {
+                const bool inserted = m.try_emplace(key, std::to_string(key)).second;
+                REQUIRE(inserted == (found == reference.end()));
+
+                if (found == reference.end())
+                {
+                    reference.push_back(key);
+                }
+            }
+        }
+
+        REQUIRE(keys_of(m) == reference);
+
+        m.shrink_to_fit();
+        REQUIRE(keys_of(m) == reference);
+
+        for (int key : reference)
+        {
+            REQUIRE(m.at(key) == std::to_string(key));
+        }
+    }
+
+    SECTION("copy, swap and clear")
+    {
+        m.erase(2);
+        m.erase(5);
+
+        auto copy = m;
+        REQUIRE(copy == m);
+        REQUIRE(keys_of(copy) == std::vector<int>{0, 1, 3, 4, 6, 7, 8, 9});
+
+        map_type other{{42, "42"}};
+        other.swap(copy);
+        REQUIRE(copy.size() == 1u);
+        REQUIRE(other.size() == 8u);
+        REQUIRE(keys_of(other) == std::vector<int>{0, 1, 3, 4, 6, 7, 8, 9});
+
+        other.clear();
+        REQUIRE(other.empty());
+        other.try_emplace(1, "1");
+        REQUIRE(other.size() == 1u);
+
+        m.clear(jg::keep_capacity);
+        REQUIRE(m.empty());
+        m.try_emplace(3, "3");
+        REQUIRE(keys_of(m) == std::vector<int>{3});
+    }
+
+    SECTION("erase_if and merge")
+    {
+        m.erase(1);
+        REQUIRE(m.erase_if([](const auto& pair) { return pair.first % 2 == 0; }) == 5u);
+        REQUIRE(keys_of(m) == std::vector<int>{3, 5, 7, 9});
+
+        map_type source{{1, "1"}, {3, "3"}, {10, "10"}, {11, "11"}};
+        source.erase(10);
+        m.merge(source);
+        REQUIRE(keys_of(m) == std::vector<int>{3, 5, 7, 9, 1, 11});
+        REQUIRE(keys_of(source) == std::vector<int>{3});
+    }
+
+    SECTION("extract")
+    {
+        auto nh = m.extract(4);
+        REQUIRE(nh.key() == 4);
+        REQUIRE(m.size() == 9u);
+        REQUIRE_FALSE(m.contains(4));
+
+        nh.key() = 10;
+        nh.mapped() = "10";
+        REQUIRE(m.insert(std::move(nh)).inserted);
+        REQUIRE(keys_of(m) == std::vector<int>{0, 1, 2, 3, 5, 6, 7, 8, 9, 10});
+    }
+
+    SECTION("polymorphic allocator")
+    {
+        std::pmr::monotonic_buffer_resource resource;
+        jg::dense_hash_map<
+            int, std::pmr::string, std::hash<int>, std::equal_to<int>,
+            std::pmr::polymorphic_allocator<std::pair<const int, std::pmr::string>>,
+            jg::details::power_of_two_growth_policy, jg::details::ordered_storage_policy<>>
+            pm(&resource);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            pm.try_emplace(i, std::string(40, 'a'));
+        }
+
+        for (int i = 0; i < 100; i += 2)
+        {
+            pm.erase(i);
+        }
+
+        pm.shrink_to_fit();
+        REQUIRE(pm.size() == 50u);
+        REQUIRE(pm.begin()->first == 1);
+
+        for (const auto& [key, value] : pm)
+        {
+            REQUIRE(value.get_allocator().resource() == &resource);
+        }
+    }
+}
+
+TEST_CASE("handle storage")
+{
+    using map_type = jg::dense_hash_map<
+        std::string, int, std::hash<std::string>, std::equal_to<std::string>,
+        std::allocator<std::pair<const std::string, int>>, jg::details::power_of_two_growth_policy,
+        jg::details::handle_storage_policy<>>;
+
+    map_type m;
+    std::vector<map_type::handle_type> handles;
+
+    for (int i = 0; i < 100; ++i)
+    {
+        handles.push_back(m.handle_of(m.try_emplace(std::to_string(i), i).first));
+    }
+
+    // Every handle of handles resolves to its entry, except those of the erased keys.
+    const auto check_handles = [&](const map_type& map, auto is_erased) {
+        for (int i = 0; i < 100; ++i)
+        {
+            const auto it = map.get(handles[static_cast<std::size_t>(i)]);
+
+            if (is_erased(i))
+            {
+                REQUIRE(it == map.end());
+            }
+            else
+            {
+                REQUIRE(it != map.end());
+                REQUIRE(it->first == std::to_string(i));
+                REQUIRE(it->second == i);
+            }
+        }
+    };
+
+    SECTION("handles survive growth, rehash and the erasure of other entries")
+    {
+        for (int i = 100; i < 1000; ++i)
+        {
+            m.try_emplace(std::to_string(i), i);
+        }
+
+        m.rehash(4096);
+
+        for (int i = 0; i < 1000; i += 3)
+        {
+            m.erase(std::to_string(i));
+        }
+
+        check_handles(m, [](int i) { return i % 3 == 0; });
+        REQUIRE(m.get(map_type::handle_type{}) == m.end());
+    }
+
+    SECTION("a reinserted key gets a new handle")
+    {
+        m.erase("42");
+        REQUIRE(m.get(handles[42]) == m.end());
+
+        const auto handle = m.handle_of(m.try_emplace("42", 42).first);
+        REQUIRE(handle != handles[42]);
+        REQUIRE(m.get(handles[42]) == m.end());
+        REQUIRE(m.get(handle)->second == 42);
+    }
+
+    SECTION("erase_if, ranges, node handles and merge")
+    {
+        m.erase_if([](const auto& pair) { return pair.second % 2 == 0; });
+        check_handles(m, [](int i) { return i % 2 == 0; });
+
+        auto nh = m.extract("1");
+        check_handles(m, [](int i) { return i % 2 == 0 || i == 1; });
+
+        const auto position = m.insert(std::move(nh)).position;
+        REQUIRE(m.get(handles[1]) == m.end());
+        handles[1] = m.handle_of(position);
+
+        map_type other{{"1000", 1000}, {"3", 3}};
+        const auto handle = other.handle_of(other.find("1000"));
+        m.merge(other);
+        REQUIRE(other.get(handle) == other.end());
+        REQUIRE(other.size() == 1u);
+        REQUIRE(m.contains("1000"));
+
+        m.erase(m.begin(), std::next(m.begin(), 10));
+        REQUIRE(m.size() == 41u);
+
+        for (const auto& handle : handles)
+        {
+            const auto it = m.get(handle);
+            REQUIRE((it == m.end() || m.find(it->first) == it));
+        }
+    }
+
+    SECTION("copies resolve the same handles, clear makes them stale")
+    {
+        const auto copy = m;
+        m.erase("7");
+        check_handles(copy, [](int) { return false; });
+        check_handles(m, [](int i) { return i == 7; });
+
+        m.clear();
+        check_handles(m, [](int) { return true; });
+
+        m.try_emplace("0", 0);
+        REQUIRE(m.get(handles[0]) == m.end());
+
+        map_type moved = std::move(m);
+        check_handles(moved, [](int) { return true; });
+        REQUIRE(moved.get(moved.handle_of(moved.begin()))->first == "0");
+    }
+
+    SECTION("polymorphic allocator")
+    {
+        int counter = 0;
+        auto r = counting_pmr_resource(&counter);
+        jg::dense_hash_map<
+            std::pmr::string, int, std::hash<std::pmr::string>, std::equal_to<std::pmr::string>,
+            std::pmr::polymorphic_allocator<std::pair<const std::pmr::string, int>>,
+            jg::details::power_of_two_growth_policy, jg::details::handle_storage_policy<>>
+            pm(&r);
+
+        const auto handle = pm.handle_of(pm.try_emplace("a", 1).first);
+        pm.try_emplace("b", 2);
+        pm.erase("a");
+        REQUIRE(pm.get(handle) == pm.end());
+        REQUIRE(pm.get(pm.handle_of(pm.begin()))->first.get_allocator().resource() == &r);
+    }
+}
+
+TEST_CASE("single block storage")
+{
+    using map_type = jg::dense_hash_map<
+        int, std::string, std::hash<int>, std::equal_to<int>,
+        std::allocator<std::pair<const int, std::string>>, jg::details::power_of_two_growth_policy,
+        jg::details::single_block_storage_policy>;
+
+    map_type m;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        m.try_emplace(i, std::to_string(i));
+    }
+
+    REQUIRE(m.size() == 1000u);
+
+    SECTION("find")
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            REQUIRE(m.at(i) == std::to_string(i));
+        }
+
+        REQUIRE_FALSE(m.contains(1000));
+    }
+
+    SECTION("erase")
+    {
+        for (int i = 0; i < 1000; i += 2)
+        {
+            REQUIRE(m.erase(i) == 1u);
+        }
+
+        REQUIRE(m.size() == 500u);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            REQUIRE(m.contains(i) == (i % 2 == 1));
+        }
+
+        m.erase(m.begin(), m.end());
+        REQUIRE(m.empty());
+    }
+
+    SECTION("rehash")
+    {
+        m.rehash(1u << 12);
+        REQUIRE(m.bucket_count() == 1u << 12);
+        m.reserve(5000);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            REQUIRE(m.at(i) == std::to_string(i));
+        }
+    }
+
+    SECTION("copy and move")
+    {
+        auto copy = m;
+        REQUIRE(copy == m);
+
+        auto moved = std::move(copy);
+        REQUIRE(moved == m);
+        REQUIRE(copy.empty());
+
+        m.clear();
+        REQUIRE(m.empty());
+        REQUIRE(m.bucket_count() == 8u);
+        m.try_emplace(1, "1");
+        REQUIRE(m.at(1) == "1");
+
+        m = moved;
+        REQUIRE(moved == m);
+
+        swap(m, copy);
+        REQUIRE(copy == moved);
+        REQUIRE(m.empty());
+    }
+
+    SECTION("move only")
+    {
+        jg::dense_hash_map<
+            int, std::unique_ptr<int>, std::hash<int>, std::equal_to<int>,
+            std::allocator<std::pair<const int, std::unique_ptr<int>>>,
+            jg::details::power_of_two_growth_policy, jg::details::single_block_storage_policy>
+            m2;
+
+        for (int i = 0; i < 100; ++i)
+        {
+            m2.try_emplace(i, std::make_unique<int>(i));
+        }
+
+        auto m3 = std::move(m2);
+        REQUIRE(*m3.at(42) == 42);
+    }
+}
+
+TEST_CASE("single block storage allocations")
+{
+    int counter = 0;
+    auto r = counting_pmr_resource(&counter);
+
+    using map_type = jg::pmr::dense_hash_map<
+        int, int, std::hash<int>, std::equal_to<int>, jg::details::power_of_two_growth_policy,
+        jg::details::single_block_storage_policy>;
+
+    map_type m(8u, &r);
+    REQUIRE(counter == 1);
+
+    for (int i = 0; i < 7; ++i)
+    {
+        m.try_emplace(i, i);
+    }
+
+    REQUIRE(counter == 1);
+
+    // Growing the buckets also grows the nodes: one allocation per growth step.
+    m.try_emplace(7, 7);
+    REQUIRE(m.bucket_count() == 16u);
+    REQUIRE(counter == 2);
+
+    m.clear();
+    REQUIRE(counter == 2);
+
+    SECTION("move between resources")
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            m.try_emplace(i, i);
+        }
+
+        std::pmr::monotonic_buffer_resource other_resource;
+        map_type other(8u, &other_resource);
+        other = std::move(m);
+
+        REQUIRE(other.size() == 100u);
+        REQUIRE(other.at(42) == 42);
+        REQUIRE(other.get_allocator().resource() == &other_resource);
+    }
+}
+
+TEST_CASE("small dense hash map")
+{
+    int counter = 0;
+    auto r = counting_pmr_resource(&counter);
+
+    jg::pmr::small_dense_hash_map<int, int, 4> m(&r);
+
+    SECTION("empty maps do not allocate")
+    {
+        REQUIRE(m.empty());
+        REQUIRE(m.bucket_count() == 0u);
+        REQUIRE(m.find(1) == m.end());
+        REQUIRE(m.erase(1) == 0u);
+        REQUIRE(counter == 0);
+
+        jg::small_dense_hash_map<std::string, std::string> m2;
+        REQUIRE(m2.bucket_count() == 0u);
+    }
+
+    SECTION("linear mode")
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            REQUIRE(m.try_emplace(i, i * 2).second);
+        }
+
+        REQUIRE_FALSE(m.try_emplace(2, 0).second);
+        REQUIRE(m.try_emplace(3, 6).second);
+        REQUIRE(m.size() == 4u);
+        REQUIRE(m.bucket_count() == 0u);
+        REQUIRE(m.load_factor() == 0.0f);
+        REQUIRE(counter == 0);
+
+        for (int i = 0; i < 4; ++i)
+        {
+            REQUIRE(m.at(i) == i * 2);
+        }
+
+        REQUIRE(m.erase(1) == 1u);
+        REQUIRE_FALSE(m.contains(1));
+        m.erase(m.begin());
+        REQUIRE(m.size() == 2u);
+        REQUIRE(m.contains(2));
+        REQUIRE(m.contains(3));
+        REQUIRE(counter == 0);
+    }
+
+    SECTION("switches to hashed mode when outgrowing N")
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            m[i] = i;
+        }
+
+        REQUIRE(m.bucket_count() >= 128u);
+        REQUIRE(m.load_factor() == 100.0f / m.bucket_count());
+        REQUIRE(counter > 0);
+
+        for (int i = 0; i < 100; ++i)
+        {
+            REQUIRE(m.at(i) == i);
+        }
+
+        m.clear();
+        REQUIRE(m.bucket_count() == 0u);
+        m[1] = 1;
+        REQUIRE(m.at(1) == 1);
+    }
+
+    SECTION("reserve and rehash")
+    {
+        m.reserve(3);
+        REQUIRE(m.bucket_count() == 0u);
+        REQUIRE(counter == 0);
+
+        m.reserve(10);
+        REQUIRE(m.bucket_count() == 16u);
+
+        m[1] = 1;
+        m.rehash(0);
+        REQUIRE(m.bucket_count() == 0u);
+        REQUIRE(m.at(1) == 1);
+    }
+
+    SECTION("copy, move and swap")
+    {
+        jg::small_dense_hash_map<std::string, std::string, 4> small{{"a", "a"}, {"b", "b"}};
+        jg::small_dense_hash_map<std::string, std::string, 4> big;
+
+        for (int i = 0; i < 10; ++i)
+        {
+            big.try_emplace(std::to_string(i), std::to_string(i));
+        }
+
+        auto small_copy = small;
+        auto big_copy = big;
+        REQUIRE(small_copy == small);
+        REQUIRE(big_copy == big);
+
+        auto small_moved = std::move(small_copy);
+        auto big_moved = std::move(big_copy);
+        REQUIRE(small_moved == small);
+        REQUIRE(big_moved == big);
+
+        swap(small_moved, big_moved);
+        REQUIRE(small_moved == big);
+        REQUIRE(big_moved == small);
+
+        small_moved = big_moved;
+        REQUIRE(small_moved == small);
+    }
+}
+
+TEST_CASE("dense hash set")
+{
+    jg::dense_hash_set<int> s{3, 1, 2, 3};
+
+    SECTION("basic operations")
+    {
+        REQUIRE(s.size() == 3u);
+        REQUIRE(std::vector<int>(s.begin(), s.end()) == std::vector<int>{3, 1, 2});
+        REQUIRE(s.contains(1));
+        REQUIRE_FALSE(s.contains(4));
+        REQUIRE(s.count(2) == 1u);
+        REQUIRE(*s.find(2) == 2);
+
+        const auto [it, inserted] = s.insert(4);
+        REQUIRE(inserted);
+        REQUIRE(*it == 4);
+        REQUIRE_FALSE(s.insert(4).second);
+        REQUIRE_FALSE(s.emplace(1).second);
+        REQUIRE(*s.emplace_hint(s.end(), 5) == 5);
+        REQUIRE(s.size() == 5u);
+
+        REQUIRE(s.erase(1) == 1u);
+        REQUIRE(s.erase(1) == 0u);
+        REQUIRE(*s.erase(s.begin()) == 4);
+        REQUIRE(std::vector<int>(s.begin(), s.end()) == std::vector<int>{4, 5, 2});
+
+        s.clear();
+        REQUIRE(s.empty());
+        REQUIRE(s.begin() == s.end());
+    }
+
+    SECTION("nodes only hold the key")
+    {
+        REQUIRE(
+            sizeof(jg::details::set_node<std::uint64_t>) <
+            sizeof(jg::details::node<std::uint64_t, std::uint64_t>));
+
+        REQUIRE(
+            std::is_same_v<
+                std::iterator_traits<jg::dense_hash_set<int>::iterator>::reference, const int&>);
+    }
+
+    SECTION("rehash keeps the keys")
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            s.insert(i);
+        }
+
+        REQUIRE(s.size() == 1000u);
+        REQUIRE(s.load_factor() <= s.max_load_factor());
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            REQUIRE(s.contains(i));
+            REQUIRE(*s.begin(static_cast<std::size_t>(s.bucket(i))) >= 0);
+        }
+    }
+
+    SECTION("heterogeneous lookup and insertion")
+    {
+        jg::dense_hash_set<counted_string, string_view_hash, std::equal_to<>> strings;
+        strings.reserve(2);
+        counted_string::counts = {};
+
+        REQUIRE(strings.insert(std::string_view("a")).second);
+        REQUIRE_FALSE(strings.insert(std::string_view("a")).second);
+        REQUIRE(strings.emplace(std::string_view("b")).second);
+        REQUIRE(counted_string::counts == lifetime_counts{2, 0, 0});
+
+        REQUIRE(strings.contains(std::string_view("a")));
+        REQUIRE(strings.find(std::string_view("b"))->value == "b");
+        REQUIRE(strings.erase(std::string_view("a")) == 1u);
+        REQUIRE(strings.size() == 1u);
+    }
+
+    SECTION("extract and insert nodes")
+    {
+        auto node = s.extract(1);
+        REQUIRE(node.value() == 1);
+        REQUIRE_FALSE(s.contains(1));
+
+        node.value() = 4;
+        const auto result = s.insert(std::move(node));
+        REQUIRE(result.inserted);
+        REQUIRE(*result.position == 4);
+
+        auto other = s.extract(s.find(4));
+        other.value() = 3;
+        const auto duplicate = s.insert(std::move(other));
+        REQUIRE_FALSE(duplicate.inserted);
+        REQUIRE(duplicate.node.value() == 3);
+    }
+
+    SECTION("merge")
+    {
+        jg::dense_hash_set<int> source{2, 4, 5};
+        s.merge(source);
+
+        REQUIRE(s == jg::dense_hash_set<int>{1, 2, 3, 4, 5});
+        REQUIRE(source == jg::dense_hash_set<int>{2});
+    }
+
+    SECTION("erase_if")
+    {
+        REQUIRE(erase_if(s, [](int key) { return key % 2 == 1; }) == 2u);
+        REQUIRE(s == jg::dense_hash_set<int>{2});
+    }
+
+    SECTION("comparison and swap")
+    {
+        jg::dense_hash_set<int> other{2, 1, 3};
+        REQUIRE(s == other);
+
+        other.insert(4);
+        REQUIRE(s != other);
+
+        swap(s, other);
+        REQUIRE(s.size() == 4u);
+        REQUIRE(other.size() == 3u);
+    }
+
+    SECTION("deduction guides")
+    {
+        const std::vector<int> keys{1, 2};
+        jg::dense_hash_set from_range(keys.begin(), keys.end());
+        jg::dense_hash_set from_list{1, 2};
+
+        REQUIRE(std::is_same_v<decltype(from_range), jg::dense_hash_set<int>>);
+        REQUIRE(std::is_same_v<decltype(from_list), jg::dense_hash_set<int>>);
+        REQUIRE(from_range == from_list);
+    }
+
+    SECTION("pmr")
+    {
+        int counter = 0;
+        auto r = counting_pmr_resource(&counter);
+        jg::pmr::dense_hash_set<int> pmr_set(&r);
+
+        pmr_set.insert(1);
+        REQUIRE(counter > 0);
+        REQUIRE(pmr_set.get_allocator().resource() == &r);
+    }
+}
+
+TEST_CASE("dense hash multimap")
+{
+    jg::dense_hash_multimap<int, int> m{{1, 10}, {2, 20}, {1, 11}, {3, 30}, {1, 12}};
+
+    const auto values_of = [&](int key) {
+        std::vector<int> values;
+        const auto [first, last] = m.equal_range(key);
+        std::transform(first, last, std::back_inserter(values), [](const auto& item) {
+            return item.second;
+        });
+        return values;
+    };
+
+    SECTION("duplicate keys are chained in insertion order")
+    {
+        REQUIRE(m.size() == 5u);
+        REQUIRE(m.key_count() == 3u);
+        REQUIRE(m.count(1) == 3u);
+        REQUIRE(m.count(2) == 1u);
+        REQUIRE(m.count(4) == 0u);
+        REQUIRE(values_of(1) == std::vector<int>{10, 11, 12});
+        REQUIRE(values_of(4).empty());
+        REQUIRE(m.find(1)->second == 10);
+        REQUIRE(m.find(4) == m.end());
+        REQUIRE(m.contains(3));
+        REQUIRE_FALSE(m.contains(4));
+
+        const auto it = m.emplace(2, 21);
+        REQUIRE(it->second == 21);
+        REQUIRE(values_of(2) == std::vector<int>{20, 21});
+    }
+
+    SECTION("insert_many")
+    {
+        const std::vector<int> values{13, 14, 15};
+        const auto it = m.insert_many(1, values);
+
+        REQUIRE(std::distance(it, m.end()) == 3);
+        REQUIRE(it->second == 13);
+        REQUIRE(m.count(1) == 6u);
+        REQUIRE(values_of(1) == std::vector<int>{10, 11, 12, 13, 14, 15});
+
+        m.insert_many(4, {40, 41});
+        REQUIRE(m.key_count() == 4u);
+        REQUIRE(values_of(4) == std::vector<int>{40, 41});
+
+        REQUIRE(m.insert_many(5, std::vector<int>{}) == m.end());
+        REQUIRE_FALSE(m.contains(5));
+    }
+
+    SECTION("erase by key")
+    {
+        REQUIRE(m.erase(1) == 3u);
+        REQUIRE(m.erase(1) == 0u);
+        REQUIRE(m.size() == 2u);
+        REQUIRE(m.key_count() == 2u);
+        REQUIRE(values_of(2) == std::vector<int>{20});
+        REQUIRE(values_of(3) == std::vector<int>{30});
+    }
+
+    SECTION("erase by iterator relinks the moved entry")
+    {
+        // {1, 12} is last and moves in place of {2, 20}.
+        const auto it = m.erase(std::next(m.begin()));
+        REQUIRE(*it == std::pair<const int, int>{1, 12});
+        REQUIRE_FALSE(m.contains(2));
+        REQUIRE(m.key_count() == 2u);
+        REQUIRE(values_of(1) == std::vector<int>{10, 11, 12});
+
+        // The head of a chain moves.
+        m.erase(m.find(3));
+        REQUIRE(values_of(1) == std::vector<int>{10, 11, 12});
+
+        m.erase(m.find(1));
+        REQUIRE(values_of(1) == std::vector<int>{11, 12});
+        REQUIRE(m.count(1) == 2u);
+
+        m.erase(m.begin(), m.end());
+        REQUIRE(m.empty());
+        REQUIRE(m.key_count() == 0u);
+    }
+
+    SECTION("erase_if")
+    {
+        REQUIRE(erase_if(m, [](const auto& item) { return item.second % 2 == 0; }) == 4u);
+        REQUIRE(m.size() == 1u);
+        REQUIRE(values_of(1) == std::vector<int>{11});
+        REQUIRE_FALSE(m.contains(2));
+    }
+
+    SECTION("many keys and values")
+    {
+        jg::dense_hash_multimap<int, int> big;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            big.emplace(i % 37, i);
+        }
+
+        REQUIRE(big.key_count() == 37u);
+
+        for (int i = 0; i < 1000; i += 3)
+        {
+            big.erase(std::find(big.begin(), big.end(), std::pair<const int, int>{i % 37, i}));
+        }
+
+        for (int key = 0; key < 37; ++key)
+        {
+            std::vector<int> expected;
+
+            for (int i = key; i < 1000; i += 37)
+            {
+                if (i % 3 != 0)
+                {
+                    expected.push_back(i);
+                }
+            }
+
+            std::vector<int> values;
+            const auto [first, last] = big.equal_range(key);
+            std::transform(first, last, std::back_inserter(values), [](const auto& item) {
+                return item.second;
+            });
+            std::sort(values.begin(), values.end());
+
+            REQUIRE(values == expected);
+            REQUIRE(big.count(key) == expected.size());
+        }
+    }
+
+    SECTION("shrink_to_fit regroups the entries by key")
+    {
+        m.shrink_to_fit();
+
+        using entries = std::vector<std::pair<int, int>>;
+        const entries regrouped{{1, 10}, {1, 11}, {1, 12}, {2, 20}, {3, 30}};
+        REQUIRE(entries(m.begin(), m.end()) == regrouped);
+        REQUIRE(values_of(1) == std::vector<int>{10, 11, 12});
+        REQUIRE(m.count(1) == 3u);
+
+        // Growing from a full buffer, with an entry of the buffer.
+        m.emplace(*m.begin());
+        REQUIRE(values_of(1) == std::vector<int>{10, 11, 12, 10});
+
+        m.emplace(2, 21);
+        m.erase(m.begin());
+        REQUIRE(values_of(1) == std::vector<int>{11, 12, 10});
+        REQUIRE(values_of(2) == std::vector<int>{20, 21});
+    }
+
+    SECTION("comparison and swap")
+    {
+        jg::dense_hash_multimap<int, int> other{{3, 30}, {1, 12}, {1, 10}, {2, 20}, {1, 11}};
+        REQUIRE(m == other);
+
+        other.emplace(1, 10);
+        REQUIRE(m != other);
+
+        swap(m, other);
+        REQUIRE(m.size() == 6u);
+        REQUIRE(other.size() == 5u);
+    }
+
+    SECTION("pmr")
+    {
+        int counter = 0;
+        auto r = counting_pmr_resource(&counter);
+        jg::pmr::dense_hash_multimap<std::pmr::string, std::pmr::string> strings(&r);
+
+        strings.emplace("a", "b");
+        strings.insert_many("a", {"c", "d"});
+        REQUIRE(counter > 0);
+        REQUIRE(strings.count("a") == 3u);
+        REQUIRE(strings.find("a")->second.get_allocator().resource() == &r);
+    }
+}
+
+TEST_CASE("dense string map")
+{
+    jg::dense_string_map<int> m;
+    const std::string long_key(100, 'x');
+
+    m.try_emplace("one", 1);
+    m.try_emplace(long_key, 100);
+    m["two"] = 2;
+
+    SECTION("lookup")
+    {
+        REQUIRE(m.size() == 3u);
+        REQUIRE(m.at("one") == 1);
+        REQUIRE(*m.find(long_key) == 100);
+        REQUIRE(*m.find(std::string_view{"two"}) == 2);
+        REQUIRE(m.find("three") == nullptr);
+        REQUIRE(m.contains(std::string{"one"}));
+        REQUIRE_FALSE(m.contains("on"));
+        REQUIRE_FALSE(m.contains(""));
+#ifndef JG_NO_EXCEPTION
+        REQUIRE_THROWS_AS(m.at("three"), std::out_of_range);
+#endif
+
+        const auto& cm = m;
+        REQUIRE(*cm.find("one") == 1);
+    }
+
+    SECTION("insertion copies the key to the arena once")
+    {
+        REQUIRE(m.key_bytes() == 106u);
+        REQUIRE(m.arena_size() == 106u);
+
+        auto [value, inserted] = m.try_emplace("one", 10);
+        REQUIRE_FALSE(inserted);
+        REQUIRE(value == 1);
+        REQUIRE(m.arena_size() == 106u);
+
+        std::tie(std::ignore, inserted) = m.insert_or_assign("one", 11);
+        REQUIRE_FALSE(inserted);
+        REQUIRE(m.at("one") == 11);
+
+        REQUIRE(m.try_emplace("", 0).second);
+        REQUIRE(m.contains(""));
+        REQUIRE(m.size() == 4u);
+    }
+
+    SECTION("erasures compact the arena")
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            m.try_emplace(std::to_string(i) + long_key, i);
+        }
+
+        for (int i = 0; i < 1000; i += 2)
+        {
+            REQUIRE(m.erase(std::to_string(i) + long_key) == 1u);
+        }
+
+        REQUIRE(m.erase(std::to_string(0) + long_key) == 0u);
+        REQUIRE(m.arena_size() <= 2 * m.key_bytes());
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            const auto found = m.find(std::to_string(i) + long_key);
+            REQUIRE((found == nullptr) == (i % 2 == 0));
+            REQUIRE((found == nullptr || *found == i));
+        }
+
+        std::size_t bytes = 0;
+        m.for_each([&](std::string_view key, int& value) {
+            bytes += key.size();
+            REQUIRE(m.at(key) == value);
+        });
+        REQUIRE(bytes == m.key_bytes());
+
+        m.shrink_to_fit();
+        REQUIRE(m.arena_size() == m.key_bytes());
+        REQUIRE(m.at("999" + long_key) == 999);
+
+        m.clear();
+        REQUIRE(m.empty());
+        REQUIRE(m.arena_size() == 0u);
+    }
+
+    SECTION("copies and moves")
+    {
+        auto copy = m;
+        m.erase("one");
+        REQUIRE(copy.at("one") == 1);
+
+        const auto moved = std::move(copy);
+        REQUIRE(moved.at(long_key) == 100);
+        REQUIRE(moved.size() == 3u);
+    }
+
+    SECTION("loading allocates O(log n) times")
+    {
+        int counter = 0;
+        auto r = counting_pmr_resource(&counter);
+        jg::pmr::dense_string_map<std::pmr::string> strings(&r);
+
+        for (int i = 0; i < 100'000; ++i)
+        {
+            strings.try_emplace("a key longer than the small string buffer " + std::to_string(i));
+        }
+
+        REQUIRE(strings.size() == 100'000u);
+        REQUIRE(counter < 64);
+
+        strings["a"] = "b";
+        REQUIRE(strings.at("a").get_allocator().resource() == &r);
+    }
+}
+
+TEST_CASE("dense lru cache")
+{
+    jg::dense_lru_cache<int, std::string> cache(3u);
+
+    REQUIRE(cache.empty());
+    REQUIRE(cache.capacity() == 3u);
+    REQUIRE(cache.get(1) == nullptr);
+
+    cache.put(1, "1");
+    cache.put(2, "2");
+    cache.put(3, "3");
+    REQUIRE(cache.size() == 3u);
+    REQUIRE(cache.least_recent().first == 1);
+
+    SECTION("put evicts the least recently used entry")
+    {
+        REQUIRE(*cache.get(1) == "1");
+        REQUIRE(cache.least_recent().first == 2);
+
+        REQUIRE(cache.put(4, "4") == "4");
+        REQUIRE(cache.size() == 3u);
+        REQUIRE_FALSE(cache.contains(2));
+        REQUIRE(cache.least_recent().first == 3);
+
+        cache.put(5, "5");
+        cache.put(6, "6");
+        REQUIRE(cache.size() == 3u);
+        REQUIRE(cache.least_recent().first == 4);
+
+        for (int i : {4, 5, 6})
+        {
+            REQUIRE(*cache.peek(i) == std::to_string(i));
+        }
+    }
+
+    SECTION("put assigns and promotes an existing key")
+    {
+        REQUIRE(cache.put(1, "one") == "one");
+        REQUIRE(cache.size() == 3u);
+        REQUIRE(cache.least_recent().first == 2);
+
+        cache.put(4, "4");
+        REQUIRE(*cache.get(1) == "one");
+        REQUIRE_FALSE(cache.contains(2));
+    }
+
+    SECTION("peek does not promote")
+    {
+        REQUIRE(*cache.peek(1) == "1");
+        REQUIRE(cache.peek(4) == nullptr);
+        cache.put(4, "4");
+        REQUIRE_FALSE(cache.contains(1));
+    }
+
+    SECTION("erase")
+    {
+        REQUIRE(cache.erase(1) == 1u);
+        REQUIRE(cache.erase(1) == 0u);
+        REQUIRE(cache.least_recent().first == 2);
+
+        REQUIRE(cache.erase(3) == 1u);
+        REQUIRE(cache.erase(2) == 1u);
+        REQUIRE(cache.empty());
+
+        cache.put(7, "7");
+        REQUIRE(cache.least_recent().first == 7);
+        REQUIRE(*cache.get(7) == "7");
+    }
+
+    SECTION("get_many")
+    {
+        const std::vector<int> keys{3, 42, 1};
+        std::vector<std::string> found;
+
+        cache.get_many(keys.begin(), keys.end(), [&](auto it, std::string* value) {
+            found.push_back(value == nullptr ? "miss " + std::to_string(*it) : *value);
+        });
+
+        REQUIRE(found == std::vector<std::string>{"3", "miss 42", "1"});
+        REQUIRE(cache.least_recent().first == 2);
+    }
+
+    SECTION("clear, copy and move")
+    {
+        auto copy = cache;
+        cache.clear();
+        REQUIRE(cache.empty());
+        cache.put(8, "8");
+        REQUIRE(cache.least_recent().first == 8);
+
+        REQUIRE(copy.size() == 3u);
+        REQUIRE(copy.least_recent().first == 1);
+
+        auto moved = std::move(copy);
+        moved.put(9, "9");
+        REQUIRE(moved.least_recent().first == 2);
+        REQUIRE_FALSE(moved.contains(1));
+    }
+
+    SECTION("churn")
+    {
+        // A reference LRU: the keys from the least to the most recently used.
+        std::vector<int> reference{1, 2, 3};
+        jg::dense_lru_cache<int, std::string> big(64u);
+
+        for (int key : reference)
+        {
+            big.put(key, std::to_string(key));
+        }
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            const int key = (i * 7919) % 150;
+            const auto found = std::find(reference.begin(), reference.end(), key);
+
+            if (i % 5 == 0)
+            {
+                REQUIRE(big.erase(key) == (found != reference.end() ? 1u : 0u));
+
+                if (found != reference.end())
+                {
+                    reference.erase(found);
+                }
+
+                continue;
+            }
+
+            if (i % 2 == 0)
+            {
+                const auto value = big.get(key);
+                REQUIRE((value != nullptr) == (found != reference.end()));
+
+                if (found != reference.end())
+                {
+                    REQUIRE(*value == std::to_string(key));
+                    reference.erase(found);
+                    reference.push_back(key);
+                }
+
+                continue;
+            }
+
+            big.put(key, std::to_string(key));
+
+            if (found != reference.end())
+            {
+                reference.erase(found);
+            }
+            else if (reference.size() == big.capacity())
+            {
+                reference.erase(reference.begin());
+            }
+
+            reference.push_back(key);
+            REQUIRE(big.size() == reference.size());
+            REQUIRE(big.least_recent().first == reference.front());
+        }
+
+        for (int key : reference)
+        {
+            REQUIRE(*big.peek(key) == std::to_string(key));
+        }
+    }
+
+    SECTION("pmr")
+    {
+        int counter = 0;
+        auto r = counting_pmr_resource(&counter);
+        jg::dense_lru_cache<
+            std::pmr::string, std::pmr::string, std::hash<std::pmr::string>,
+            std::equal_to<std::pmr::string>,
+            std::pmr::polymorphic_allocator<std::pair<const std::pmr::string, std::pmr::string>>>
+            strings(2u, &r);
+
+        REQUIRE(counter > 0);
+        strings.put("a", "b");
+        REQUIRE(strings.get("a")->get_allocator().resource() == &r);
+    }
+}
+
+TEST_CASE("dense ttl map")
+{
+    using namespace std::chrono_literals;
+    using time_point = std::chrono::steady_clock::time_point;
+
+    const time_point t0{1000s};
+    jg::dense_ttl_map<int, std::string> m;
+
+    m.put(1, "1", t0 + 10ms);
+    m.put(2, "2", t0 + 20ms);
+    m.put(3, "3", t0 + 1h);
+    REQUIRE(m.size() == 3u);
+
+    SECTION("expired entries are missing before they are reaped")
+    {
+        REQUIRE(*m.get(1, t0) == "1");
+        REQUIRE(m.get(1, t0 + 10ms) == nullptr);
+        REQUIRE_FALSE(m.contains(1, t0 + 15ms));
+        REQUIRE(m.contains(2, t0 + 15ms));
+        REQUIRE(m.get(42, t0) == nullptr);
+        REQUIRE(m.size() == 3u);
+    }
+
+    SECTION("expire reaps the due entries")
+    {
+        REQUIRE(m.expire(t0) == 0u);
+        REQUIRE(m.expire(t0 + 10ms) == 1u);
+        REQUIRE(m.size() == 2u);
+        REQUIRE(m.expire(t0 + 15ms) == 0u);
+        REQUIRE(m.expire(t0 + 30ms) == 1u);
+        REQUIRE(m.size() == 1u);
+        REQUIRE(*m.get(3, t0 + 30ms) == "3");
+
+        m.put(4, "4", t0 + 40ms);
+        REQUIRE(m.expire(t0 + 2h) == 2u);
+        REQUIRE(m.empty());
+    }
+
+    SECTION("put and refresh move the deadline")
+    {
+        REQUIRE(m.put(1, "one", t0 + 1h) == "one");
+        REQUIRE(m.size() == 3u);
+        REQUIRE(m.refresh(2, t0 + 5ms, t0 + 2h) != nullptr);
+        REQUIRE(m.refresh(42, t0, t0 + 2h) == nullptr);
+        REQUIRE(m.expire(t0 + 30ms) == 0u);
+        REQUIRE(*m.get(1, t0 + 30ms) == "one");
+
+        REQUIRE(m.refresh(3, t0 + 1h, t0 + 3h) == nullptr);
+        REQUIRE(m.expire(t0 + 1h) == 2u);
+        REQUIRE(*m.get(2, t0 + 1h) == "2");
+    }
+
+    SECTION("erase")
+    {
+        REQUIRE(m.erase(1) == 1u);
+        REQUIRE(m.erase(1) == 0u);
+        REQUIRE(m.expire(t0 + 20ms) == 1u);
+        REQUIRE(m.size() == 1u);
+
+        m.clear();
+        REQUIRE(m.empty());
+        REQUIRE(m.expire(t0 + 2h) == 0u);
+    }
+
+    SECTION("expire does not touch the nodes when nothing is due")
+    {
+        struct counting_hash
+        {
+            auto operator()(int i) const -> std::size_t
+            {
+                ++*calls;
+                return std::hash<int>{}(i);
+            }
+
+            std::size_t* calls;
+        };
+
+        std::size_t calls = 0;
+        jg::dense_ttl_map<int, int, std::chrono::steady_clock, counting_hash> counted(
+            1ms, counting_hash{&calls});
+
+        counted.expire(t0);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            counted.put(i, i, t0 + std::chrono::milliseconds(100 + i));
+        }
+
+        calls = 0;
+
+        for (auto now = t0; now < t0 + 100ms; now += 1ms)
+        {
+            REQUIRE(counted.expire(now) == 0u);
+        }
+
+        REQUIRE(calls == 0u);
+        REQUIRE(counted.expire(t0 + 600ms) == 501u);
+        REQUIRE(counted.size() == 499u);
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            REQUIRE(counted.contains(i, t0 + 600ms) == (i > 500));
+        }
+    }
+
+    SECTION("churn")
+    {
+        std::unordered_map<int, time_point> reference{
+            {1, t0 + 10ms}, {2, t0 + 20ms}, {3, t0 + 1h}};
+        auto now = t0;
+
+        for (int i = 0; i < 5000; ++i)
+        {
+            const int key = (i * 7919) % 300;
+            now += std::chrono::microseconds((i * 31) % 700);
+
+            if (i % 7 == 0)
+            {
+                std::size_t due = 0;
+
+                for (auto it = reference.begin(); it != reference.end();)
+                {
+                    it = it->second <= now ? (++due, reference.erase(it)) : std::next(it);
+                }
+
+                REQUIRE(m.expire(now) == due);
+            }
+            else if (i % 5 == 0)
+            {
+                REQUIRE(m.erase(key) == reference.erase(key));
+            }
+            else
+            {
+                const auto deadline = now + std::chrono::milliseconds((i * 13) % 5000);
+                m.put(key, std::to_string(key), deadline);
+                reference[key] = deadline;
+            }
+
+            REQUIRE(m.size() == reference.size());
+        }
+
+        for (const auto& [key, deadline] : reference)
+        {
+            REQUIRE(m.contains(key, now) == (deadline > now));
+        }
+    }
+
+    SECTION("pmr")
+    {
+        int counter = 0;
+        auto r = counting_pmr_resource(&counter);
+        jg::dense_ttl_map<
+            std::pmr::string, std::pmr::string, std::chrono::steady_clock,
+            std::hash<std::pmr::string>, std::equal_to<std::pmr::string>,
+            std::pmr::polymorphic_allocator<std::pair<const std::pmr::string, std::pmr::string>>>
+            strings(&r);
+
+        strings.put("a", "b", t0 + 1s);
+        REQUIRE(counter > 0);
+        REQUIRE(strings.get("a", t0)->get_allocator().resource() == &r);
+    }
+}
+
+TEST_CASE("dense bimap")
+{
+    jg::dense_bimap<std::string, int, string_hash> m{{"one", 1}, {"two", 2}, {"three", 3}};
+
+    // Both sides find every entry, and agree on it.
+    const auto is_consistent = [&] {
+        for (const auto& [left, right] : m)
+        {
+            if (m.at_left(left) != right || m.at_right(right) != left)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    SECTION("lookup from both sides")
+    {
+        REQUIRE(m.size() == 3u);
+        REQUIRE(m.at_left("two") == 2);
+        REQUIRE(m.at_right(3) == "three");
+        REQUIRE(m.contains_left("one"));
+        REQUIRE(m.contains_left(nested_string{"one"}));
+        REQUIRE_FALSE(m.contains_left("four"));
+        REQUIRE(m.contains_right(1));
+        REQUIRE_FALSE(m.contains_right(4));
+        REQUIRE(m.find_left("four") == m.end());
+        REQUIRE(m.find_right(2)->first == "two");
+#ifndef JG_NO_EXCEPTION
+        REQUIRE_THROWS_AS(m.at_left("four"), std::out_of_range);
+        REQUIRE_THROWS_AS(m.at_right(4), std::out_of_range);
+#endif
+    }
+
+    SECTION("an insertion fails when either value is mapped")
+    {
+        auto [it, inserted] = m.insert({"four", 4});
+        REQUIRE(inserted);
+        REQUIRE(*it == std::pair<const std::string, int>{"four", 4});
+
+        std::tie(it, inserted) = m.emplace("two", 5);
+        REQUIRE_FALSE(inserted);
+        REQUIRE(it->first == "two");
+        REQUIRE(it->second == 2);
+
+        std::tie(it, inserted) = m.emplace("five", 1);
+        REQUIRE_FALSE(inserted);
+        REQUIRE(it->first == "one");
+
+        REQUIRE(m.size() == 4u);
+        REQUIRE_FALSE(m.contains_right(5));
+        REQUIRE_FALSE(m.contains_left("five"));
+        REQUIRE(is_consistent());
+    }
+
+    SECTION("an erase from either side updates both")
+    {
+        REQUIRE(m.erase_left("one") == 1u);
+        REQUIRE(m.erase_left("one") == 0u);
+        REQUIRE_FALSE(m.contains_right(1));
+        REQUIRE(is_consistent());
+
+        REQUIRE(m.erase_right(2) == 1u);
+        REQUIRE(m.erase_right(2) == 0u);
+        REQUIRE_FALSE(m.contains_left("two"));
+        REQUIRE(is_consistent());
+
+        const auto it = m.erase(m.begin());
+        REQUIRE(it == m.end());
+        REQUIRE(m.empty());
+
+        REQUIRE(m.insert({"two", 1}).second);
+        REQUIRE(m.at_right(1) == "two");
+    }
+
+    SECTION("many entries")
+    {
+        jg::dense_bimap<int, std::string> big;
+        std::unordered_map<int, std::string> reference;
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            REQUIRE(big.emplace(i, std::to_string(i * 7)).second);
+            reference.emplace(i, std::to_string(i * 7));
+        }
+
+        REQUIRE(big.load_factor() <= big.max_load_factor());
+
+        for (int i = 0; i < 2000; i += 3)
+        {
+            REQUIRE(big.erase_left(i) == 1u);
+            reference.erase(i);
+        }
+
+        for (int i = 1; i < 2000; i += 3)
+        {
+            REQUIRE(big.erase_right(std::to_string(i * 7)) == 1u);
+            reference.erase(i);
+        }
+
+        REQUIRE(big.size() == reference.size());
+
+        for (const auto& [left, right] : reference)
+        {
+            REQUIRE(big.at_left(left) == right);
+            REQUIRE(big.at_right(right) == left);
+        }
+
+        const auto erased = std::erase_if(big, [](const auto& pair) { return pair.first < 1000; });
+        REQUIRE(erased == 333u);
+        REQUIRE(big.size() == reference.size() - erased);
+        REQUIRE_FALSE(big.contains_left(2));
+        REQUIRE(big.at_right(std::to_string(1001 * 7)) == 1001);
+
+        big.rehash(4096);
+        REQUIRE(big.bucket_count() == 4096u);
+        REQUIRE(big.at_left(1997) == std::to_string(1997 * 7));
+    }
+
+    SECTION("comparison and swap")
+    {
+        jg::dense_bimap<std::string, int, string_hash> other{{"three", 3}, {"one", 1}, {"two", 2}};
+        REQUIRE(m == other);
+
+        other.erase_left("one");
+        other.emplace("one", 4);
+        REQUIRE(m != other);
+
+        swap(m, other);
+        REQUIRE(m.at_left("one") == 4);
+        REQUIRE(other.at_left("one") == 1);
+    }
+
+    SECTION("pmr")
+    {
+        int counter = 0;
+        auto r = counting_pmr_resource(&counter);
+        jg::pmr::dense_bimap<std::pmr::string, std::pmr::string> strings(&r);
+
+        strings.emplace("a", "b");
+        REQUIRE(counter > 0);
+        REQUIRE(strings.find_right("b")->first.get_allocator().resource() == &r);
+    }
+
+    SECTION("a failed rehash keeps both sides usable")
+    {
+        struct failing_resource : std::pmr::memory_resource
+        {
+            auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override
+            {
+                if (allocations_left-- == 0)
+                {
+                    throw std::bad_alloc();
+                }
+
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+            {
+                std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+            }
+
+            auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+                -> bool override
+            {
+                return this == &other;
+            }
+
+            int allocations_left = std::numeric_limits<int>::max();
+        };
+
+        failing_resource r;
+        jg::pmr::dense_bimap<int, int> numbers(&r);
+
+        for (int i = 0; i < 10; ++i)
+        {
+            numbers.emplace(i, -i);
+        }
+
+        const auto bucket_count = numbers.bucket_count();
+
+        // The buckets of the left side can be allocated, not the ones of the right side.
+        r.allocations_left = 1;
+        REQUIRE_THROWS_AS(numbers.rehash(1024u), std::bad_alloc);
+        r.allocations_left = std::numeric_limits<int>::max();
+
+        REQUIRE(numbers.bucket_count() == bucket_count);
+
+        for (int i = 0; i < 10; ++i)
+        {
+            REQUIRE(numbers.at_left(i) == -i);
+            REQUIRE(numbers.at_right(-i) == i);
+        }
+    }
+}
+
+TEST_CASE("dense index")
+{
+    struct row
+    {
+        int id;
+        std::string name;
+    };
+
+    std::vector<row> rows;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        rows.push_back({i, "name " + std::to_string(i % 100)});
+    }
+
+    SECTION("build and find")
+    {
+        auto by_id = jg::make_dense_index(rows, &row::id);
+        REQUIRE(by_id.size() == 1000u);
+        REQUIRE(by_id.load_factor() <= by_id.max_load_factor());
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            REQUIRE(by_id.find(i) == static_cast<std::size_t>(i));
+            REQUIRE(by_id.count(i) == 1u);
+        }
+
+        REQUIRE(by_id.find(1000) == by_id.npos);
+        REQUIRE_FALSE(by_id.contains(-1));
+    }
+
+    SECTION("duplicate keys")
+    {
+        auto by_name = jg::make_dense_index(rows, [](const row& r) { return r.name; });
+        REQUIRE(by_name.count("name 42") == 10u);
+        REQUIRE(rows[by_name.find("name 42")].name == "name 42");
+
+        std::vector<std::size_t> found;
+        by_name.for_each_row("name 42", [&](std::size_t r) { found.push_back(r); });
+        std::sort(found.begin(), found.end());
+        REQUIRE(found.size() == 10u);
+
+        for (std::size_t i = 0; i < found.size(); ++i)
+        {
+            REQUIRE(found[i] == 42u + i * 100u);
+        }
+
+        REQUIRE(by_name.count("name 100") == 0u);
+    }
+
+    SECTION("append")
+    {
+        auto by_id = jg::make_dense_index(rows, &row::id);
+        const auto bucket_count = by_id.bucket_count();
+
+        for (int i = 1000; i < 10000; ++i)
+        {
+            rows.push_back({i, "name"});
+            by_id.append();
+        }
+
+        rows.push_back({10000, "name"});
+        rows.push_back({10001, "name"});
+        by_id.append(2);
+
+        REQUIRE(by_id.size() == 10002u);
+        REQUIRE(by_id.bucket_count() > bucket_count);
+        REQUIRE(by_id.load_factor() <= by_id.max_load_factor());
+
+        for (int i = 0; i < 10002; ++i)
+        {
+            REQUIRE(by_id.find(i) == static_cast<std::size_t>(i));
+        }
+    }
+
+    SECTION("parallel build")
+    {
+        // Runs the tasks backward, as any order must be supported.
+        auto executor = [](std::size_t count, auto task) {
+            for (auto i = count; i > 0; --i)
+            {
+                task(i - 1);
+            }
+        };
+
+        for (int i = 1000; i < 100000; ++i)
+        {
+            rows.push_back({i % 50000, ""});
+        }
+
+        auto key_of = [&rows](std::size_t r) { return rows[r].id; };
+        jg::dense_index<int, decltype(key_of)> serial(key_of);
+        jg::dense_index<int, decltype(key_of)> parallel(key_of);
+        serial.build(rows.size());
+        parallel.build(rows.size(), executor);
+
+        REQUIRE(parallel.size() == rows.size());
+        REQUIRE(parallel.bucket_count() == serial.bucket_count());
+
+        for (int i = 0; i < 50000; ++i)
+        {
+            REQUIRE(parallel.count(i) == 2u);
+            REQUIRE(parallel.find(i) == serial.find(i));
+        }
+    }
+
+    SECTION("transparent lookup")
+    {
+        std::vector<std::string> names{"zero", "one", "two"};
+        auto key_of = [&names](std::size_t r) -> const std::string& { return names[r]; };
+        jg::dense_index<std::string, decltype(key_of), string_hash> index(key_of);
+        index.build(names.size());
+
+        REQUIRE(index.find(nested_string{"two"}) == 2u);
+        REQUIRE(index.contains(nested_string{"one"}));
+        REQUIRE(index.count(nested_string{"three"}) == 0u);
+    }
+
+    SECTION("rebuild, rehash and clear")
+    {
+        auto by_id = jg::make_dense_index(rows, &row::id);
+
+        by_id.rehash(8192);
+        REQUIRE(by_id.bucket_count() == 8192u);
+        REQUIRE(by_id.find(999) == 999u);
+
+        by_id.max_load_factor(0.5f);
+        REQUIRE(by_id.load_factor() <= 0.5f);
+        REQUIRE(by_id.find(500) == 500u);
+
+        rows[500].id = -500;
+        by_id.build(rows.size());
+        REQUIRE(by_id.find(-500) == 500u);
+        REQUIRE_FALSE(by_id.contains(500));
+
+        by_id.build(10);
+        REQUIRE(by_id.size() == 10u);
+        REQUIRE_FALSE(by_id.contains(10));
+
+        const auto bucket_count = by_id.bucket_count();
+        by_id.clear();
+        REQUIRE(by_id.empty());
+        REQUIRE(by_id.bucket_count() == bucket_count);
+        REQUIRE_FALSE(by_id.contains(0));
+
+        auto moved = std::move(by_id);
+        REQUIRE_FALSE(by_id.contains(0));
+        by_id.append(5);
+        REQUIRE(by_id.find(4) == 4u);
+    }
+
+    SECTION("pmr")
+    {
+        int counter = 0;
+        auto r = counting_pmr_resource(&counter);
+        auto key_of = [&rows](std::size_t i) { return rows[i].id; };
+        jg::pmr::dense_index<int, decltype(key_of)> index(key_of, &r);
+
+        index.build(rows.size());
+        REQUIRE(counter > 0);
+        REQUIRE(index.get_allocator().resource() == &r);
+        REQUIRE(index.find(7) == 7u);
+    }
+}
@@ -0,0 +1,70 @@
+#include "catch2/catch.hpp"
+#include "jg/dense_hash_map.hpp"
+#include "jg/huge_page_allocator.hpp"
+
+#include <cstdint>
+#include <memory_resource>
+
+TEST_CASE("huge page allocator")
+{
+    using allocator = jg::huge_page_allocator<std::pair<const std::uint64_t, std::uint64_t>>;
+    jg::dense_hash_map<
+        std::uint64_t, std::uint64_t, std::hash<std::uint64_t>, std::equal_to<std::uint64_t>,
+        allocator>
+        m;
+
+    SECTION("small blocks")
+    {
+        m.try_emplace(1u, 2u);
+        REQUIRE(m.at(1u) == 2u);
+    }
+
+    SECTION("large blocks are aligned on huge pages")
+    {
+        constexpr std::size_t count = 200'000;
+        m.reserve(count);
+
+        for (std::uint64_t i = 0; i < count; ++i)
+        {
+            m.try_emplace(i, i * 2);
+        }
+
+        REQUIRE(m.size() == count);
+
+        for (std::uint64_t i = 0; i < count; ++i)
+        {
+            REQUIRE(m.at(i) == i * 2);
+        }
+
+        if constexpr (jg::details::has_huge_page_support)
+        {
+            const auto address = reinterpret_cast<std::uintptr_t>(&*m.begin().sub_iterator());
+            REQUIRE(address % jg::details::huge_page_size == 0u);
+        }
+    }
+
+    SECTION("rebind")
+    {
+        jg::huge_page_allocator<int> a;
+        jg::huge_page_allocator<double> b(a);
+        REQUIRE(a == b);
+        REQUIRE_FALSE(a != b);
+    }
+}
+
+TEST_CASE("huge page resource")
+{
+    jg::pmr::huge_page_resource resource;
+    jg::pmr::dense_hash_map<int, int> m(8u, &resource);
+
+    m.reserve(100'000);
+
+    for (int i = 0; i < 100'000; ++i)
+    {
+        m[i] = -i;
+    }
+
+    REQUIRE(m.size() == 100'000u);
+    REQUIRE(m.at(4242) == -4242);
+    REQUIRE(resource.upstream_resource() == std::pmr::get_default_resource());
+}